@@ -0,0 +1,945 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file benchmark.cpp
+ * @brief Microbenchmarks das rotinas do caminho quente do servidor.
+ *
+ * Usa as classes do servidor (src/garnize.h, ligado com a libgarnize.a) e compara as implementações atuais com as anteriores
+ * (legacy.h). Só mede tempo: as verificações de corretude ficam em tests/tests.cpp (./compile.sh --test).
+ *
+ * Compilar e rodar: ./compile.sh --benchmark [--filter <grupo>] [--json <arquivo>] [--baseline <arquivo> [--tolerance 0.15]]
+ */
+
+#include "../src/garnize.h"
+#include "legacy.h"
+
+#include <fstream>
+#include <uuid/uuid.h>
+
+/**
+ * @brief Impede que o compilador elimine um cálculo cujo resultado não é usado.
+ */
+template <typename T>
+inline void doNotOptimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/**
+ * @brief Executa e mede um microbenchmark.
+ *
+ * Cada medição é repetida REPETITIONS vezes e o valor reportado é a mediana (o mínimo também é guardado),
+ * o que deixa o resultado estável o bastante para ser comparado entre execuções. Os resultados podem ser
+ * gravados em JSON Lines (--json) e comparados com uma execução anterior (--baseline).
+ */
+class Benchmark
+{
+public:
+    /**
+     * @brief Resultado de uma medição.
+     */
+    struct Result
+    {
+        string group;
+        string name;
+        double nanoseconds;
+        double minNanoseconds;
+        size_t iterations;
+    };
+
+    /**
+     * @brief Quantidade de repetições de cada medição.
+     */
+    static constexpr size_t REPETITIONS = 5;
+
+    /**
+     * @brief Inicia um grupo de benchmarks (imprime o título e marca os resultados seguintes).
+     */
+    static void section(const string &title)
+    {
+        group = title;
+
+        cout << endl
+             << "# " << title << endl;
+    }
+
+    /**
+     * @brief Executa `function` `iterations` vezes (depois de um aquecimento) e imprime o tempo mediano por chamada.
+     *
+     * As chamadas são divididas em REPETITIONS rodadas de `iterations / REPETITIONS`.
+     *
+     * @param name O nome do benchmark.
+     * @param iterations A quantidade de chamadas medidas.
+     * @param function A rotina medida.
+     * @return double A mediana do tempo por chamada em nanossegundos.
+     */
+    template <typename Function>
+    static double run(const string &name, size_t iterations, Function &&function)
+    {
+        for (size_t i = 0; i < iterations / 10; i++)
+        {
+            function();
+        }
+
+        size_t roundIterations = max<size_t>(1, iterations / REPETITIONS);
+        array<double, REPETITIONS> rounds;
+
+        for (double &round : rounds)
+        {
+            auto start = chrono::steady_clock::now();
+
+            for (size_t i = 0; i < roundIterations; i++)
+            {
+                function();
+            }
+
+            round = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / roundIterations;
+        }
+
+        return report(name, rounds, roundIterations * REPETITIONS);
+    }
+
+    /**
+     * @brief Mede `function` uma vez por rodada, dividindo o tempo por `operations` (para rotinas caras, como um lote de inserts).
+     */
+    template <typename Function>
+    static double runBatch(const string &name, size_t operations, Function &&function)
+    {
+        array<double, REPETITIONS> rounds;
+
+        for (double &round : rounds)
+        {
+            auto start = chrono::steady_clock::now();
+
+            function();
+
+            round = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / operations;
+        }
+
+        return report(name, rounds, operations * REPETITIONS);
+    }
+
+    /**
+     * @brief Imprime a razão entre dois tempos medidos.
+     */
+    static void speedup(const string &name, double before, double after)
+    {
+        cout << left << setw(48) << name << right << setw(12) << fixed << setprecision(1) << before / after << " x" << endl;
+    }
+
+    /**
+     * @brief Imprime a mediana e o p99 de latências medidas uma a uma (em nanossegundos).
+     */
+    static void percentiles(const string &name, vector<uint64_t> &latencies)
+    {
+        sort(latencies.begin(), latencies.end());
+
+        uint64_t p50 = latencies[latencies.size() / 2];
+        uint64_t p99 = latencies[static_cast<size_t>(ceil(0.99 * latencies.size())) - 1];
+
+        cout << left << setw(48) << name << right << setw(12) << p50 << " ns p50" << setw(12) << p99 << " ns p99" << endl;
+    }
+
+    /**
+     * @brief Grava os resultados em JSON Lines (um objeto por linha).
+     */
+    static bool writeResults(const string &path)
+    {
+        ofstream output(path);
+
+        for (const Result &result : results)
+        {
+            output << fixed << setprecision(1) << "{\"group\":\"" << escape(result.group) << "\",\"name\":\"" << escape(result.name)
+                   << "\",\"ns_per_op\":" << result.nanoseconds << ",\"min_ns_per_op\":" << result.minNanoseconds
+                   << ",\"iterations\":" << result.iterations << "}\n";
+        }
+
+        return static_cast<bool>(output);
+    }
+
+    /**
+     * @brief Compara os resultados com um arquivo gravado por writeResults.
+     *
+     * Compara o mínimo das repetições, que é o valor menos sensível a interferência de outros processos
+     * (o ruído só aumenta o tempo medido).
+     *
+     * @param path O arquivo de referência.
+     * @param tolerance A piora relativa aceita (0.15 = 15% mais lento).
+     * @return int A quantidade de benchmarks que ficaram mais lentos que a tolerância, ou -1 se o arquivo não puder ser lido.
+     */
+    static int compareWithBaseline(const string &path, double tolerance)
+    {
+        ifstream input(path);
+
+        if (!input)
+        {
+            cerr << "Não foi possível ler o baseline " << path << endl;
+            return -1;
+        }
+
+        cout << endl
+             << "# Comparação com " << path << " (tolerância " << fixed << setprecision(0) << tolerance * 100 << "%)" << endl;
+
+        int regressions = 0;
+        string line;
+
+        while (getline(input, line))
+        {
+            JsonObject object;
+            string_view name;
+            double baseline;
+
+            if (!JsonParser::parse(line, object) || !object.getString("name", name) || !object.getDouble("min_ns_per_op", baseline))
+            {
+                continue;
+            }
+
+            auto current = find_if(results.begin(), results.end(), [&](const Result &result)
+                                   { return escape(result.name) == name; });
+
+            if (current == results.end() || baseline <= 0)
+            {
+                continue;
+            }
+
+            double ratio = current->minNanoseconds / baseline;
+
+            if (ratio > 1 + tolerance)
+            {
+                regressions++;
+
+                cout << left << setw(48) << current->name << right << setw(12) << setprecision(1) << baseline << " -> "
+                     << current->minNanoseconds << " ns/op (+" << setprecision(0) << (ratio - 1) * 100 << "%)" << endl;
+            }
+        }
+
+        cout << regressions << " regressões" << endl;
+
+        return regressions;
+    }
+
+private:
+    inline static string group;
+    inline static vector<Result> results;
+
+    template <size_t N>
+    static double report(const string &name, array<double, N> &rounds, size_t iterations)
+    {
+        sort(rounds.begin(), rounds.end());
+
+        double median = rounds[N / 2];
+
+        results.push_back({group, name, median, rounds[0], iterations});
+
+        cout << left << setw(48) << name << right << setw(12) << fixed << setprecision(1) << median << " ns/op"
+             << "  (min " << rounds[0] << ")" << endl;
+
+        return median;
+    }
+
+    static string escape(const string &text)
+    {
+        string escaped;
+
+        for (char character : text)
+        {
+            if (character == '"' || character == '\\')
+            {
+                escaped.push_back('\\');
+            }
+
+            escaped.push_back(character);
+        }
+
+        return escaped;
+    }
+};
+
+/**
+ * @brief Compara JsonParser com o LegacyJsonParser nos JSONs que o servidor recebe.
+ */
+static void benchmarkJsonParser()
+{
+    const string PAYMENT = R"({"correlationId": "4a7901b8-7d26-4d9d-aa19-4dc1c7cf60b3", "amount": 19.90})";
+    const string SUMMARY = R"({"totalRequests": 43236, "totalAmount": 415542345.98, "totalFee": 415542.34, "feePerTransaction": 0.01})";
+
+    Benchmark::section("JsonParser");
+
+    double legacyPayment = Benchmark::run("legacy parseJson (payment)", 20000, [&]()
+                                          { doNotOptimize(LegacyJsonParser::parseJson(PAYMENT)); });
+    double newPayment = Benchmark::run("JsonParser::parse (payment)", 2000000, [&]()
+                                       { JsonObject object; doNotOptimize(JsonParser::parse(PAYMENT, object)); doNotOptimize(object); });
+
+    double legacySummary = Benchmark::run("legacy parseJson (processor summary)", 20000, [&]()
+                                          { doNotOptimize(LegacyJsonParser::parseJson(SUMMARY)); });
+    double newSummary = Benchmark::run("JsonParser::parse (processor summary)", 2000000, [&]()
+                                       { JsonObject object; doNotOptimize(JsonParser::parse(SUMMARY, object)); doNotOptimize(object); });
+
+    Benchmark::speedup("speedup (payment)", legacyPayment, newPayment);
+    Benchmark::speedup("speedup (processor summary)", legacySummary, newSummary);
+}
+
+/**
+ * @brief Compara as varreduras do SimdScanner (escalar, SSE4.2, AVX2) e std::string::find em capturas realistas.
+ */
+static void benchmarkSimdScanner()
+{
+    // Requisição repassada por um proxy (nginx / haproxy) com os headers que ele adiciona
+    const string PROXIED_REQUEST =
+        "POST /payments HTTP/1.1\r\n"
+        "Host: localhost:9999\r\n"
+        "X-Real-IP: 172.18.0.1\r\n"
+        "X-Forwarded-For: 203.0.113.195, 70.41.3.18, 150.172.238.178\r\n"
+        "X-Forwarded-Proto: http\r\n"
+        "X-Forwarded-Host: localhost:9999\r\n"
+        "X-Request-Id: 8f14e45fceea167a5a36dedd4bea2543\r\n"
+        "Connection: close\r\n"
+        "Content-Length: 70\r\n"
+        "User-Agent: Grafana k6/0.49.0 (https://k6.io/)\r\n"
+        "Accept: */*\r\n"
+        "Accept-Encoding: gzip, deflate, br\r\n"
+        "Content-Type: application/json\r\n"
+        "Traceparent: 00-4bf92f3577b34da6a3ce929d0e0e4736-00f067aa0ba902b7-01\r\n"
+        "Tracestate: congo=t61rcWkgMzE,rojo=00f067aa0ba902b7\r\n"
+        "Via: 1.1 nginx, 1.1 haproxy\r\n"
+        "\r\n"
+        R"({"correlationId": "4a7901b8-7d26-4d9d-aa19-4dc1c7cf60b3", "amount": 19.90})";
+
+    // Resposta de processador com strings longas (mensagem de erro e detalhes)
+    string processorResponse = R"({"message": ")" + string(600, 'x') + R"(", "detail": ")" + string(1200, 'y') + R"(", "totalRequests": 43236, "totalAmount": 415542345.98})";
+
+    Benchmark::section(string("SimdScanner (") + SimdScanner::getInstructionSet() + ")");
+
+    using ScanFunction = const char *(*)(const char *, const char *);
+
+    vector<pair<string, ScanFunction>> headerEnd = {{"escalar", SimdScanner::findHeaderEndScalar}};
+    vector<pair<string, ScanFunction>> stringSpecial = {{"escalar", SimdScanner::findStringSpecialScalar}};
+
+#if defined(__x86_64__) || defined(__i386__)
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        headerEnd.push_back({"sse4.2", SimdScanner::findHeaderEndSse42});
+        stringSpecial.push_back({"sse4.2", SimdScanner::findStringSpecialSse42});
+    }
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        headerEnd.push_back({"avx2", SimdScanner::findHeaderEndAvx2});
+        stringSpecial.push_back({"avx2", SimdScanner::findStringSpecialAvx2});
+    }
+#endif
+
+    double baseline = Benchmark::run("std::string::find \"\\r\\n\\r\\n\" (proxied request)", 2000000, [&]()
+                                     { doNotOptimize(PROXIED_REQUEST.find("\r\n\r\n")); });
+
+    for (const auto &[name, function] : headerEnd)
+    {
+        const char *begin = PROXIED_REQUEST.data();
+
+        double nanoseconds = Benchmark::run("findHeaderEnd " + name + " (proxied request)", 2000000, [&]()
+                                            { doNotOptimize(function(begin, begin + PROXIED_REQUEST.size())); });
+
+        Benchmark::speedup("speedup " + name + " vs std::string::find", baseline, nanoseconds);
+    }
+
+    const char *content = processorResponse.data() + 13;
+    const char *contentEnd = processorResponse.data() + processorResponse.size();
+
+    double scalar = 0;
+
+    for (const auto &[name, function] : stringSpecial)
+    {
+        double nanoseconds = Benchmark::run("findStringSpecial " + name + " (600 B string)", 2000000, [&]()
+                                            { doNotOptimize(function(content, contentEnd)); });
+
+        if (scalar == 0)
+        {
+            scalar = nanoseconds;
+        }
+        else
+        {
+            Benchmark::speedup("speedup " + name + " vs escalar", scalar, nanoseconds);
+        }
+    }
+
+    Benchmark::run("JsonParser::parse (processor response, 1.9 KB)", 500000, [&]()
+                   { JsonObject parsed; doNotOptimize(JsonParser::parse(processorResponse, parsed)); doNotOptimize(parsed); });
+}
+
+/**
+ * @brief Compara os JsonSerializer com os conversores anteriores.
+ */
+static void benchmarkJsonSerializers()
+{
+    Benchmark::section("JsonSerializer");
+
+    Payment payment;
+
+    UUIDGenerator::createUUID(payment.correlationId);
+    payment.amountInCents = 1990;
+    payment.requestedAt = TimeUtils::getEpochMillisUTC();
+    payment.flags = 0;
+
+    PaymentsSummary summary{{43236, 415542345.98}, {423545, 329347.34}};
+
+    double legacyPayment = Benchmark::run("legacy toJson (payment)", 500000, [&]()
+                                          { doNotOptimize(LegacyPaymentsJSONConverter::toJson(payment)); });
+    double newPayment = Benchmark::run("JsonSerializer<Payment> (stack buffer)", 2000000, [&]()
+                                       { char buffer[JsonSerializer<Payment>::MAX_SIZE]; doNotOptimize(PaymentsJSONConverter::write(payment, buffer)); doNotOptimize(buffer); });
+
+    double legacySummary = Benchmark::run("legacy summaryToJson (stringstream)", 500000, [&]()
+                                          { doNotOptimize(LegacyPaymentsJSONConverter::summaryToJson(summary)); });
+    double newSummary = Benchmark::run("JsonSerializer<PaymentsSummary> (stack buffer)", 2000000, [&]()
+                                       { char buffer[JsonSerializer<PaymentsSummary>::MAX_SIZE]; doNotOptimize(PaymentsJSONConverter::write(summary, buffer)); doNotOptimize(buffer); });
+
+    Benchmark::speedup("speedup (payment)", legacyPayment, newPayment);
+    Benchmark::speedup("speedup (summary)", legacySummary, newSummary);
+}
+
+/**
+ * @brief Compara o formatador com cache e o parser de ISO 8601 do TimeUtils com as versões anteriores.
+ */
+static void benchmarkTimeUtils()
+{
+    Benchmark::section("TimeUtils");
+
+    const int64_t NOW = TimeUtils::getEpochMillisUTC();
+    int64_t millis = NOW;
+
+    Benchmark::run("legacy formatTimestampUTC (ostringstream)", 500000, [&]()
+                   { doNotOptimize(LegacyPaymentsJSONConverter::formatTimestampUTC(millis++)); });
+
+    millis = NOW;
+    Benchmark::run("formatTimestampUTC (mesmo segundo, cache)", 5000000, [&]()
+                   { char buffer[TimeUtils::TIMESTAMP_MAX_SIZE]; doNotOptimize(TimeUtils::formatTimestampUTC(millis++ / 1000 * 1000 + 123, buffer)); doNotOptimize(buffer); });
+
+    millis = NOW;
+    Benchmark::run("formatTimestampUTC (segundo muda, sem cache)", 5000000, [&]()
+                   { char buffer[TimeUtils::TIMESTAMP_MAX_SIZE]; doNotOptimize(TimeUtils::formatTimestampUTC(millis += 1000, buffer)); doNotOptimize(buffer); });
+
+    const string TIMESTAMP = "2025-07-15T12:34:56.789Z";
+    const string ENCODED_TIMESTAMP = "2025-07-15T12%3A34%3A56.789Z";
+    int64_t parsed;
+
+    Benchmark::run("legacy parseTimestampUTC (sscanf + timegm)", 1000000, [&]()
+                   { doNotOptimize(LegacyTimeUtils::parseTimestampUTC(TIMESTAMP, parsed)); doNotOptimize(parsed); });
+    Benchmark::run("parseTimestampUTC", 5000000, [&]()
+                   { doNotOptimize(TimeUtils::parseTimestampUTC(TIMESTAMP, parsed)); doNotOptimize(parsed); });
+    Benchmark::run("parseTimestampUTC (URL-encoded)", 5000000, [&]()
+                   { doNotOptimize(TimeUtils::parseTimestampUTC(ENCODED_TIMESTAMP, parsed)); doNotOptimize(parsed); });
+}
+
+/**
+ * @brief Compara o HttpRequest / HttpResponse (views + RequestArena) com o pipeline anterior.
+ */
+static void benchmarkRequestPipeline()
+{
+    Benchmark::section("HttpRequest / HttpResponse");
+
+    const string PAYMENT_REQUEST =
+        "POST /payments HTTP/1.1\r\n"
+        "Host: localhost:9999\r\n"
+        "User-Agent: Grafana k6/1.1.0\r\n"
+        "Content-Type: application/json\r\n"
+        "Content-Length: 71\r\n"
+        "\r\n"
+        "{\"correlationId\":\"4a7901b8-7d26-4d9d-aa19-4dc1c7cf60b3\",\"amount\":\"19.9x\"}";
+
+    const string SUMMARY_REQUEST =
+        "GET /payments-summary?from=2025-07-15T12%3A34%3A56.000Z&to=2025-07-15T12%3A35%3A56.000Z HTTP/1.1\r\n"
+        "Host: localhost:9999\r\n"
+        "\r\n";
+
+    auto handlePayment = [&]()
+    {
+        RequestArena arena;
+        HttpRequest request;
+        char headersBuffer[HttpResponse::HEADERS_MAX_SIZE];
+
+        doNotOptimize(HttpRequestParser::parse(PAYMENT_REQUEST, request));
+
+        JsonObject json;
+        Payment payment;
+
+        HttpResponse response = JsonParser::parse(request.body, json) && json.getAmountInCents(Constants::KEY_AMOUNT, payment.amountInCents)
+                                    ? HttpResponse(HttpStatus::CREATED)
+                                    : HttpResponse(HttpStatus::BAD_REQUEST, "{ \"message\":\"Invalid params. Invalid JSON or 'amount'\" }");
+
+        doNotOptimize(response.writeHeaders(headersBuffer));
+        doNotOptimize(response.body.data());
+    };
+
+    auto handleSummary = [&]()
+    {
+        RequestArena arena;
+        HttpRequest request;
+        string_view from, to;
+        int64_t fromMillis = 0, toMillis = 0;
+        char headersBuffer[HttpResponse::HEADERS_MAX_SIZE];
+        char summaryBuffer[JsonSerializer<PaymentsSummary>::MAX_SIZE];
+
+        doNotOptimize(HttpRequestParser::parse(SUMMARY_REQUEST, request) &&
+                      HttpRequestParser::getQueryParam(request.query, "from", from) && HttpRequestParser::getQueryParam(request.query, "to", to) &&
+                      TimeUtils::parseTimestampUTC(from, fromMillis) && TimeUtils::parseTimestampUTC(to, toMillis));
+
+        PaymentsSummary summary{};
+        summary.defaultStats.totalRequests = static_cast<int>((toMillis - fromMillis) / 1000);
+
+        HttpResponse response(HttpStatus::OK, PaymentsJSONConverter::write(summary, summaryBuffer));
+
+        doNotOptimize(response.writeHeaders(headersBuffer));
+        doNotOptimize(response.body.data());
+    };
+
+    double legacy = Benchmark::run("legacy substr + map<string, string>", 1000000, [&]()
+                                   { doNotOptimize(LegacyRequestPipeline::handle(PAYMENT_REQUEST.data(), PAYMENT_REQUEST.size())); });
+    double current = Benchmark::run("HttpRequest + HttpResponse (POST 400)", 1000000, handlePayment);
+
+    Benchmark::run("HttpRequest + HttpResponse (GET summary)", 1000000, handleSummary);
+    Benchmark::speedup("speedup", legacy, current);
+}
+
+/**
+ * @brief Compara o gerador de UUIDv7 e a conversão hexadecimal do UUIDGenerator com a libuuid.
+ */
+static void benchmarkUUIDGenerator()
+{
+    Benchmark::section("UUIDGenerator");
+
+    double legacyGenerate = Benchmark::run("libuuid uuid_generate", 1000000, [&]()
+                                           { uuid_t UUID; uuid_generate(UUID); doNotOptimize(UUID); });
+    double newGenerate = Benchmark::run("UUIDGenerator::createUUID (v7)", 10000000, [&]()
+                                        { uint8_t UUID[16]; UUIDGenerator::createUUID(UUID); doNotOptimize(UUID); });
+
+    uint8_t UUID[16];
+    UUIDGenerator::createUUID(UUID);
+
+    double legacyFormat = Benchmark::run("libuuid uuid_unparse", 5000000, [&]()
+                                         { char text[37]; uuid_unparse(UUID, text); doNotOptimize(text); });
+    double newFormat = Benchmark::run("UUIDGenerator::toChars", 10000000, [&]()
+                                      { char text[36]; doNotOptimize(UUIDGenerator::toChars(UUID, text)); doNotOptimize(text); });
+
+    const string TEXT = UUIDGenerator::toString(UUID);
+
+    double legacyParse = Benchmark::run("libuuid uuid_parse", 5000000, [&]()
+                                        { uuid_t parsed; doNotOptimize(uuid_parse(TEXT.c_str(), parsed)); doNotOptimize(parsed); });
+    double newParse = Benchmark::run("UUIDGenerator::fromString", 10000000, [&]()
+                                     { uint8_t parsed[16]; doNotOptimize(UUIDGenerator::fromString(TEXT, parsed)); doNotOptimize(parsed); });
+
+    Benchmark::speedup("speedup (geração)", legacyGenerate, newGenerate);
+    Benchmark::speedup("speedup (formatação)", legacyFormat, newFormat);
+    Benchmark::speedup("speedup (parse)", legacyParse, newParse);
+}
+
+/**
+ * @brief Fila de referência para o MPSCRingBuffer: std::queue protegida por um mutex.
+ */
+class LockedQueue
+{
+public:
+    bool tryPush(const Payment &payment)
+    {
+        lock_guard<mutex> lock(queueMutex);
+        queue.push(payment);
+
+        return true;
+    }
+
+    bool tryPop(Payment &payment)
+    {
+        lock_guard<mutex> lock(queueMutex);
+
+        if (queue.empty())
+        {
+            return false;
+        }
+
+        payment = queue.front();
+        queue.pop();
+
+        return true;
+    }
+
+private:
+    mutex queueMutex;
+    std::queue<Payment> queue;
+};
+
+/**
+ * @brief Publica `pushes` pagamentos em cada uma de `producers` threads enquanto a thread atual consome,
+ * como as threads das requests e a thread de escrita do PaymentsDatabaseWriter.
+ *
+ * A latência de cada publicação (incluindo as novas tentativas com a fila cheia) é adicionada em `latencies`.
+ */
+template <typename Queue>
+static void runProducers(Queue &queue, size_t producers, size_t pushes, vector<uint64_t> &latencies)
+{
+    vector<vector<uint64_t>> producerLatencies(producers, vector<uint64_t>(pushes));
+    atomic<size_t> ready{0};
+    atomic<bool> started{false};
+    vector<thread> threads;
+
+    for (size_t producer = 0; producer < producers; producer++)
+    {
+        threads.emplace_back([&, producer]()
+                             {
+                                 Payment payment{};
+                                 payment.amountInCents = 1990;
+
+                                 ready.fetch_add(1);
+
+                                 while (!started.load())
+                                 {
+                                     this_thread::yield();
+                                 }
+
+                                 for (uint64_t &latency : producerLatencies[producer])
+                                 {
+                                     auto start = chrono::steady_clock::now();
+
+                                     while (!queue.tryPush(payment))
+                                     {
+                                         this_thread::yield();
+                                     }
+
+                                     latency = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+                                 } });
+    }
+
+    while (ready.load() < producers)
+    {
+        this_thread::yield();
+    }
+
+    started.store(true);
+
+    Payment payment;
+
+    for (size_t received = 0; received < producers * pushes;)
+    {
+        if (queue.tryPop(payment))
+        {
+            received++;
+        }
+        else
+        {
+            this_thread::yield();
+        }
+    }
+
+    for (thread &producer : threads)
+    {
+        producer.join();
+    }
+
+    for (const vector<uint64_t> &values : producerLatencies)
+    {
+        latencies.insert(latencies.end(), values.begin(), values.end());
+    }
+}
+
+/**
+ * @brief Compara o MPSCRingBuffer com uma std::queue + mutex com vários produtores e um consumidor.
+ *
+ * O tempo por operação é o de todas as publicações divididas pelo total; o p50 / p99 é o da latência de cada publicação.
+ */
+static void benchmarkQueue()
+{
+    Benchmark::section("MPSCRingBuffer x std::queue + mutex");
+
+    const size_t PUSHES = 50000;
+
+    for (size_t producers : {1, 2, 4, 8})
+    {
+        const string LABEL = producers == 1 ? " (1 produtor)" : " (" + to_string(producers) + " produtores)";
+
+        vector<uint64_t> ringLatencies;
+        vector<uint64_t> lockedLatencies;
+
+        double ring = Benchmark::runBatch("MPSCRingBuffer::tryPush" + LABEL, producers * PUSHES, [&]()
+                                          { MPSCRingBuffer<Payment> queue(Constants::WRITER_QUEUE_CAPACITY);
+                                            runProducers(queue, producers, PUSHES, ringLatencies); });
+        double locked = Benchmark::runBatch("std::queue + mutex" + LABEL, producers * PUSHES, [&]()
+                                            { LockedQueue queue;
+                                              runProducers(queue, producers, PUSHES, lockedLatencies); });
+
+        Benchmark::percentiles("latência MPSCRingBuffer::tryPush" + LABEL, ringLatencies);
+        Benchmark::percentiles("latência std::queue + mutex" + LABEL, lockedLatencies);
+        Benchmark::speedup("speedup" + LABEL, locked, ring);
+    }
+}
+
+/**
+ * @brief Mede o custo de registro e de leitura do LatencyHistogram.
+ */
+static void benchmarkMetrics()
+{
+    Benchmark::section("Metrics");
+
+    static LatencyHistogram histogram;
+    uint64_t value = 0;
+
+    Benchmark::run("LatencyHistogram::record", 10000000, [&]()
+                   { histogram.record(value += 7919); });
+    Benchmark::run("LatencyHistogram::getPercentile", 100000, [&]()
+                   { doNotOptimize(histogram.getPercentile(0.99)); });
+}
+
+/**
+ * @brief Mede o custo de um TraceSpan.
+ */
+static void benchmarkTracer()
+{
+    Benchmark::section("Tracer");
+
+    Benchmark::run("TraceSpan (2x steady_clock + seqlock)", 10000000, []()
+                   { TraceSpan span("benchmark.span"); });
+}
+
+/**
+ * @brief Mede o insert de pagamentos no SQLite (um por transação x em lote) e o resumo com tabelas de vários tamanhos.
+ *
+ * Usa um banco temporário com uma única partição de uma hora. Os pagamentos dos inserts avulsos são gravados como
+ * não processados, então só os gravados junto com os rollups (como faz a thread de escrita) entram no resumo.
+ */
+static void benchmarkDatabase()
+{
+    Benchmark::section("SQLite (PaymentsUtils)");
+
+    filesystem::path directory = filesystem::temp_directory_path() / ("garnize-benchmark-" + to_string(getpid()));
+    filesystem::create_directories(directory);
+    const string DATABASE_NAME = (directory / "payments.sqlite").string();
+
+    {
+        SQLiteConnectionPoolUtils writePool("benchmark-escrita", DATABASE_NAME, 1, 1, false);
+        sqlite3 *database = writePool.getConnectionFromPool();
+
+        if (database == nullptr)
+        {
+            cerr << "Não foi possível abrir o banco temporário " << DATABASE_NAME << endl;
+            filesystem::remove_all(directory);
+            return;
+        }
+
+        PaymentsUtils::init(database);
+
+        const PaymentsPartition PARTITION = PaymentsUtils::getPartition(TimeUtils::getEpochMillisUTC());
+
+        PaymentsUtils::createPartition(database, PARTITION);
+
+        SQLiteConnectionPoolUtils readPool("benchmark-leitura", DATABASE_NAME, 1, 1, true);
+
+        size_t rows = 0;
+
+        auto nextPayment = [&](Payment &payment)
+        {
+            UUIDGenerator::createUUID(payment.correlationId);
+            payment.requestedAt = PARTITION.fromMillis + static_cast<int64_t>(rows * 3) % Constants::PAYMENTS_PARTITION_MS;
+            payment.amountInCents = 1990;
+            rows++;
+        };
+
+        Payment payment{};
+
+        Benchmark::runBatch("PaymentsUtils::insert (1 por transação)", 100, [&]()
+                            {
+                                for (int i = 0; i < 100; i++)
+                                {
+                                    nextPayment(payment);
+                                    PaymentsUtils::insert(database, payment, true, false);
+                                } });
+
+        Benchmark::runBatch("PaymentsUtils::insert (lote de 1000, BEGIN/COMMIT)", 1000, [&]()
+                            {
+                                sqlite3_exec(database, "BEGIN", nullptr, nullptr, nullptr);
+
+                                for (int i = 0; i < 1000; i++)
+                                {
+                                    nextPayment(payment);
+                                    PaymentsUtils::insert(database, payment, true, false);
+                                }
+
+                                sqlite3_exec(database, "COMMIT", nullptr, nullptr, nullptr); });
+
+        int64_t processed = 0;
+
+        for (int64_t size : {10000, 100000, 1000000})
+        {
+            // Completa a tabela com pagamentos processados e os rollups correspondentes, em lotes
+            while (processed < size)
+            {
+                map<pair<int64_t, bool>, PaymentsRollup> rollups;
+
+                sqlite3_exec(database, "BEGIN", nullptr, nullptr, nullptr);
+
+                for (int i = 0; i < 10000 && processed < size; i++, processed++)
+                {
+                    bool defaultService = processed % 4 != 0;
+
+                    nextPayment(payment);
+                    PaymentsUtils::insert(database, payment, defaultService, true);
+
+                    PaymentsRollup &rollup = rollups[{payment.requestedAt / 1000, defaultService}];
+                    rollup.records++;
+                    rollup.amountInCents += payment.amountInCents;
+                }
+
+                PaymentsUtils::upsertRollups(database, rollups);
+                sqlite3_exec(database, "COMMIT", nullptr, nullptr, nullptr);
+            }
+
+            PaymentsSummary summary{};
+
+            string rowsLabel = to_string(size / 1000) + "k pagamentos";
+
+            // Bordas fora do segundo: rollups + leitura das linhas dos dois segundos parciais
+            Benchmark::run("getSummary (1 h, " + rowsLabel + ")", 200, [&]()
+                           { doNotOptimize(PaymentsUtils::getSummary(readPool, PARTITION.fromMillis + 1, PARTITION.toMillis - 1, summary)); doNotOptimize(summary); });
+
+            // Janela menor que um segundo: só as linhas da partição
+            Benchmark::run("getSummary (300 ms, " + rowsLabel + ")", 200, [&]()
+                           { doNotOptimize(PaymentsUtils::getSummary(readPool, PARTITION.fromMillis + 1500, PARTITION.fromMillis + 1800, summary)); doNotOptimize(summary); });
+        }
+
+        writePool.returnConnectionToPool(database);
+    }
+
+    filesystem::remove_all(directory);
+}
+
+/**
+ * @brief Opções da linha de comando do benchmark.
+ */
+struct BenchmarkOptions
+{
+    string jsonPath;
+    string baselinePath;
+    string filter;
+    double tolerance = 0.15;
+
+    /**
+     * @brief Lê as opções no formato "--nome valor". Retorna false (e imprime o uso) se alguma for inválida.
+     */
+    static bool parse(int argc, char *argv[], BenchmarkOptions &options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            string_view name = argv[i];
+
+            if (name == "--help" || i + 1 >= argc)
+            {
+                printUsage(argv[0]);
+                return false;
+            }
+
+            const char *value = argv[++i];
+
+            if (name == "--json")
+            {
+                options.jsonPath = value;
+            }
+            else if (name == "--baseline")
+            {
+                options.baselinePath = value;
+            }
+            else if (name == "--tolerance")
+            {
+                options.tolerance = strtod(value, nullptr);
+            }
+            else if (name == "--filter")
+            {
+                options.filter = value;
+            }
+            else
+            {
+                cerr << "Opção inválida: " << name << endl;
+                printUsage(argv[0]);
+                return false;
+            }
+        }
+
+        if (options.tolerance < 0)
+        {
+            cerr << "Opções fora da faixa válida" << endl;
+            printUsage(argv[0]);
+            return false;
+        }
+
+        return true;
+    }
+
+    static void printUsage(const char *program)
+    {
+        cerr << "Uso: " << program << " [opções]\n"
+             << "  --filter <grupo>              roda só os grupos que contêm o texto (json, simd, serializer, time, uuid, request, queue, metrics, tracer, sqlite)\n"
+             << "  --json <arquivo>              grava os resultados em JSON Lines\n"
+             << "  --baseline <arquivo>          compara com os resultados gravados por --json e sai com 1 se houver regressões\n"
+             << "  --tolerance <fração>          piora aceita na comparação com o --baseline (padrão 0.15)\n";
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    BenchmarkOptions options;
+
+    if (!BenchmarkOptions::parse(argc, argv, options))
+    {
+        return EXIT_FAILURE;
+    }
+
+    const vector<pair<string, void (*)()>> GROUPS = {
+        {"json", benchmarkJsonParser},
+        {"simd", benchmarkSimdScanner},
+        {"serializer", benchmarkJsonSerializers},
+        {"time", benchmarkTimeUtils},
+        {"uuid", benchmarkUUIDGenerator},
+        {"request", benchmarkRequestPipeline},
+        {"queue", benchmarkQueue},
+        {"metrics", benchmarkMetrics},
+        {"tracer", benchmarkTracer},
+        {"sqlite", benchmarkDatabase},
+    };
+
+    for (const auto &[name, function] : GROUPS)
+    {
+        if (options.filter.empty() || name.find(options.filter) != string::npos)
+        {
+            function();
+        }
+    }
+
+    if (!options.jsonPath.empty() && !Benchmark::writeResults(options.jsonPath))
+    {
+        cerr << "Não foi possível gravar " << options.jsonPath << endl;
+        return EXIT_FAILURE;
+    }
+
+    if (!options.baselinePath.empty() && Benchmark::compareWithBaseline(options.baselinePath, options.tolerance) != 0)
+    {
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,334 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file legacy.h
+ * @brief Implementações anteriores das rotinas do caminho quente, mantidas só como referência.
+ *
+ * Os microbenchmarks medem o ganho das versões atuais sobre elas e os testes (tests/tests.cpp)
+ * verificam que as versões atuais produzem a mesma saída.
+ */
+
+#ifndef GARNIZE_BENCHMARK_LEGACY_H
+#define GARNIZE_BENCHMARK_LEGACY_H
+
+#include "../src/garnize.h"
+
+#include <regex>
+
+/**
+ * @brief Parser de JSON anterior (regex + map<string, string>), mantido só para comparação.
+ */
+class LegacyJsonParser
+{
+public:
+    /**
+     * @brief Faz o parse de um JSON e retorna um map content os valores.
+     *
+     * @param jsonString String JSON a ser parseada.
+     * @return std::map<std::string, std::string> Um map contendo os valores
+     */
+    static map<string, string> parseJson(string_view jsonString)
+    {
+
+        const string JSON = removeUnnecessarySpaces(jsonString);
+
+        map<string, string> data;
+
+        size_t pos = 0;
+
+        while (pos < JSON.size())
+        {
+            // Encontra o início da chave
+            size_t keyStart = JSON.find('"', pos) + 1;
+
+            // Encontra o fim da chave
+            size_t keyEnd = JSON.find('"', keyStart);
+
+            // Extrai a chave
+            string key = JSON.substr(keyStart, keyEnd - keyStart);
+
+            // Encontra o início do valor
+            pos = JSON.find(':', keyEnd) + 1;
+
+            // Encontra o fim do valor, que pode ser uma vírgula ou o fechamento do objeto.
+            size_t valueEnd = JSON.find_first_of(",}", pos);
+
+            if (valueEnd == string::npos)
+                valueEnd = JSON.size();
+
+            string value = JSON.substr(pos, valueEnd - pos);
+
+            // Verifica se o valor está entre aspas
+            if (value[0] == '"' && value[value.size() - 1] == '"')
+            {
+                // remove as aspas
+                value = value.substr(1, value.size() - 2);
+            }
+
+            data[key] = value;
+
+            pos = valueEnd + 1;
+
+            // Verifica se chegou ao fim do objeto para não ficar em loop infinito
+            if (JSON[pos - 1] == '}')
+                break;
+        }
+
+        return data;
+    }
+
+private:
+    /**
+     * @brief Remove caracteres não imprimíveis da string JSON.
+     *
+     * Essa função itera sobre a string JSON e remove todos os caracteres que não são imprimíveis ASCII.
+     *
+     * @param jsonString String JSON a ser limpa.
+     * @return String JSON limpa, sem caracteres não imprimíveis.
+     */
+    static string removeInvalidCharacters(string_view jsonString)
+    {
+        string validString;
+
+        for (char character : jsonString)
+        {
+            // caracteres imprimíveis ASCII (código entre 32 e 126)
+            if (character >= 32 && character <= 126)
+            {
+                validString += character;
+            }
+        }
+
+        return validString;
+    }
+
+    /**
+     * @brief Remove os espaços em branco desnecessários de uma string JSON.
+     *
+     * Esse método utiliza uma expressão regular para remover os espaços em branco que não estão dentro de strings delimitadas por aspas.
+     *
+     * @param jsonString A string JSON a ser processada.
+     * @return A string JSON com os espaços em branco desnecessários removidos.
+     */
+    static string removeUnnecessarySpaces(string_view jsonString)
+    {
+        return regex_replace(removeInvalidCharacters(jsonString), regex("\\s+(?=(?:[^\"']*[\"'][^\"']*[\"'])*[^\"']*$)"), "");
+    }
+};
+
+/**
+ * @brief Conversores JSON da versão inicial do servidor (stringstream), mantidos só para comparação.
+ */
+class LegacyPaymentsJSONConverter
+{
+public:
+    /**
+     * @brief Converte um PaymentSummary para uma string JSON.
+     *
+     * @param summary O PaymentSummary a ser convertido.
+     * @return std::string A string JSON representando o PaymentsSummary.
+     */
+    static string summaryToJson(const PaymentsSummary &summary)
+    {
+        stringstream stringBuilder;
+
+        stringBuilder << std::fixed;
+        stringBuilder << std::setprecision(2);
+        stringBuilder << "{\"default\":{\"totalRequests\":";
+        stringBuilder << summary.defaultStats.totalRequests;
+        stringBuilder << ",\"totalAmount\":";
+        stringBuilder << summary.defaultStats.totalAmount;
+        stringBuilder << "},\"fallback\":{\"totalRequests\":";
+        stringBuilder << summary.fallbackStats.totalRequests;
+        stringBuilder << ",\"totalAmount\":";
+        stringBuilder << summary.fallbackStats.totalAmount;
+        stringBuilder << "}}";
+
+        return stringBuilder.str();
+    }
+
+    /**
+     * @brief Converte um Payment para uma string JSON como o conversor da versão inicial do servidor.
+     *
+     * A versão inicial guardava o amount como double e o formatava com to_string (6 casas, ex.: 19.900000).
+     *
+     * @param payment O Payment a ser convertido.
+     * @return std::string A string JSON representando o Payment.
+     */
+    static string toJson(const Payment &payment)
+    {
+        stringstream stringBuilder;
+
+        stringBuilder << "{\"correlationId\": \"";
+        stringBuilder << UUIDGenerator::toString(payment.correlationId);
+        stringBuilder << "\", \"amount\": ";
+        stringBuilder << to_string(payment.amountInCents / 100.0);
+        stringBuilder << ", \"requestedAt\" : \"";
+        stringBuilder << formatTimestampUTC(payment.requestedAt);
+        stringBuilder << "\"}";
+
+        return stringBuilder.str();
+    }
+
+    /**
+     * @brief Formata milissegundos desde a epoch no formato ISO 8601 em UTC ("YYYY-MM-DDTHH:MM:SS.sssZ").
+     *
+     * @param epochMillis Milissegundos desde a epoch.
+     * @return std::string Timestamp no formato ISO 8601 em UTC.
+     */
+    static string formatTimestampUTC(int64_t epochMillis)
+    {
+        auto now = chrono::system_clock::time_point(chrono::milliseconds(epochMillis));
+        auto now_time_t = chrono::system_clock::to_time_t(now);
+        auto now_tm = *gmtime(&now_time_t);
+
+        // Formata a data e hora no formato ISO
+        ostringstream stringBuilder;
+
+        stringBuilder << put_time(&now_tm, "%Y-%m-%dT%H:%M:%S");
+
+        /**
+         * @brief Calcula a fração de segundo atual em milissegundos (0-999).
+         *
+         * @details
+         * Essa linha de código utiliza a classe `chrono` para calcular o tempo
+         * desde a época (epoch) até o momento atual, e então extrai a fração de
+         * segundo em milissegundos.
+         */
+        auto fraction_of_second = chrono::duration_cast<chrono::milliseconds>(now.time_since_epoch()) % 1000;
+
+        stringBuilder << ".";
+        stringBuilder << setfill('0');
+        stringBuilder << setw(3);
+        stringBuilder << fraction_of_second.count();
+        stringBuilder << "Z";
+
+        return stringBuilder.str();
+    }
+};
+
+/**
+ * @brief Parser de timestamp anterior (sscanf + timegm), mantido só para comparação.
+ */
+class LegacyTimeUtils
+{
+public:
+    /**
+     * @brief Converte um timestamp ISO 8601 em UTC ("YYYY-MM-DDTHH:MM:SS[.sss][Z]") para milissegundos desde a epoch.
+     *
+     * @param timestamp O timestamp em texto.
+     * @param epochMillis Recebe os milissegundos desde a epoch.
+     * @return true se o timestamp é válido, false caso contrário.
+     */
+    static bool parseTimestampUTC(const string &timestamp, int64_t &epochMillis)
+    {
+        struct tm dateTime = {};
+        int consumed = 0;
+
+        if (sscanf(timestamp.c_str(), "%4d-%2d-%2dT%2d:%2d:%2d%n", &dateTime.tm_year, &dateTime.tm_mon, &dateTime.tm_mday,
+                   &dateTime.tm_hour, &dateTime.tm_min, &dateTime.tm_sec, &consumed) != 6)
+        {
+            return false;
+        }
+
+        dateTime.tm_year -= 1900;
+        dateTime.tm_mon -= 1;
+
+        int64_t millis = 0;
+        size_t pos = consumed;
+
+        // Fração de segundo opcional, considerando somente os 3 primeiros dígitos
+        if (pos < timestamp.size() && timestamp[pos] == '.')
+        {
+            int digits = 0;
+
+            for (pos++; pos < timestamp.size() && isdigit(static_cast<unsigned char>(timestamp[pos])); pos++)
+            {
+                if (digits++ < 3)
+                {
+                    millis = millis * 10 + (timestamp[pos] - '0');
+                }
+            }
+
+            for (; digits < 3; digits++)
+            {
+                millis *= 10;
+            }
+        }
+
+        if (pos < timestamp.size() && timestamp[pos] == 'Z')
+        {
+            pos++;
+        }
+
+        if (pos != timestamp.size())
+        {
+            return false;
+        }
+
+        epochMillis = static_cast<int64_t>(timegm(&dateTime)) * 1000 + millis;
+
+        return true;
+    }
+};
+
+/**
+ * @brief Pipeline de request anterior (cópias com substr + map<string, string>), mantido só para comparação.
+ */
+class LegacyRequestPipeline
+{
+public:
+    /**
+     * @brief Parseia a request e monta a resposta 400 de JSON inválido como o RequestHandler fazia.
+     *
+     * @return string Os cabeçalhos da resposta.
+     */
+    static string handle(const char *buffer, size_t bytesRead)
+    {
+        string request(buffer, bytesRead);
+
+        size_t pos = request.find(" ");
+        string method = request.substr(0, pos);
+        size_t pathEnd = request.find(" ", pos + 1);
+        string path = request.substr(pos + 1, pathEnd - pos - 1);
+
+        const char *headerEnd = SimdScanner::findHeaderEnd(request.data(), request.data() + request.size());
+        string body = request.substr(headerEnd - request.data() + 4);
+
+        map<string, string> response = {
+            {"status", ""},
+            {"response", ""}};
+
+        if (method == "POST" && path == Constants::PAYMENTS_ENDPOINT && body.find(Constants::KEY_AMOUNT) != string::npos)
+        {
+            response["status"] = Constants::BAD_REQUEST_RESPONSE;
+            response["response"] = "{ \"message\":\"Invalid params. Invalid JSON or 'amount'\" }";
+        }
+
+        return response.at("status") + Constants::CONTENT_TYPE_APPLICATION_JSON + to_string(response.at("response").size()) + "\r\n\r\n";
+    }
+};
+
+#endif // GARNIZE_BENCHMARK_LEGACY_H
@@ -0,0 +1,889 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file load_generator.cpp
+ * @brief Gerador de carga open-loop para o POST /payments e o GET /payments-summary.
+ *
+ * As requests são agendadas a uma taxa constante (a request i tem horário previsto start + i / rate),
+ * independente de quando as anteriores terminaram, e distribuídas em várias conexões keep-alive
+ * (reabertas quando o servidor fecha). A latência "corrigida" é medida a partir do horário previsto,
+ * então o tempo que a request passou esperando uma conexão livre também entra na conta (correção
+ * de coordinated omission); a latência "de serviço" é medida a partir do envio.
+ *
+ * Usa as classes do servidor (src/garnize.h, ligado com a libgarnize.a) para reaproveitar o UUIDGenerator, o TimeUtils e o LatencyHistogram.
+ *
+ * Compilar e rodar: ./compile.sh --load-generator [--rate 2000 --duration 30 ...]
+ */
+
+#include "../src/garnize.h"
+
+#include <arpa/inet.h>
+#include <netdb.h>
+#include <netinet/tcp.h>
+#include <random>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
+
+/**
+ * @brief Tipos de request gerados.
+ */
+enum class LoadRequestKind
+{
+    PAYMENTS,
+    PAYMENTS_SUMMARY,
+    COUNT
+};
+
+/**
+ * @brief Opções do gerador de carga (linha de comando).
+ */
+struct LoadGeneratorOptions
+{
+    string host = "127.0.0.1";
+    int port = 9999;
+    double rate = 1000;
+    double duration = 10;
+    int connections = 64;
+    int threads = 2;
+    double summaryPercent = 0;
+    string amount = "19.90";
+    double timeout = 10;
+
+    /**
+     * @brief Lê as opções no formato "--nome valor". Retorna false (e imprime o uso) se alguma for inválida.
+     */
+    static bool parse(int argc, char *argv[], LoadGeneratorOptions &options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            string_view name = argv[i];
+
+            if (name == "--help" || i + 1 >= argc)
+            {
+                printUsage(argv[0]);
+                return false;
+            }
+
+            const char *value = argv[++i];
+
+            if (name == "--host")
+            {
+                options.host = value;
+            }
+            else if (name == "--port")
+            {
+                options.port = atoi(value);
+            }
+            else if (name == "--rate")
+            {
+                options.rate = strtod(value, nullptr);
+            }
+            else if (name == "--duration")
+            {
+                options.duration = strtod(value, nullptr);
+            }
+            else if (name == "--connections")
+            {
+                options.connections = atoi(value);
+            }
+            else if (name == "--threads")
+            {
+                options.threads = atoi(value);
+            }
+            else if (name == "--summary-percent")
+            {
+                options.summaryPercent = strtod(value, nullptr);
+            }
+            else if (name == "--amount")
+            {
+                options.amount = value;
+            }
+            else if (name == "--timeout")
+            {
+                options.timeout = strtod(value, nullptr);
+            }
+            else
+            {
+                cerr << "Opção inválida: " << name << endl;
+                printUsage(argv[0]);
+                return false;
+            }
+        }
+
+        if (options.port <= 0 || options.rate <= 0 || options.duration <= 0 || options.connections <= 0 || options.threads <= 0 ||
+            options.summaryPercent < 0 || options.summaryPercent > 100 || options.timeout <= 0)
+        {
+            cerr << "Opções fora da faixa válida" << endl;
+            printUsage(argv[0]);
+            return false;
+        }
+
+        options.threads = min(options.threads, options.connections);
+
+        return true;
+    }
+
+    static void printUsage(const char *program)
+    {
+        cerr << "Uso: " << program << " [opções]\n"
+             << "  --host <ip>               servidor (padrão 127.0.0.1)\n"
+             << "  --port <porta>            porta (padrão 9999)\n"
+             << "  --rate <req/s>            taxa de chegada constante (padrão 1000)\n"
+             << "  --duration <s>            duração do agendamento (padrão 10)\n"
+             << "  --connections <n>         conexões abertas ao mesmo tempo (padrão 64)\n"
+             << "  --threads <n>             threads de envio (padrão 2)\n"
+             << "  --summary-percent <p>     % das requests que são GET /payments-summary (padrão 0)\n"
+             << "  --amount <valor>          amount dos pagamentos (padrão 19.90)\n"
+             << "  --timeout <s>             tempo máximo de espera por uma resposta (padrão 10)\n";
+    }
+};
+
+/**
+ * @brief Resultados compartilhados entre as threads do gerador de carga.
+ */
+class LoadStatistics
+{
+public:
+    /**
+     * @brief Latência a partir do horário previsto da request (corrigida para coordinated omission).
+     */
+    array<LatencyHistogram, static_cast<size_t>(LoadRequestKind::COUNT)> correctedLatency;
+
+    /**
+     * @brief Latência a partir do envio da request.
+     */
+    array<LatencyHistogram, static_cast<size_t>(LoadRequestKind::COUNT)> serviceLatency;
+
+    array<atomic<uint64_t>, static_cast<size_t>(LoadRequestKind::COUNT)> maxCorrectedLatency{};
+
+    /**
+     * @brief Respostas por classe de status (índice = status / 100).
+     */
+    array<atomic<uint64_t>, 6> statusClasses{};
+
+    atomic<uint64_t> connectionErrors{0};
+    atomic<uint64_t> timeouts{0};
+    atomic<uint64_t> reconnects{0};
+    atomic<uint64_t> maxBacklog{0};
+
+    /**
+     * @brief Registra uma resposta completa.
+     */
+    void recordResponse(LoadRequestKind kind, int status, uint64_t correctedNanoseconds, uint64_t serviceNanoseconds)
+    {
+        size_t index = static_cast<size_t>(kind);
+
+        statusClasses[status >= 100 && status < 600 ? status / 100 : 0].fetch_add(1, memory_order_relaxed);
+
+        correctedLatency[index].record(correctedNanoseconds);
+        serviceLatency[index].record(serviceNanoseconds);
+        updateMax(maxCorrectedLatency[index], correctedNanoseconds);
+    }
+
+    static void updateMax(atomic<uint64_t> &target, uint64_t value)
+    {
+        uint64_t current = target.load(memory_order_relaxed);
+
+        while (value > current && !target.compare_exchange_weak(current, value, memory_order_relaxed))
+        {
+        }
+    }
+};
+
+/**
+ * @brief Thread de envio: agenda a sua fatia da taxa e atende as próprias conexões com epoll.
+ *
+ * Com T threads, a thread i agenda as requests i, i + T, i + 2T, ..., de forma que o conjunto mantém
+ * o intervalo de 1 / rate entre requests. Quando não há conexão livre a request fica na fila (backlog)
+ * e o tempo de espera conta na latência corrigida.
+ */
+class LoadWorker
+{
+public:
+    LoadWorker(const LoadGeneratorOptions &options, const sockaddr_in &address, LoadStatistics &statistics, int workerIndex, int connectionCount, uint64_t startNanoseconds, int64_t startEpochMillis)
+        : options(options), address(address), statistics(statistics), connections(connectionCount), random(workerIndex * 0x9E3779B97F4A7C15ULL + 1),
+          startEpochMillis(startEpochMillis)
+    {
+        double intervalNanoseconds = 1e9 / options.rate;
+
+        interval = intervalNanoseconds * options.threads;
+        nextIntended = startNanoseconds + static_cast<uint64_t>(intervalNanoseconds * workerIndex);
+        total = static_cast<uint64_t>(options.rate * options.duration);
+        total = total / options.threads + (static_cast<uint64_t>(workerIndex) < total % options.threads ? 1 : 0);
+        timeoutNanoseconds = static_cast<uint64_t>(options.timeout * 1e9);
+
+        hostHeader = options.host + ":" + to_string(options.port);
+
+        for (size_t i = 0; i < connections.size(); i++)
+        {
+            freeConnections.push_back(i);
+        }
+    }
+
+    /**
+     * @brief Executa o agendamento até o fim e espera as respostas pendentes (até o timeout).
+     */
+    void run()
+    {
+        epollDescriptor = epoll_create1(EPOLL_CLOEXEC);
+        timerDescriptor = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+        epoll_event timerEvent{};
+        timerEvent.events = EPOLLIN;
+        timerEvent.data.u64 = TIMER_TOKEN;
+        epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, timerDescriptor, &timerEvent);
+
+        array<epoll_event, 256> events;
+
+        while (true)
+        {
+            uint64_t now = nowNanoseconds();
+
+            while (issued < total && nextIntended <= now)
+            {
+                bool summary = options.summaryPercent > 0 && uniform_real_distribution<double>(0, 100)(random) < options.summaryPercent;
+
+                backlog.push_back({static_cast<uint64_t>(nextIntended), summary ? LoadRequestKind::PAYMENTS_SUMMARY : LoadRequestKind::PAYMENTS});
+                nextIntended += interval;
+                issued++;
+            }
+
+            LoadStatistics::updateMax(statistics.maxBacklog, backlog.size());
+
+            dispatch(now);
+            expireTimeouts(now);
+
+            if (issued == total && backlog.empty() && inFlight == 0)
+            {
+                break;
+            }
+
+            int waitMilliseconds = -1;
+
+            if (issued < total)
+            {
+                armTimer(static_cast<uint64_t>(nextIntended));
+            }
+            else
+            {
+                // Sem mais agendamentos: acorda periodicamente só para verificar os timeouts
+                waitMilliseconds = 100;
+            }
+
+            int ready = epoll_wait(epollDescriptor, events.data(), events.size(), waitMilliseconds);
+
+            for (int i = 0; i < ready; i++)
+            {
+                if (events[i].data.u64 == TIMER_TOKEN)
+                {
+                    uint64_t expirations;
+                    ssize_t ignored = read(timerDescriptor, &expirations, sizeof(expirations));
+                    (void)ignored;
+                    continue;
+                }
+
+                handleEvent(events[i].data.u64, events[i].events);
+            }
+        }
+
+        for (Connection &connection : connections)
+        {
+            if (connection.socket >= 0)
+            {
+                close(connection.socket);
+            }
+        }
+
+        close(timerDescriptor);
+        close(epollDescriptor);
+    }
+
+private:
+    static constexpr uint64_t TIMER_TOKEN = numeric_limits<uint64_t>::max();
+
+    /**
+     * @brief Tamanho máximo guardado da resposta (as do servidor têm poucas centenas de bytes).
+     */
+    static constexpr size_t RESPONSE_BUFFER_SIZE = 4096;
+
+    enum class ConnectionState
+    {
+        CLOSED,
+        CONNECTING,
+        IDLE,
+        BUSY
+    };
+
+    struct ScheduledRequest
+    {
+        uint64_t intendedNanoseconds;
+        LoadRequestKind kind;
+    };
+
+    struct Connection
+    {
+        int socket = -1;
+        ConnectionState state = ConnectionState::CLOSED;
+        ScheduledRequest request{};
+        string payload;
+        size_t written = 0;
+        char response[RESPONSE_BUFFER_SIZE];
+        size_t received = 0;
+        uint64_t sentNanoseconds = 0;
+        uint32_t servedRequests = 0;
+        bool retried = false;
+    };
+
+    const LoadGeneratorOptions &options;
+    const sockaddr_in &address;
+    LoadStatistics &statistics;
+    vector<Connection> connections;
+    vector<size_t> freeConnections;
+    deque<ScheduledRequest> backlog;
+    mt19937_64 random;
+    int64_t startEpochMillis;
+    string hostHeader;
+    double interval = 0;
+    double nextIntended = 0;
+    uint64_t total = 0;
+    uint64_t issued = 0;
+    uint64_t inFlight = 0;
+    uint64_t timeoutNanoseconds = 0;
+    int epollDescriptor = -1;
+    int timerDescriptor = -1;
+
+    static uint64_t nowNanoseconds()
+    {
+        return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    void armTimer(uint64_t deadlineNanoseconds)
+    {
+        itimerspec deadline{};
+        deadline.it_value.tv_sec = deadlineNanoseconds / 1000000000;
+        deadline.it_value.tv_nsec = deadlineNanoseconds % 1000000000;
+
+        timerfd_settime(timerDescriptor, TFD_TIMER_ABSTIME, &deadline, nullptr);
+    }
+
+    /**
+     * @brief Entrega as requests do backlog para as conexões livres.
+     */
+    void dispatch(uint64_t now)
+    {
+        while (!backlog.empty() && !freeConnections.empty())
+        {
+            size_t index = freeConnections.back();
+            freeConnections.pop_back();
+
+            Connection &connection = connections[index];
+            connection.request = backlog.front();
+            connection.retried = false;
+            backlog.pop_front();
+
+            buildPayload(connection);
+            inFlight++;
+
+            start(index, now);
+        }
+    }
+
+    /**
+     * @brief Envia a request da conexão, abrindo uma conexão nova se necessário.
+     */
+    void start(size_t index, uint64_t now)
+    {
+        Connection &connection = connections[index];
+
+        connection.written = 0;
+        connection.received = 0;
+        connection.sentNanoseconds = now;
+
+        if (connection.state == ConnectionState::IDLE)
+        {
+            connection.state = ConnectionState::BUSY;
+            writePayload(index);
+            return;
+        }
+
+        if (!openConnection(index))
+        {
+            statistics.connectionErrors.fetch_add(1, memory_order_relaxed);
+            finish(index);
+        }
+    }
+
+    bool openConnection(size_t index)
+    {
+        Connection &connection = connections[index];
+
+        connection.socket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+        if (connection.socket < 0)
+        {
+            return false;
+        }
+
+        int enabled = 1;
+        setsockopt(connection.socket, IPPROTO_TCP, TCP_NODELAY, &enabled, sizeof(enabled));
+
+        if (connect(connection.socket, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) < 0 && errno != EINPROGRESS)
+        {
+            close(connection.socket);
+            connection.socket = -1;
+            return false;
+        }
+
+        connection.state = ConnectionState::CONNECTING;
+        connection.servedRequests = 0;
+
+        epoll_event event{};
+        event.events = EPOLLOUT | EPOLLIN | EPOLLRDHUP;
+        event.data.u64 = index;
+        epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, connection.socket, &event);
+
+        return true;
+    }
+
+    void closeConnection(Connection &connection)
+    {
+        if (connection.socket >= 0)
+        {
+            close(connection.socket);
+        }
+
+        connection.socket = -1;
+        connection.state = ConnectionState::CLOSED;
+    }
+
+    /**
+     * @brief Monta a request HTTP: pagamentos com correlationId único, resumos com a janela desde o início do teste.
+     */
+    void buildPayload(Connection &connection)
+    {
+        string &payload = connection.payload;
+        payload.clear();
+
+        if (connection.request.kind == LoadRequestKind::PAYMENTS)
+        {
+            uint8_t UUID[16];
+            char correlationId[36];
+
+            UUIDGenerator::createUUID(UUID);
+            UUIDGenerator::toChars(UUID, correlationId);
+
+            char body[128];
+            int bodyLength = snprintf(body, sizeof(body), "{\"correlationId\":\"%.36s\",\"amount\":%s}", correlationId, options.amount.c_str());
+
+            payload.append("POST /payments HTTP/1.1\r\nHost: ").append(hostHeader);
+            payload.append("\r\nContent-Type: application/json\r\nContent-Length: ").append(to_string(bodyLength)).append("\r\n\r\n");
+            payload.append(body, bodyLength);
+        }
+        else
+        {
+            payload.append("GET /payments-summary?from=");
+            appendEncodedTimestamp(payload, startEpochMillis);
+            payload.append("&to=");
+            appendEncodedTimestamp(payload, TimeUtils::getEpochMillisUTC());
+            payload.append(" HTTP/1.1\r\nHost: ").append(hostHeader).append("\r\n\r\n");
+        }
+    }
+
+    static void appendEncodedTimestamp(string &output, int64_t epochMillis)
+    {
+        char buffer[TimeUtils::TIMESTAMP_MAX_SIZE];
+        char *end = TimeUtils::formatTimestampUTC(epochMillis, buffer);
+
+        for (char *character = buffer; character < end; character++)
+        {
+            if (*character == ':')
+            {
+                output.append("%3A");
+            }
+            else
+            {
+                output.push_back(*character);
+            }
+        }
+    }
+
+    void writePayload(size_t index)
+    {
+        Connection &connection = connections[index];
+
+        while (connection.written < connection.payload.size())
+        {
+            ssize_t sent = send(connection.socket, connection.payload.data() + connection.written, connection.payload.size() - connection.written, MSG_NOSIGNAL);
+
+            if (sent < 0)
+            {
+                if (errno == EAGAIN)
+                {
+                    watch(index, EPOLLIN | EPOLLOUT | EPOLLRDHUP);
+                    return;
+                }
+
+                fail(index);
+                return;
+            }
+
+            connection.written += sent;
+        }
+
+        watch(index, EPOLLIN | EPOLLRDHUP);
+    }
+
+    void watch(size_t index, uint32_t events)
+    {
+        epoll_event event{};
+        event.events = events;
+        event.data.u64 = index;
+        epoll_ctl(epollDescriptor, EPOLL_CTL_MOD, connections[index].socket, &event);
+    }
+
+    void handleEvent(size_t index, uint32_t events)
+    {
+        Connection &connection = connections[index];
+
+        switch (connection.state)
+        {
+        case ConnectionState::CONNECTING:
+        {
+            int error = 0;
+            socklen_t length = sizeof(error);
+            getsockopt(connection.socket, SOL_SOCKET, SO_ERROR, &error, &length);
+
+            if (error != 0)
+            {
+                closeConnection(connection);
+                statistics.connectionErrors.fetch_add(1, memory_order_relaxed);
+                finish(index);
+                return;
+            }
+
+            connection.state = ConnectionState::BUSY;
+            writePayload(index);
+            return;
+        }
+        case ConnectionState::IDLE:
+            // O servidor fechou (ou mandou algo inesperado) uma conexão ociosa: ela é reaberta no próximo uso
+            closeConnection(connection);
+            return;
+        case ConnectionState::BUSY:
+            if (events & EPOLLOUT)
+            {
+                writePayload(index);
+            }
+
+            if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+            {
+                readResponse(index);
+            }
+            return;
+        case ConnectionState::CLOSED:
+            return;
+        }
+    }
+
+    void readResponse(size_t index)
+    {
+        Connection &connection = connections[index];
+
+        while (true)
+        {
+            char *output = connection.response + min(connection.received, RESPONSE_BUFFER_SIZE);
+            size_t available = RESPONSE_BUFFER_SIZE - min(connection.received, RESPONSE_BUFFER_SIZE);
+
+            char discard[RESPONSE_BUFFER_SIZE];
+
+            if (available == 0)
+            {
+                output = discard;
+                available = sizeof(discard);
+            }
+
+            ssize_t bytesRead = recv(connection.socket, output, available, 0);
+
+            if (bytesRead > 0)
+            {
+                connection.received += bytesRead;
+
+                int status;
+
+                if (isComplete(connection, false, status))
+                {
+                    complete(index, status);
+                    return;
+                }
+
+                continue;
+            }
+
+            if (bytesRead < 0 && errno == EAGAIN)
+            {
+                return;
+            }
+
+            // Conexão fechada pelo servidor
+            int status;
+
+            if (isComplete(connection, true, status))
+            {
+                complete(index, status);
+                closeConnection(connection);
+                return;
+            }
+
+            // Uma conexão reaproveitada que fecha sem responder nada não chegou a ser lida pelo servidor: reenvia uma vez
+            if (connection.received == 0 && connection.servedRequests > 0 && !connection.retried)
+            {
+                closeConnection(connection);
+                statistics.reconnects.fetch_add(1, memory_order_relaxed);
+                connection.retried = true;
+
+                uint64_t sentNanoseconds = connection.sentNanoseconds;
+                start(index, sentNanoseconds);
+                return;
+            }
+
+            fail(index);
+            return;
+        }
+    }
+
+    /**
+     * @brief Verifica se a resposta está completa (cabeçalhos + Content-Length bytes, ou até o fechamento se não houver Content-Length).
+     */
+    static bool isComplete(const Connection &connection, bool closed, int &status)
+    {
+        string_view received(connection.response, min(connection.received, RESPONSE_BUFFER_SIZE));
+        size_t headerEnd = received.find("\r\n\r\n");
+
+        if (headerEnd == string_view::npos || received.size() < 12)
+        {
+            return false;
+        }
+
+        status = atoi(connection.response + 9);
+
+        string_view headers = received.substr(0, headerEnd);
+        size_t lineStart = headers.find("\r\n");
+
+        while (lineStart != string_view::npos)
+        {
+            lineStart += 2;
+            size_t lineEnd = headers.find("\r\n", lineStart);
+            string_view line = headers.substr(lineStart, lineEnd == string_view::npos ? string_view::npos : lineEnd - lineStart);
+
+            if (line.size() > 15 && strncasecmp(line.data(), "content-length:", 15) == 0)
+            {
+                size_t contentLength = strtoul(string(line.substr(15)).c_str(), nullptr, 10);
+
+                return connection.received >= headerEnd + 4 + contentLength;
+            }
+
+            lineStart = lineEnd;
+        }
+
+        return closed;
+    }
+
+    void complete(size_t index, int status)
+    {
+        Connection &connection = connections[index];
+        uint64_t now = nowNanoseconds();
+
+        statistics.recordResponse(connection.request.kind, status, now - connection.request.intendedNanoseconds, now - connection.sentNanoseconds);
+
+        connection.servedRequests++;
+        connection.state = ConnectionState::IDLE;
+        finish(index);
+    }
+
+    void fail(size_t index)
+    {
+        closeConnection(connections[index]);
+        statistics.connectionErrors.fetch_add(1, memory_order_relaxed);
+        finish(index);
+    }
+
+    /**
+     * @brief Devolve a conexão para a lista de livres.
+     */
+    void finish(size_t index)
+    {
+        inFlight--;
+        freeConnections.push_back(index);
+    }
+
+    void expireTimeouts(uint64_t now)
+    {
+        for (size_t index = 0; index < connections.size(); index++)
+        {
+            Connection &connection = connections[index];
+
+            if ((connection.state == ConnectionState::BUSY || connection.state == ConnectionState::CONNECTING) &&
+                now - connection.sentNanoseconds > timeoutNanoseconds)
+            {
+                closeConnection(connection);
+                statistics.timeouts.fetch_add(1, memory_order_relaxed);
+                finish(index);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Imprime o resultado do teste de carga.
+ */
+class LoadReport
+{
+public:
+    static void print(const LoadGeneratorOptions &options, LoadStatistics &statistics, double elapsedSeconds)
+    {
+        uint64_t completed = 0;
+
+        for (const atomic<uint64_t> &statusClass : statistics.statusClasses)
+        {
+            completed += statusClass.load();
+        }
+
+        uint64_t scheduled = static_cast<uint64_t>(options.rate * options.duration);
+
+        cout << fixed << setprecision(1);
+        cout << "Alvo: " << options.rate << " req/s por " << options.duration << " s (" << scheduled << " requests), "
+             << options.connections << " conexões, " << options.threads << " threads, "
+             << options.summaryPercent << "% GET /payments-summary" << endl;
+        cout << "Concluídas: " << completed << " em " << elapsedSeconds << " s (" << completed / elapsedSeconds << " req/s)" << endl;
+        cout << "Respostas: 2xx " << statistics.statusClasses[2] << ", 4xx " << statistics.statusClasses[4] << ", 5xx " << statistics.statusClasses[5]
+             << ", outras " << statistics.statusClasses[0] + statistics.statusClasses[1] + statistics.statusClasses[3] << endl;
+        cout << "Falhas: conexão " << statistics.connectionErrors << ", timeout " << statistics.timeouts
+             << " | reenvios " << statistics.reconnects << ", backlog máximo " << statistics.maxBacklog << endl;
+
+        cout << endl
+             << left << setw(34) << "latência (ms)" << right << setw(9) << "count" << setw(10) << "p50" << setw(10) << "p90"
+             << setw(10) << "p99" << setw(10) << "p99.9" << setw(10) << "max" << endl;
+
+        static constexpr array<const char *, static_cast<size_t>(LoadRequestKind::COUNT)> KIND_LABELS = {"POST /payments", "GET /payments-summary"};
+
+        for (size_t kind = 0; kind < KIND_LABELS.size(); kind++)
+        {
+            if (statistics.correctedLatency[kind].getCount() == 0)
+            {
+                continue;
+            }
+
+            printRow(string(KIND_LABELS[kind]) + " (corrigida)", statistics.correctedLatency[kind], statistics.maxCorrectedLatency[kind]);
+            printRow(string(KIND_LABELS[kind]) + " (serviço)", statistics.serviceLatency[kind], 0);
+        }
+    }
+
+private:
+    static void printRow(const string &label, const LatencyHistogram &histogram, uint64_t maxNanoseconds)
+    {
+        cout << left << setw(34) << label << right << setw(9) << histogram.getCount() << setprecision(2);
+
+        for (double percentile : {0.5, 0.9, 0.99, 0.999})
+        {
+            cout << setw(10) << histogram.getPercentile(percentile) / 1e6;
+        }
+
+        if (maxNanoseconds > 0)
+        {
+            cout << setw(10) << maxNanoseconds / 1e6;
+        }
+        else
+        {
+            cout << setw(10) << "-";
+        }
+
+        cout << setprecision(1) << endl;
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    LoadGeneratorOptions options;
+
+    if (!LoadGeneratorOptions::parse(argc, argv, options))
+    {
+        return EXIT_FAILURE;
+    }
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(options.port);
+
+    if (inet_pton(AF_INET, options.host.c_str(), &address.sin_addr) != 1)
+    {
+        addrinfo hints{};
+        hints.ai_family = AF_INET;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo *result = nullptr;
+
+        if (getaddrinfo(options.host.c_str(), nullptr, &hints, &result) != 0 || result == nullptr)
+        {
+            cerr << "Não foi possível resolver o host " << options.host << endl;
+            return EXIT_FAILURE;
+        }
+
+        address.sin_addr = reinterpret_cast<sockaddr_in *>(result->ai_addr)->sin_addr;
+        freeaddrinfo(result);
+    }
+
+    LoadStatistics statistics;
+    vector<unique_ptr<LoadWorker>> workers;
+    vector<thread> threads;
+
+    // Pequena folga para todas as threads estarem prontas no primeiro horário previsto
+    uint64_t startNanoseconds = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count() + 10000000;
+    int64_t startEpochMillis = TimeUtils::getEpochMillisUTC();
+
+    for (int i = 0; i < options.threads; i++)
+    {
+        int connectionCount = options.connections / options.threads + (i < options.connections % options.threads ? 1 : 0);
+
+        workers.push_back(make_unique<LoadWorker>(options, address, statistics, i, connectionCount, startNanoseconds, startEpochMillis));
+    }
+
+    auto start = chrono::steady_clock::now();
+
+    for (unique_ptr<LoadWorker> &worker : workers)
+    {
+        threads.emplace_back([&worker]()
+                             { worker->run(); });
+    }
+
+    for (thread &worker : threads)
+    {
+        worker.join();
+    }
+
+    double elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    LoadReport::print(options, statistics, elapsedSeconds);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,725 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file mock_processor.cpp
+ * @brief Payment processor local (substituto dos contêineres da Rinha) com injeção de latência e de falhas.
+ *
+ * Implementa os endpoints usados pelo servidor:
+ *  - POST /payments: registra o pagamento (422 se o correlationId repetir, 500 dentro de uma janela de falha);
+ *  - GET /payments/service-health: {"failing", "minResponseTime"}, limitado a uma chamada a cada --health-interval segundos (429);
+ *  - GET /admin/payments-summary: totais no intervalo from / to (exige o header X-Rinha-Token);
+ *  - POST /admin/purge-payments, PUT /admin/configurations/delay e PUT /admin/configurations/failure, como no processor original.
+ *
+ * A latência de cada pagamento é sorteada de uma distribuição (--latency) e pode ser trocada por janelas de
+ * tempo (--phase), contadas a partir do início do processo, o que deixa os experimentos de roteamento e
+ * vazão reproduzíveis sem rede. Usa as classes do servidor (src/garnize.h, ligado com a libgarnize.a) para
+ * reaproveitar o HttpRequestParser, o JsonParser e o TimeUtils.
+ *
+ * Compilar e rodar: ./compile.sh --mock-processor --port 8001 --latency normal:10,2 --phase 30-40:fail
+ */
+
+#include "../src/garnize.h"
+
+#include <random>
+#include <unordered_set>
+
+/**
+ * @brief Distribuição de latência ("fixed:10", "uniform:5,20", "normal:10,2" ou "exponential:10", em milissegundos).
+ */
+struct LatencyDistribution
+{
+    enum class Type
+    {
+        FIXED,
+        UNIFORM,
+        NORMAL,
+        EXPONENTIAL
+    };
+
+    Type type = Type::FIXED;
+    double first = 0;
+    double second = 0;
+
+    /**
+     * @brief Lê a especificação da distribuição. Retorna false se ela for inválida.
+     */
+    static bool parse(string_view specification, LatencyDistribution &distribution)
+    {
+        size_t separator = specification.find(':');
+
+        if (separator == string_view::npos)
+        {
+            return false;
+        }
+
+        string_view name = specification.substr(0, separator);
+        string parameters(specification.substr(separator + 1));
+        char *end = nullptr;
+
+        distribution.first = strtod(parameters.c_str(), &end);
+        distribution.second = *end == ',' ? strtod(end + 1, &end) : 0;
+
+        if (*end != '\0' || distribution.first < 0 || distribution.second < 0)
+        {
+            return false;
+        }
+
+        if (name == "fixed")
+        {
+            distribution.type = Type::FIXED;
+        }
+        else if (name == "uniform" && distribution.second >= distribution.first)
+        {
+            distribution.type = Type::UNIFORM;
+        }
+        else if (name == "normal")
+        {
+            distribution.type = Type::NORMAL;
+        }
+        else if (name == "exponential" && distribution.first > 0)
+        {
+            distribution.type = Type::EXPONENTIAL;
+        }
+        else
+        {
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Sorteia uma latência em milissegundos (nunca negativa).
+     */
+    double sample(mt19937_64 &random) const
+    {
+        switch (type)
+        {
+        case Type::UNIFORM:
+            return uniform_real_distribution<double>(first, second)(random);
+        case Type::NORMAL:
+            return max(0.0, normal_distribution<double>(first, second)(random));
+        case Type::EXPONENTIAL:
+            return exponential_distribution<double>(1.0 / first)(random);
+        case Type::FIXED:
+            break;
+        }
+
+        return first;
+    }
+
+    /**
+     * @brief Valor informado no minResponseTime do health check: o fixo, o mínimo da uniforme ou a média das demais.
+     */
+    int64_t baseMilliseconds() const
+    {
+        return static_cast<int64_t>(first);
+    }
+};
+
+/**
+ * @brief Janela de tempo (em segundos desde o início) com falha forçada ou com outra distribuição de latência.
+ */
+struct MockPhase
+{
+    double startSeconds = 0;
+    double endSeconds = 0;
+    bool failing = false;
+    LatencyDistribution latency;
+
+    /**
+     * @brief Lê "<início>-<fim>:fail" ou "<início>-<fim>:<distribuição>".
+     */
+    static bool parse(string_view specification, MockPhase &phase)
+    {
+        size_t separator = specification.find(':');
+
+        if (separator == string_view::npos)
+        {
+            return false;
+        }
+
+        string window(specification.substr(0, separator));
+        string_view action = specification.substr(separator + 1);
+        char *end = nullptr;
+
+        phase.startSeconds = strtod(window.c_str(), &end);
+
+        if (*end != '-')
+        {
+            return false;
+        }
+
+        phase.endSeconds = strtod(end + 1, &end);
+
+        if (*end != '\0' || phase.endSeconds <= phase.startSeconds)
+        {
+            return false;
+        }
+
+        if (action == "fail")
+        {
+            phase.failing = true;
+            return true;
+        }
+
+        return LatencyDistribution::parse(action, phase.latency);
+    }
+};
+
+/**
+ * @brief Opções do mock (linha de comando).
+ */
+struct MockProcessorOptions
+{
+    int port = 8001;
+    LatencyDistribution latency;
+    vector<MockPhase> phases;
+    double failureRate = 0;
+    double healthIntervalSeconds = 5;
+    double fee = 0.05;
+    string token = "123";
+    uint64_t seed = 42;
+
+    /**
+     * @brief Lê as opções no formato "--nome valor". Retorna false (e imprime o uso) se alguma for inválida.
+     */
+    static bool parse(int argc, char *argv[], MockProcessorOptions &options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            string_view name = argv[i];
+
+            if (name == "--help" || i + 1 >= argc)
+            {
+                printUsage(argv[0]);
+                return false;
+            }
+
+            const char *value = argv[++i];
+            bool valid = true;
+
+            if (name == "--port")
+            {
+                options.port = atoi(value);
+                valid = options.port > 0;
+            }
+            else if (name == "--latency")
+            {
+                valid = LatencyDistribution::parse(value, options.latency);
+            }
+            else if (name == "--phase")
+            {
+                MockPhase phase;
+                valid = MockPhase::parse(value, phase);
+                options.phases.push_back(phase);
+            }
+            else if (name == "--failure-rate")
+            {
+                options.failureRate = strtod(value, nullptr);
+                valid = options.failureRate >= 0 && options.failureRate <= 1;
+            }
+            else if (name == "--health-interval")
+            {
+                options.healthIntervalSeconds = strtod(value, nullptr);
+                valid = options.healthIntervalSeconds >= 0;
+            }
+            else if (name == "--fee")
+            {
+                options.fee = strtod(value, nullptr);
+            }
+            else if (name == "--token")
+            {
+                options.token = value;
+            }
+            else if (name == "--seed")
+            {
+                options.seed = strtoull(value, nullptr, 10);
+            }
+            else
+            {
+                valid = false;
+            }
+
+            if (!valid)
+            {
+                cerr << "Opção inválida: " << name << " " << value << endl;
+                printUsage(argv[0]);
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    static void printUsage(const char *program)
+    {
+        cerr << "Uso: " << program << " [opções]\n"
+             << "  --port <porta>             porta (padrão 8001)\n"
+             << "  --latency <distribuição>   latência do POST /payments: fixed:ms, uniform:min,max, normal:média,desvio ou exponential:média (padrão fixed:0)\n"
+             << "  --phase <início>-<fim>:<ação>  janela em segundos desde o início com 'fail' ou outra distribuição (pode repetir)\n"
+             << "  --failure-rate <0..1>      fração de pagamentos que falham fora das janelas (padrão 0)\n"
+             << "  --health-interval <s>      intervalo mínimo entre health checks, 0 desliga o limite (padrão 5)\n"
+             << "  --fee <fração>             taxa por transação do resumo (padrão 0.05)\n"
+             << "  --token <token>            valor esperado no X-Rinha-Token (padrão 123)\n"
+             << "  --seed <n>                 semente do sorteio de latências e falhas (padrão 42)\n";
+    }
+};
+
+/**
+ * @brief Estado do mock: pagamentos recebidos, configuração corrente e limite do health check.
+ */
+class MockProcessor
+{
+public:
+    explicit MockProcessor(const MockProcessorOptions &options) : options(options), latency(options.latency), random(options.seed), start(chrono::steady_clock::now()) {}
+
+    /**
+     * @brief Atende uma request e escreve a resposta (status e corpo JSON).
+     */
+    void handle(const HttpRequest &request, string_view raw, int &status, string &body)
+    {
+        if (request.method == "POST" && request.path == "/payments")
+        {
+            payment(request.body, status, body);
+        }
+        else if (request.method == "GET" && request.path == "/payments/service-health")
+        {
+            health(status, body);
+        }
+        else if (request.method == "GET" && request.path == "/admin/payments-summary")
+        {
+            summary(request.query, raw, status, body);
+        }
+        else if (request.method == "POST" && request.path == "/admin/purge-payments")
+        {
+            lock_guard<mutex> lock(paymentsMutex);
+            payments.clear();
+            correlationIds.clear();
+
+            status = 200;
+            body = "{\"message\":\"All payments purged.\"}";
+        }
+        else if (request.method == "PUT" && request.path == "/admin/configurations/delay")
+        {
+            configureDelay(request.body, status, body);
+        }
+        else if (request.method == "PUT" && request.path == "/admin/configurations/failure")
+        {
+            configureFailure(request.body, status, body);
+        }
+        else
+        {
+            status = 404;
+            body = "{}";
+        }
+    }
+
+    /**
+     * @brief Procura um header (sem diferenciar maiúsculas) nos cabeçalhos da request.
+     */
+    static bool findHeader(string_view raw, string_view name, string_view &value)
+    {
+        size_t headersEnd = raw.find("\r\n\r\n");
+        size_t lineStart = raw.find("\r\n");
+
+        while (lineStart != string_view::npos && lineStart < headersEnd)
+        {
+            lineStart += 2;
+            size_t lineEnd = raw.find("\r\n", lineStart);
+            string_view line = raw.substr(lineStart, lineEnd - lineStart);
+
+            if (line.size() > name.size() && line[name.size()] == ':' && strncasecmp(line.data(), name.data(), name.size()) == 0)
+            {
+                value = line.substr(name.size() + 1);
+
+                while (!value.empty() && value.front() == ' ')
+                {
+                    value.remove_prefix(1);
+                }
+
+                return true;
+            }
+
+            lineStart = lineEnd;
+        }
+
+        return false;
+    }
+
+private:
+    struct StoredPayment
+    {
+        int64_t requestedAtMillis;
+        int64_t amountInCents;
+    };
+
+    const MockProcessorOptions &options;
+
+    mutex configurationMutex;
+    LatencyDistribution latency;
+    bool forcedFailure = false;
+    mt19937_64 random;
+    chrono::steady_clock::time_point start;
+    chrono::steady_clock::time_point lastHealthCheck{};
+    bool healthChecked = false;
+
+    mutex paymentsMutex;
+    vector<StoredPayment> payments;
+    unordered_set<string> correlationIds;
+
+    /**
+     * @brief Situação no instante atual: se está falhando e a latência sorteada para o pagamento.
+     */
+    void currentBehaviour(bool &failing, double &latencyMilliseconds, int64_t &minResponseTime)
+    {
+        lock_guard<mutex> lock(configurationMutex);
+
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        const LatencyDistribution *distribution = &latency;
+
+        failing = forcedFailure;
+
+        for (const MockPhase &phase : options.phases)
+        {
+            if (elapsed >= phase.startSeconds && elapsed < phase.endSeconds)
+            {
+                if (phase.failing)
+                {
+                    failing = true;
+                }
+                else
+                {
+                    distribution = &phase.latency;
+                }
+            }
+        }
+
+        bool randomFailure = options.failureRate > 0 && uniform_real_distribution<double>(0, 1)(random) < options.failureRate;
+
+        latencyMilliseconds = distribution->sample(random);
+        minResponseTime = distribution->baseMilliseconds();
+        failing = failing || randomFailure;
+    }
+
+    void payment(string_view requestBody, int &status, string &body)
+    {
+        JsonObject json;
+        string_view correlationId;
+        string_view requestedAt;
+        int64_t amountInCents;
+        int64_t requestedAtMillis;
+
+        if (!JsonParser::parse(requestBody, json) || !json.getString("correlationId", correlationId) ||
+            !json.getAmountInCents("amount", amountInCents) || !json.getString("requestedAt", requestedAt) ||
+            !TimeUtils::parseTimestampUTC(requestedAt, requestedAtMillis))
+        {
+            status = 422;
+            body = "{\"message\":\"invalid payment\"}";
+            return;
+        }
+
+        bool failing;
+        double latencyMilliseconds;
+        int64_t minResponseTime;
+
+        currentBehaviour(failing, latencyMilliseconds, minResponseTime);
+
+        this_thread::sleep_for(chrono::duration<double, milli>(latencyMilliseconds));
+
+        if (failing)
+        {
+            status = 500;
+            body = "{\"message\":\"internal server error\"}";
+            return;
+        }
+
+        lock_guard<mutex> lock(paymentsMutex);
+
+        if (!correlationIds.emplace(correlationId).second)
+        {
+            status = 422;
+            body = "{\"message\":\"CorrelationId already exists\"}";
+            return;
+        }
+
+        payments.push_back({requestedAtMillis, amountInCents});
+
+        status = 200;
+        body = "{\"message\":\"payment processed successfully\"}";
+    }
+
+    void health(int &status, string &body)
+    {
+        {
+            lock_guard<mutex> lock(configurationMutex);
+
+            auto now = chrono::steady_clock::now();
+
+            if (healthChecked && chrono::duration<double>(now - lastHealthCheck).count() < options.healthIntervalSeconds)
+            {
+                status = 429;
+                body = "{\"message\":\"Too Many Requests\"}";
+                return;
+            }
+
+            healthChecked = true;
+            lastHealthCheck = now;
+        }
+
+        bool failing;
+        double latencyMilliseconds;
+        int64_t minResponseTime;
+
+        currentBehaviour(failing, latencyMilliseconds, minResponseTime);
+
+        status = 200;
+        body = "{\"failing\":";
+        body += failing ? "true" : "false";
+        body += ",\"minResponseTime\":" + to_string(minResponseTime) + "}";
+    }
+
+    void summary(string_view query, string_view raw, int &status, string &body)
+    {
+        string_view token;
+
+        if (!findHeader(raw, "X-Rinha-Token", token) || token != options.token)
+        {
+            status = 401;
+            body = "{\"message\":\"unauthorized\"}";
+            return;
+        }
+
+        int64_t fromMillis = numeric_limits<int64_t>::min();
+        int64_t toMillis = numeric_limits<int64_t>::max();
+        string_view value;
+
+        if ((HttpRequestParser::getQueryParam(query, "from", value) && !TimeUtils::parseTimestampUTC(value, fromMillis)) ||
+            (HttpRequestParser::getQueryParam(query, "to", value) && !TimeUtils::parseTimestampUTC(value, toMillis)))
+        {
+            status = 400;
+            body = "{\"message\":\"invalid from/to\"}";
+            return;
+        }
+
+        int64_t totalRequests = 0;
+        int64_t totalCents = 0;
+
+        {
+            lock_guard<mutex> lock(paymentsMutex);
+
+            for (const StoredPayment &payment : payments)
+            {
+                if (payment.requestedAtMillis >= fromMillis && payment.requestedAtMillis <= toMillis)
+                {
+                    totalRequests++;
+                    totalCents += payment.amountInCents;
+                }
+            }
+        }
+
+        char buffer[256];
+        snprintf(buffer, sizeof(buffer), "{\"totalRequests\":%lld,\"totalAmount\":%.2f,\"totalFee\":%.2f,\"feePerTransaction\":%.2f}",
+                 static_cast<long long>(totalRequests), totalCents / 100.0, totalCents / 100.0 * options.fee, options.fee);
+
+        status = 200;
+        body = buffer;
+    }
+
+    void configureDelay(string_view requestBody, int &status, string &body)
+    {
+        JsonObject json;
+        int64_t delay;
+
+        if (!JsonParser::parse(requestBody, json) || !json.getInt64("delay", delay) || delay < 0)
+        {
+            status = 400;
+            body = "{\"message\":\"invalid delay\"}";
+            return;
+        }
+
+        lock_guard<mutex> lock(configurationMutex);
+        latency = LatencyDistribution{LatencyDistribution::Type::FIXED, static_cast<double>(delay), 0};
+
+        status = 200;
+        body = "{\"message\":\"delay updated\"}";
+    }
+
+    void configureFailure(string_view requestBody, int &status, string &body)
+    {
+        JsonObject json;
+        bool failure;
+
+        if (!JsonParser::parse(requestBody, json) || !json.getBool("failure", failure))
+        {
+            status = 400;
+            body = "{\"message\":\"invalid failure\"}";
+            return;
+        }
+
+        lock_guard<mutex> lock(configurationMutex);
+        forcedFailure = failure;
+
+        status = 200;
+        body = "{\"message\":\"failure updated\"}";
+    }
+};
+
+/**
+ * @brief Atende uma conexão keep-alive: lê requests completas (cabeçalhos + Content-Length) e responde até o cliente fechar.
+ */
+class MockConnectionHandler
+{
+public:
+    static void handle(int socket, MockProcessor &processor)
+    {
+        string buffer;
+        char chunk[8192];
+
+        while (true)
+        {
+            size_t requestSize;
+
+            while (!hasCompleteRequest(buffer, requestSize))
+            {
+                ssize_t bytesRead = read(socket, chunk, sizeof(chunk));
+
+                if (bytesRead <= 0)
+                {
+                    close(socket);
+                    return;
+                }
+
+                buffer.append(chunk, bytesRead);
+            }
+
+            RequestArena arena;
+            string_view raw(buffer.data(), requestSize);
+            HttpRequest request;
+            int status = 400;
+            string body = "{}";
+
+            if (HttpRequestParser::parse(raw, request))
+            {
+                processor.handle(request, raw, status, body);
+            }
+
+            string response = "HTTP/1.1 " + to_string(status) + " " + reason(status) +
+                              "\r\nContent-Type: application/json\r\nContent-Length: " + to_string(body.size()) + "\r\n\r\n" + body;
+
+            if (send(socket, response.data(), response.size(), MSG_NOSIGNAL) < 0)
+            {
+                close(socket);
+                return;
+            }
+
+            buffer.erase(0, requestSize);
+        }
+    }
+
+private:
+    static bool hasCompleteRequest(const string &buffer, size_t &requestSize)
+    {
+        size_t headersEnd = buffer.find("\r\n\r\n");
+
+        if (headersEnd == string::npos)
+        {
+            return false;
+        }
+
+        string_view contentLength;
+        size_t bodySize = MockProcessor::findHeader(string_view(buffer.data(), headersEnd + 4), "Content-Length", contentLength) ? strtoul(string(contentLength).c_str(), nullptr, 10) : 0;
+
+        requestSize = headersEnd + 4 + bodySize;
+
+        return buffer.size() >= requestSize;
+    }
+
+    static const char *reason(int status)
+    {
+        switch (status)
+        {
+        case 200:
+            return "OK";
+        case 400:
+            return "Bad Request";
+        case 401:
+            return "Unauthorized";
+        case 404:
+            return "Not Found";
+        case 422:
+            return "Unprocessable Entity";
+        case 429:
+            return "Too Many Requests";
+        default:
+            return "Internal Server Error";
+        }
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    MockProcessorOptions options;
+
+    if (!MockProcessorOptions::parse(argc, argv, options))
+    {
+        return EXIT_FAILURE;
+    }
+
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    int enabled = 1;
+    setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &enabled, sizeof(enabled));
+
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = INADDR_ANY;
+    address.sin_port = htons(options.port);
+
+    if (bind(listener, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0 || listen(listener, SOMAXCONN) < 0)
+    {
+        cerr << "Falha ao escutar na porta " << options.port << endl;
+        return EXIT_FAILURE;
+    }
+
+    cout << "Mock payment processor escutando na porta " << options.port << endl;
+
+    MockProcessor processor(options);
+
+    while (true)
+    {
+        int connection = accept(listener, nullptr, nullptr);
+
+        if (connection < 0)
+        {
+            continue;
+        }
+
+        thread([connection, &processor]()
+               { MockConnectionHandler::handle(connection, processor); })
+            .detach();
+    }
+
+    return EXIT_SUCCESS;
+}
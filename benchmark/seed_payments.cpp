@@ -0,0 +1,591 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file seed_payments.cpp
+ * @brief Popula o banco de pagamentos com milhões de pagamentos sintéticos e mede o resumo com escrita concorrente.
+ *
+ * Os pagamentos são distribuídos nas últimas --hours horas seguindo uma curva diária de tráfego (pico às 15h UTC)
+ * e uma mistura de serviços: fora das quedas, --default-percent vão para o 'default'; em cada hora, o 'default'
+ * fica fora do ar por --outage-minutes minutos (em um horário sorteado) e tudo vai para o 'fallback'.
+ * A gravação usa as mesmas tabelas do servidor (partições por hora e rollups por segundo).
+ *
+ * Com --measure, depois de popular, threads leitoras medem o PaymentsUtils::getSummary (a consulta do
+ * GET /payments-summary) em janelas curtas (10 s), médias (1 h) e na faixa inteira, enquanto um produtor
+ * grava pagamentos novos pelo PaymentsDatabaseWriter, como as requests do servidor.
+ *
+ * Usa as classes do servidor (src/garnize.h, ligado com a libgarnize.a).
+ *
+ * Compilar e rodar: ./compile.sh --seed-payments [--count 5000000 --hours 24 --measure 30 ...]
+ */
+
+#include "../src/garnize.h"
+
+#include <random>
+
+/**
+ * @brief Opções da ferramenta (linha de comando).
+ */
+struct SeedOptions
+{
+    string database = Constants::DATABASE_PAYMENTS;
+    int64_t count = 1000000;
+    double hours = 24;
+    double defaultPercent = 85;
+    double outageMinutes = 3;
+    double unprocessedPercent = 1;
+    int64_t amountInCents = 1990;
+    uint64_t seed = 42;
+    double measureSeconds = 0;
+    double writeRate = 1000;
+    int readers = Constants::READ_POOL_SIZE;
+
+    /**
+     * @brief Lê as opções no formato "--nome valor". Retorna false (e imprime o uso) se alguma for inválida.
+     */
+    static bool parse(int argc, char *argv[], SeedOptions &options)
+    {
+        for (int i = 1; i < argc; i++)
+        {
+            string_view name = argv[i];
+
+            if (name == "--help" || i + 1 >= argc)
+            {
+                printUsage(argv[0]);
+                return false;
+            }
+
+            const char *value = argv[++i];
+
+            if (name == "--database")
+            {
+                options.database = value;
+            }
+            else if (name == "--count")
+            {
+                options.count = atoll(value);
+            }
+            else if (name == "--hours")
+            {
+                options.hours = strtod(value, nullptr);
+            }
+            else if (name == "--default-percent")
+            {
+                options.defaultPercent = strtod(value, nullptr);
+            }
+            else if (name == "--outage-minutes")
+            {
+                options.outageMinutes = strtod(value, nullptr);
+            }
+            else if (name == "--unprocessed-percent")
+            {
+                options.unprocessedPercent = strtod(value, nullptr);
+            }
+            else if (name == "--amount")
+            {
+                options.amountInCents = llround(strtod(value, nullptr) * 100);
+            }
+            else if (name == "--seed")
+            {
+                options.seed = strtoull(value, nullptr, 10);
+            }
+            else if (name == "--measure")
+            {
+                options.measureSeconds = strtod(value, nullptr);
+            }
+            else if (name == "--write-rate")
+            {
+                options.writeRate = strtod(value, nullptr);
+            }
+            else if (name == "--readers")
+            {
+                options.readers = atoi(value);
+            }
+            else
+            {
+                cerr << "Opção inválida: " << name << endl;
+                printUsage(argv[0]);
+                return false;
+            }
+        }
+
+        if (options.count < 0 || options.hours <= 0 || options.defaultPercent < 0 || options.defaultPercent > 100 ||
+            options.outageMinutes < 0 || options.outageMinutes > 60 || options.unprocessedPercent < 0 || options.unprocessedPercent > 100 ||
+            options.amountInCents <= 0 || options.measureSeconds < 0 || options.writeRate < 0 || options.readers <= 0)
+        {
+            cerr << "Opções fora da faixa válida" << endl;
+            printUsage(argv[0]);
+            return false;
+        }
+
+        return true;
+    }
+
+    static void printUsage(const char *program)
+    {
+        cerr << "Uso: " << program << " [opções]\n"
+             << "  --database <arquivo>          banco de pagamentos (padrão " << Constants::DATABASE_PAYMENTS << ")\n"
+             << "  --count <n>                   pagamentos inseridos, 0 só mede (padrão 1000000)\n"
+             << "  --hours <h>                   faixa de tempo até agora em que os pagamentos são distribuídos (padrão 24)\n"
+             << "  --default-percent <p>         % dos pagamentos no 'default' fora das quedas (padrão 85)\n"
+             << "  --outage-minutes <m>          minutos por hora com o 'default' fora do ar (padrão 3)\n"
+             << "  --unprocessed-percent <p>     % dos pagamentos não processados (padrão 1)\n"
+             << "  --amount <valor>              amount dos pagamentos (padrão 19.90)\n"
+             << "  --seed <n>                    semente do sorteio (padrão 42)\n"
+             << "  --measure <s>                 segundos de medição do resumo com escrita concorrente, 0 não mede (padrão 0)\n"
+             << "  --write-rate <req/s>          pagamentos gravados por segundo durante a medição (padrão 1000)\n"
+             << "  --readers <n>                 threads consultando o resumo durante a medição (padrão " << Constants::READ_POOL_SIZE << ")\n";
+    }
+};
+
+/**
+ * @brief Quantidade e valor (em centavos) dos pagamentos processados por serviço, para conferir o resumo.
+ */
+struct SeedTotals
+{
+    int64_t defaultRecords = 0;
+    int64_t defaultAmountInCents = 0;
+    int64_t fallbackRecords = 0;
+    int64_t fallbackAmountInCents = 0;
+};
+
+/**
+ * @brief Sorteia o serviço e o status dos pagamentos sintéticos.
+ *
+ * Em cada hora o 'default' fica fora do ar durante outageMinutes minutos, começando em um segundo sorteado.
+ */
+class PaymentsMix
+{
+public:
+    PaymentsMix(const SeedOptions &options, uint64_t seed) : options(options), random(seed) {}
+
+    /**
+     * @brief Preenche os flags de um pagamento feito em epochMillis.
+     */
+    void assign(Payment &payment, int64_t epochMillis)
+    {
+        int64_t hour = epochMillis / 3600000;
+
+        if (hour != currentHour)
+        {
+            currentHour = hour;
+
+            int64_t outageMillis = static_cast<int64_t>(options.outageMinutes * 60000);
+            outageStart = hour * 3600000 + uniform_int_distribution<int64_t>(0, max<int64_t>(3600000 - outageMillis, 0))(random);
+            outageEnd = outageStart + outageMillis;
+        }
+
+        bool defaultService = (epochMillis < outageStart || epochMillis >= outageEnd) && percent(random) < options.defaultPercent;
+        bool processed = percent(random) >= options.unprocessedPercent;
+
+        payment.setFlags(defaultService, processed);
+    }
+
+    mt19937_64 &getRandom()
+    {
+        return random;
+    }
+
+private:
+    const SeedOptions &options;
+    mt19937_64 random;
+    uniform_real_distribution<double> percent{0, 100};
+    int64_t currentHour = -1;
+    int64_t outageStart = 0;
+    int64_t outageEnd = 0;
+};
+
+/**
+ * @brief Insere os pagamentos sintéticos em lotes, com as partições e os rollups, como a thread de escrita do servidor.
+ */
+class PaymentsSeeder
+{
+public:
+    /**
+     * @brief Insere options.count pagamentos em [from, to) e acumula os processados em totals.
+     *
+     * @return bool False se algum lote falhou.
+     */
+    static bool seed(const SeedOptions &options, sqlite3 *database, int64_t from, int64_t to, SeedTotals &totals)
+    {
+        // A carga inicial pode perder os últimos lotes se a máquina cair: não espera o fsync a cada commit
+        sqlite3_exec(database, "PRAGMA synchronous = OFF", nullptr, nullptr, nullptr);
+
+        PaymentsMix mix(options, options.seed);
+        uniform_int_distribution<int64_t> millisecond(0, 999);
+
+        int64_t firstSecond = from / 1000;
+        int64_t lastSecond = (to - 1) / 1000;
+
+        double totalWeight = 0;
+
+        for (int64_t second = firstSecond; second <= lastSecond; second++)
+        {
+            totalWeight += trafficWeight(second);
+        }
+
+        set<int64_t> knownPartitions;
+        map<pair<int64_t, bool>, PaymentsRollup> rollups;
+        Payment payment{};
+        payment.amountInCents = options.amountInCents;
+
+        int64_t inserted = 0;
+        int64_t batchRecords = 0;
+        int64_t nextProgress = options.count / 10;
+        double expected = 0;
+        bool success = true;
+
+        auto start = chrono::steady_clock::now();
+
+        sqlite3_exec(database, "BEGIN", nullptr, nullptr, nullptr);
+
+        for (int64_t second = firstSecond; second <= lastSecond && inserted < options.count; second++)
+        {
+            // A parte fracionária passa para o segundo seguinte, então a soma fecha em options.count
+            expected += options.count * trafficWeight(second) / totalWeight;
+
+            int64_t records = second == lastSecond ? options.count - inserted : min<int64_t>(llround(expected) - inserted, options.count - inserted);
+
+            for (int64_t i = 0; i < records; i++)
+            {
+                payment.requestedAt = clamp(second * 1000 + millisecond(mix.getRandom()), from, to - 1);
+
+                UUIDGenerator::createUUID(payment.correlationId, payment.requestedAt);
+                mix.assign(payment, payment.requestedAt);
+
+                PaymentsPartition partition = PaymentsUtils::getPartition(payment.requestedAt);
+
+                if (knownPartitions.count(partition.id) == 0 && PaymentsUtils::createPartition(database, partition))
+                {
+                    knownPartitions.insert(partition.id);
+                }
+
+                success &= PaymentsUtils::insert(database, payment, payment.isDefaultService(), payment.isProcessed());
+
+                if (payment.isProcessed())
+                {
+                    PaymentsRollup &rollup = rollups[{payment.requestedAt / 1000, payment.isDefaultService()}];
+                    rollup.records++;
+                    rollup.amountInCents += payment.amountInCents;
+
+                    (payment.isDefaultService() ? totals.defaultRecords : totals.fallbackRecords)++;
+                    (payment.isDefaultService() ? totals.defaultAmountInCents : totals.fallbackAmountInCents) += payment.amountInCents;
+                }
+
+                inserted++;
+
+                if (++batchRecords == BATCH_SIZE)
+                {
+                    success &= commit(database, rollups);
+                    batchRecords = 0;
+
+                    sqlite3_exec(database, "BEGIN", nullptr, nullptr, nullptr);
+                }
+
+                if (inserted == nextProgress)
+                {
+                    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+                    cout << "  " << inserted << " pagamentos (" << static_cast<int64_t>(inserted / elapsed) << "/s)" << endl;
+
+                    nextProgress += options.count / 10;
+                }
+            }
+        }
+
+        success &= commit(database, rollups);
+
+        double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        cout << fixed << setprecision(1)
+             << "Inseridos " << inserted << " pagamentos em " << knownPartitions.size() << " partições em " << elapsed << " s ("
+             << static_cast<int64_t>(inserted / max(elapsed, 1e-9)) << "/s)" << endl;
+
+        sqlite3_exec(database, "PRAGMA synchronous = NORMAL", nullptr, nullptr, nullptr);
+
+        return success;
+    }
+
+private:
+    /**
+     * @brief Pagamentos por transação: o mesmo custo de commit amortizado dos lotes grandes do servidor.
+     */
+    static const int64_t BATCH_SIZE = 20000;
+
+    /**
+     * @brief Peso relativo do tráfego em um segundo: curva diária entre 0,4x e 1,6x, com pico às 15h UTC.
+     */
+    static double trafficWeight(int64_t epochSecond)
+    {
+        double hourOfDay = (epochSecond % 86400) / 3600.0;
+
+        return 1.0 + 0.6 * sin(2 * M_PI * (hourOfDay - 9) / 24);
+    }
+
+    static bool commit(sqlite3 *database, map<pair<int64_t, bool>, PaymentsRollup> &rollups)
+    {
+        bool success = PaymentsUtils::upsertRollups(database, rollups) && sqlite3_exec(database, "COMMIT", nullptr, nullptr, nullptr) == SQLITE_OK;
+
+        if (!success)
+        {
+            LOGGER::error("Erro ao fazer commit do lote de pagamentos: ", sqlite3_errmsg(database));
+
+            sqlite3_exec(database, "ROLLBACK", nullptr, nullptr, nullptr);
+        }
+
+        rollups.clear();
+
+        return success;
+    }
+};
+
+/**
+ * @brief Janelas do resumo medidas.
+ */
+enum class SummaryWindow
+{
+    NARROW,
+    MEDIUM,
+    FULL,
+    COUNT
+};
+
+/**
+ * @brief Mede o getSummary em cada janela enquanto pagamentos novos são gravados pelo PaymentsDatabaseWriter.
+ */
+class SummaryBenchmark
+{
+public:
+    static void run(const SeedOptions &options, PaymentsDatabaseWriter &writer, SQLiteConnectionPoolUtils &readPool, int64_t from)
+    {
+        static const size_t WINDOWS = static_cast<size_t>(SummaryWindow::COUNT);
+
+        array<LatencyHistogram, WINDOWS> latencies;
+        array<atomic<uint64_t>, WINDOWS> maxLatencies{};
+        atomic<bool> running{true};
+        atomic<int64_t> written{0};
+
+        auto start = chrono::steady_clock::now();
+        auto deadline = start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(options.measureSeconds));
+
+        // Produtor em taxa constante: o pagamento i é gravado no horário start + i / rate
+        thread producer([&]()
+                        {
+                            if (options.writeRate <= 0)
+                            {
+                                return;
+                            }
+
+                            PaymentsMix mix(options, options.seed + 1);
+                            Payment payment{};
+                            payment.amountInCents = options.amountInCents;
+
+                            for (int64_t i = 0; running.load(memory_order_relaxed); i++)
+                            {
+                                this_thread::sleep_until(start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(i / options.writeRate)));
+
+                                payment.requestedAt = TimeUtils::getEpochMillisUTC();
+                                UUIDGenerator::createUUID(payment.correlationId, payment.requestedAt);
+                                mix.assign(payment, payment.requestedAt);
+
+                                writer.addPaymentToQueue(payment);
+                                written.fetch_add(1, memory_order_relaxed);
+                            } });
+
+        vector<thread> readers;
+
+        for (int reader = 0; reader < options.readers; reader++)
+        {
+            readers.emplace_back([&, reader]()
+                                 {
+                                     mt19937_64 random(options.seed + 100 + reader);
+
+                                     for (size_t query = reader; running.load(memory_order_relaxed); query++)
+                                     {
+                                         size_t window = query % WINDOWS;
+                                         int64_t to = TimeUtils::getEpochMillisUTC();
+                                         int64_t queryFrom = from;
+                                         int64_t queryTo = to;
+
+                                         // As bordas caem no meio de um segundo: o resumo lê os rollups e as linhas dos dois segundos parciais
+                                         if (window != static_cast<size_t>(SummaryWindow::FULL))
+                                         {
+                                             int64_t length = window == static_cast<size_t>(SummaryWindow::NARROW) ? 10000 : 3600000;
+                                             int64_t latestStart = max(from, to - length);
+
+                                             queryFrom = uniform_int_distribution<int64_t>(from, latestStart)(random);
+                                             queryTo = queryFrom + length;
+                                         }
+
+                                         auto queryStart = chrono::steady_clock::now();
+
+                                         PaymentsSummary summary;
+                                         PaymentsUtils::getSummary(readPool, queryFrom, queryTo, summary);
+
+                                         uint64_t nanoseconds = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - queryStart).count();
+
+                                         latencies[window].record(nanoseconds);
+                                         updateMax(maxLatencies[window], nanoseconds);
+
+                                         if (chrono::steady_clock::now() >= deadline)
+                                         {
+                                             running.store(false);
+                                         }
+                                     } });
+        }
+
+        for (thread &reader : readers)
+        {
+            reader.join();
+        }
+
+        producer.join();
+
+        double elapsedSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+        cout << fixed << setprecision(1)
+             << "Escrita concorrente: " << written.load() << " pagamentos em " << elapsedSeconds << " s ("
+             << written.load() / elapsedSeconds << "/s), " << options.readers << " threads consultando o resumo" << endl;
+
+        cout << endl
+             << left << setw(34) << "getSummary (ms)" << right << setw(9) << "count" << setw(10) << "p50" << setw(10) << "p90"
+             << setw(10) << "p99" << setw(10) << "p99.9" << setw(10) << "max" << endl;
+
+        static constexpr array<const char *, WINDOWS> WINDOW_LABELS = {"janela curta (10 s)", "janela média (1 h)", "faixa inteira"};
+
+        for (size_t window = 0; window < WINDOWS; window++)
+        {
+            cout << left << setw(34) << WINDOW_LABELS[window] << right << setw(9) << latencies[window].getCount() << setprecision(2);
+
+            for (double percentile : {0.5, 0.9, 0.99, 0.999})
+            {
+                cout << setw(10) << latencies[window].getPercentile(percentile) / 1e6;
+            }
+
+            cout << setw(10) << maxLatencies[window].load() / 1e6 << setprecision(1) << endl;
+        }
+    }
+
+private:
+    static void updateMax(atomic<uint64_t> &target, uint64_t value)
+    {
+        uint64_t current = target.load(memory_order_relaxed);
+
+        while (value > current && !target.compare_exchange_weak(current, value, memory_order_relaxed))
+        {
+        }
+    }
+};
+
+int main(int argc, char *argv[])
+{
+    SeedOptions options;
+
+    if (!SeedOptions::parse(argc, argv, options))
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (!SQLiteDatabaseUtils::setUpMultiThreadedMode())
+    {
+        cerr << "SQLite não está funcionando em modo multithead" << endl;
+        return EXIT_FAILURE;
+    }
+
+    filesystem::path parent = filesystem::path(options.database).parent_path();
+
+    if (!parent.empty())
+    {
+        filesystem::create_directories(parent);
+    }
+
+    int64_t to = TimeUtils::getEpochMillisUTC();
+    int64_t from = to - static_cast<int64_t>(options.hours * 3600000);
+
+    SQLiteConnectionPoolUtils writePool("seed-escrita", options.database, 1, Constants::POOL_MAX_QUEUE_SIZE, false);
+
+    sqlite3 *database = writePool.getConnectionFromPool();
+
+    if (database == nullptr)
+    {
+        cerr << "Não foi possível abrir o banco " << options.database << endl;
+        return EXIT_FAILURE;
+    }
+
+    PaymentsUtils::init(database);
+    writePool.returnConnectionToPool(database);
+
+    // O pool somente leitura é criado depois das tabelas (e do modo WAL) existirem
+    SQLiteConnectionPoolUtils readPool("seed-leitura", options.database, options.readers, Constants::POOL_MAX_QUEUE_SIZE, true);
+
+    if (options.count > 0)
+    {
+        cout << "Inserindo " << options.count << " pagamentos de " << TimeUtils::formatTimestampUTC(from)
+             << " a " << TimeUtils::formatTimestampUTC(to) << " em " << options.database << endl;
+
+        // O banco pode já ter pagamentos: a conferência compara a diferença do resumo antes e depois
+        PaymentsSummary before{};
+        PaymentsSummary after{};
+        SeedTotals totals;
+
+        bool seeded = PaymentsUtils::getSummary(readPool, from, to - 1, before);
+
+        database = writePool.getConnectionFromPool();
+
+        if (database != nullptr)
+        {
+            seeded = seeded && PaymentsSeeder::seed(options, database, from, to, totals);
+            writePool.returnConnectionToPool(database);
+        }
+        else
+        {
+            seeded = false;
+        }
+
+        seeded = seeded && PaymentsUtils::getSummary(readPool, from, to - 1, after);
+
+        int64_t defaultRecords = after.defaultStats.totalRequests - before.defaultStats.totalRequests;
+        int64_t fallbackRecords = after.fallbackStats.totalRequests - before.fallbackStats.totalRequests;
+
+        cout << "Processados: default " << totals.defaultRecords << " (" << totals.defaultAmountInCents / 100.0 << "), fallback "
+             << totals.fallbackRecords << " (" << totals.fallbackAmountInCents / 100.0 << ")" << endl;
+
+        if (!seeded || defaultRecords != totals.defaultRecords || fallbackRecords != totals.fallbackRecords)
+        {
+            cerr << "O resumo não confere com os pagamentos inseridos: default " << defaultRecords << ", fallback " << fallbackRecords << endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (options.measureSeconds > 0)
+    {
+        cout << endl;
+
+        PaymentsDatabaseWriter writer(writePool, readPool);
+
+        SummaryBenchmark::run(options, writer, readPool, from);
+    }
+
+    return EXIT_SUCCESS;
+}
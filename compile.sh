@@ -1,7 +1,16 @@
 #!/bin/bash
 
-# Define a variável DEBUG com valor 0, que será usada para determinar se o modo de depuração está ativado ou não.
-DEBUG=0
+# Perfil de compilação: default (-O2), debug (-g), release (-O2 + LTO) ou pgo (release treinado com a carga do gerador).
+PROFILE="default"
+
+# Alvo compilado: server (padrão), tests, benchmark, load_generator, mock_processor ou seed_payments.
+TARGET="server"
+
+# Define a variável BUILD_ONLY com valor 0, que será usada para determinar se o programa compilado deve ser executado.
+BUILD_ONLY=0
+
+# Argumentos repassados para o programa compilado (usado pelos benchmarks e ferramentas).
+PROGRAM_ARGUMENTS=()
 
 # Loop que processa os argumentos passados para o script.
 while [[ $# -gt 0 ]]; do
@@ -9,10 +18,58 @@ while [[ $# -gt 0 ]]; do
     case $1 in
         # Se o argumento for --debug, ativa o modo de depuração.
         --debug)
-            # Altera o valor da variável DEBUG para 1.
-            DEBUG=1
-            # Move para o próximo argumento.
+            PROFILE="debug"
+            shift
+            ;;
+        # Se o argumento for --release, compila com -O2 e link-time optimization, sem os logs de debug / info.
+        --release)
+            PROFILE="release"
+            shift
+            ;;
+        # Se o argumento for --pgo, compila o servidor instrumentado, treina com o gerador de carga e recompila com o perfil.
+        --pgo)
+            PROFILE="pgo"
+            shift
+            ;;
+        # Se o argumento for --build-only, somente compila (usado no Dockerfile).
+        --build-only)
+            BUILD_ONLY=1
+            shift
+            ;;
+        # Se o argumento for --test, compila e executa os testes de corretude; os argumentos seguintes são repassados para eles.
+        --test)
+            TARGET="tests"
             shift
+            PROGRAM_ARGUMENTS=("$@")
+            break
+            ;;
+        # Se o argumento for --benchmark, compila e executa os microbenchmarks; os argumentos seguintes são repassados para eles.
+        --benchmark)
+            TARGET="benchmark"
+            shift
+            PROGRAM_ARGUMENTS=("$@")
+            break
+            ;;
+        # Se o argumento for --load-generator, compila e executa o gerador de carga; os argumentos seguintes são repassados para ele.
+        --load-generator)
+            TARGET="load_generator"
+            shift
+            PROGRAM_ARGUMENTS=("$@")
+            break
+            ;;
+        # Se o argumento for --mock-processor, compila e executa o payment processor local; os argumentos seguintes são repassados para ele.
+        --mock-processor)
+            TARGET="mock_processor"
+            shift
+            PROGRAM_ARGUMENTS=("$@")
+            break
+            ;;
+        # Se o argumento for --seed-payments, compila e executa a carga de pagamentos sintéticos; os argumentos seguintes são repassados para ela.
+        --seed-payments)
+            TARGET="seed_payments"
+            shift
+            PROGRAM_ARGUMENTS=("$@")
+            break
             ;;
             # Se o argumento não for reconhecido, imprime uma mensagem de erro e sai do script.
             *)
@@ -22,35 +79,185 @@ while [[ $# -gt 0 ]]; do
     esac
 done
 
+if [ "$PROFILE" == "pgo" ] && [ "$TARGET" != "server" ]; then
+  echo "O perfil --pgo só se aplica ao servidor"
+  exit 1
+fi
+
 # Define as flags de compilação padrão.
-COMPILER_FLAGS="-std=c++17 -Wall -Wextra"
+BASE_FLAGS="-std=c++17 -Wall -Wextra"
 
-# Verifica se o modo de depuração está ativado.
-if [ $DEBUG -eq 1 ]; then
+# Diretório dos perfis gerados pelo servidor instrumentado (precisa ser absoluto, o treino roda em outro diretório).
+PGO_PROFILE_DIRECTORY="$PWD/build/pgo/profile"
 
-  # Se estiver ativado, adiciona as flags de depuração às flags de compilação.
-  COMPILER_FLAGS+=" -fdiagnostics-color=always -g"
+# Retorna as flags de compilação de um perfil.
+profile_flags() {
+  case $1 in
+    debug)
+      # Adiciona as flags de depuração e compila também os logs de nível debug.
+      echo "$BASE_FLAGS -fdiagnostics-color=always -g -DGARNIZE_LOG_LEVEL=0"
+      ;;
+    release)
+      # -flto=auto: otimiza o programa inteiro no link (inlining entre o servidor e a biblioteca), usando os núcleos disponíveis.
+      # -DGARNIZE_LOG_LEVEL=2: remove em tempo de compilação os logs abaixo do nível de erro (debug / info).
+      echo "$BASE_FLAGS -O2 -flto=auto -DGARNIZE_LOG_LEVEL=2"
+      ;;
+    pgo-training)
+      # -fprofile-update=atomic: os contadores são atualizados por várias threads ao mesmo tempo.
+      # As demais flags precisam ser as mesmas do perfil pgo, para que o código instrumentado case com o perfil.
+      echo "$BASE_FLAGS -O2 -DGARNIZE_LOG_LEVEL=2 -fprofile-generate=$PGO_PROFILE_DIRECTORY -fprofile-update=atomic"
+      ;;
+    pgo)
+      # -fprofile-partial-training: funções que o treino não executou continuam otimizadas como no -O2, e não para tamanho.
+      # -fprofile-correction: tolera contadores levemente inconsistentes.
+      # -Wno-missing-profile: a biblioteca não tem código executado no treino.
+      echo "$BASE_FLAGS -O2 -flto=auto -DGARNIZE_LOG_LEVEL=2 -fprofile-use=$PGO_PROFILE_DIRECTORY -fprofile-partial-training -fprofile-correction -Wno-missing-profile"
+      ;;
+    *)
+      # Adiciona a flag de otimização às flags de compilação.
+      echo "$BASE_FLAGS -O2"
+      ;;
+  esac
+}
 
-  # Define o nome do executável para incluir "_debug".
-  OUTPUT_NAME="garnize_on_juice_debug"
-else
+# Compila a biblioteca (build/<perfil>/libgarnize.a) com as definições fora das classes.
+# O gcc-ar é necessário para que o índice da biblioteca entenda os objetos com LTO.
+build_library() {
+  local directory=$1
+  local flags=$2
+
+  mkdir -p "$directory" &&
+    g++ -c src/garnize.cpp $flags -o "$directory/garnize.o" &&
+    rm -f "$directory/libgarnize.a" &&
+    gcc-ar rcs "$directory/libgarnize.a" "$directory/garnize.o"
+}
+
+# Compila um alvo (servidor, testes, benchmarks ou ferramentas) e faz o link com a biblioteca do mesmo perfil.
+build_target() {
+  local target=$1
+  local directory=$2
+  local flags=$3
+  local output=$4
+  local source
+  local libraries="-lsqlite3 -lcurl"
+
+  case $target in
+    server)
+      source="src/main.cpp"
+      ;;
+    tests)
+      source="tests/tests.cpp"
+      # A libuuid só é usada como referência de comparação do UUIDGenerator.
+      libraries+=" -luuid -pthread"
+      ;;
+    benchmark)
+      source="benchmark/benchmark.cpp"
+      # A libuuid só é usada como referência de comparação do UUIDGenerator.
+      libraries+=" -luuid"
+      ;;
+    load_generator)
+      source="benchmark/load_generator.cpp"
+      libraries+=" -pthread"
+      ;;
+    mock_processor)
+      source="benchmark/mock_processor.cpp"
+      libraries+=" -pthread"
+      ;;
+    seed_payments)
+      source="benchmark/seed_payments.cpp"
+      libraries+=" -pthread"
+      ;;
+  esac
+
+  build_library "$directory" "$flags" &&
+    g++ -c $source $flags -o "$directory/$target.o" &&
+    g++ "$directory/$target.o" $flags -L"$directory" -lgarnize $libraries -o "$output"
+}
+
+# Espera o servidor aceitar conexões na porta 9999 (até ~10 segundos).
+wait_for_server() {
+  for _ in $(seq 1 100); do
+    if (exec 3<>/dev/tcp/127.0.0.1/9999) 2>/dev/null; then
+      return 0
+    fi
+    sleep 0.1
+  done
+  return 1
+}
+
+# Compila o servidor instrumentado, roda a carga do gerador contra dois payment processors locais
+# (o default falha por alguns segundos, para exercitar o fallback) e grava o perfil em build/pgo/profile.
+train_pgo() {
+  local directory="build/pgo"
+  local tools="build/default"
+  local training="$directory/training"
+
+  # Os objetos do treino e do build final ficam no mesmo caminho: o nome dos perfis (.gcda) é derivado dele.
+  build_target server "$directory" "$(profile_flags pgo-training)" "$directory/garnize_on_juice_training" &&
+    build_target load_generator "$tools" "$(profile_flags default)" "$tools/garnize_on_juice_load_generator" &&
+    build_target mock_processor "$tools" "$(profile_flags default)" "$tools/garnize_on_juice_mock_processor" ||
+    return 1
+
+  rm -rf "$PGO_PROFILE_DIRECTORY" "$training"
+  mkdir -p "$PGO_PROFILE_DIRECTORY" "$training/database"
+
+  "$tools/garnize_on_juice_mock_processor" --port 8001 --latency uniform:1,10 --phase 4-7:fail > "$training/default.log" 2>&1 &
+  local default_pid=$!
+  "$tools/garnize_on_juice_mock_processor" --port 8002 --latency uniform:5,20 > "$training/fallback.log" 2>&1 &
+  local fallback_pid=$!
 
-  # Se não estiver ativado, adiciona a flag de otimização às flags de compilação.
-  COMPILER_FLAGS+=" -O2"
+  # O servidor usa o diretório database/ relativo ao diretório corrente.
+  (cd "$training" && PROCESSOR_DEFAULT=http://127.0.0.1:8001 PROCESSOR_FALLBACK=http://127.0.0.1:8002 exec ../garnize_on_juice_training > server.log 2>&1) &
+  local server_pid=$!
 
-  # Define o nome do executável padrão.
-  OUTPUT_NAME="garnize_on_juice"
+  local trained=1
+  if wait_for_server; then
+    "$tools/garnize_on_juice_load_generator" --rate 1000 --duration 15 --connections 32 --summary-percent 5 && trained=0
+  else
+    echo "O servidor instrumentado não iniciou, veja $training/server.log"
+  fi
+
+  # O SIGTERM faz o servidor gravar o perfil antes de sair.
+  kill -TERM $server_pid 2>/dev/null
+  wait $server_pid 2>/dev/null
+  kill $default_pid $fallback_pid 2>/dev/null
+  wait $default_pid $fallback_pid 2>/dev/null
+
+  return $trained
+}
+
+# Diretório dos objetos e da biblioteca do perfil.
+BUILD_DIRECTORY="build/$PROFILE"
+
+# Define o nome do executável: o servidor mantém os nomes de sempre, os demais alvos ganham um sufixo.
+if [ "$TARGET" == "server" ]; then
+  if [ "$PROFILE" == "debug" ]; then
+    OUTPUT_NAME="garnize_on_juice_debug"
+  else
+    OUTPUT_NAME="garnize_on_juice"
+  fi
+else
+  OUTPUT_NAME="garnize_on_juice_$TARGET"
 fi
 
-# Compila o código C++ usando as flags de compilação definidas.
-g++ src/main.cpp $COMPILER_FLAGS -o $OUTPUT_NAME -lsqlite3 -lcurl -luuid
+if [ "$PROFILE" == "pgo" ]; then
+  if ! train_pgo; then
+    echo "Erro ao treinar o perfil do PGO"
+    exit 1
+  fi
+fi
+
+# Compila o alvo usando as flags de compilação do perfil.
+build_target "$TARGET" "$BUILD_DIRECTORY" "$(profile_flags $PROFILE)" "$OUTPUT_NAME"
 
 # Verifica se a compilação foi bem-sucedida.
-if [ $? -eq 0 ]; then
-  # Se foi bem-sucedida, executa o programa.
-  ./$OUTPUT_NAME
-else
+if [ $? -ne 0 ]; then
   # Se não foi bem-sucedida, imprime uma mensagem de erro e sai do script.
   echo "Erro ao compilar"
   exit 1
 fi
+
+# Se foi bem-sucedida, executa o programa.
+if [ $BUILD_ONLY -eq 0 ]; then
+  ./$OUTPUT_NAME "${PROGRAM_ARGUMENTS[@]}"
+fi
@@ -0,0 +1,76 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file common.h
+ * @brief Cabeçalhos da biblioteca padrão e do sistema usados por todas as classes do servidor.
+ */
+
+#ifndef GARNIZE_COMMON_H
+#define GARNIZE_COMMON_H
+
+#include <iostream>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <memory_resource>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <set>
+#include <vector>
+#include <array>
+#include <charconv>
+#include <limits>
+#include <thread>
+#include <queue>
+#include <mutex>
+#include <csignal>
+#include <condition_variable>
+#include <future>
+#include <functional>
+#include <atomic>
+#include <deque>
+#include <algorithm>
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+#include <sys/eventfd.h>
+#include <sys/un.h>
+#include <poll.h>
+#include <netinet/in.h>
+#include <curl/curl.h>
+#include <sys/random.h>
+#include <unistd.h>
+#include <sqlite3.h>
+
+using namespace std;
+
+#endif // GARNIZE_COMMON_H
@@ -0,0 +1,332 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file config.h
+ * @brief Parâmetros de desempenho configuráveis em tempo de execução (Config).
+ */
+
+#ifndef GARNIZE_CONFIG_H
+#define GARNIZE_CONFIG_H
+
+#include "common.h"
+#include "constants.h"
+#include "logger.h"
+
+/**
+ * @brief Parâmetros de desempenho configuráveis (o valor padrão de cada um está em Constants).
+ */
+enum class ConfigKey : uint8_t
+{
+    PORT,
+    LISTEN_BACKLOG,
+    WRITE_POOL_SIZE,
+    READ_POOL_SIZE,
+    POOL_MAX_QUEUE_SIZE,
+    WRITER_QUEUE_CAPACITY,
+    SQLITE_BUSY_TIMEOUT_MS,
+    BUFFER_SIZE,
+    CURL_TIMEOUT_MS,
+    HEALTH_CHECK_INTERVAL_MS,
+    PEER_DEADLINE_MS,
+    COUNT
+};
+
+/**
+ * @brief Um parâmetro configurável: nomes, faixa válida e valor efetivo.
+ */
+struct ConfigParameter
+{
+    /**
+     * @brief Nome no JSON e na query string do /admin/config.
+     */
+    const char *name;
+
+    /**
+     * @brief Variável de ambiente.
+     */
+    const char *environment;
+
+    /**
+     * @brief Flag da linha de comando.
+     */
+    const char *flag;
+
+    int64_t defaultValue;
+    int64_t minValue;
+    int64_t maxValue;
+
+    /**
+     * @brief Se pode ser alterado com o servidor rodando (POST /admin/config). Os demais são lidos só na inicialização.
+     */
+    bool live;
+
+    /**
+     * @brief Valor efetivo, lido pelas threads das requests.
+     */
+    atomic<int64_t> value;
+
+    /**
+     * @brief De onde veio o valor efetivo: "padrão", "ambiente", "flag" ou "admin".
+     */
+    atomic<const char *> source;
+};
+
+/**
+ * @class Config
+ * @brief Classe utilitária com os parâmetros de desempenho configuráveis por variável de ambiente e flag.
+ *
+ * A ordem de precedência é flag > variável de ambiente > padrão (Constants). Os valores são validados
+ * na inicialização: um valor inválido ou fora da faixa impede o servidor de subir. Os parâmetros "live"
+ * podem ser alterados em execução pelo POST /admin/config e são lidos a cada uso (load relaxed).
+ */
+class Config
+{
+public:
+    /**
+     * @brief Retorna o valor efetivo de um parâmetro.
+     */
+    static int64_t get(ConfigKey key)
+    {
+        return parameters[static_cast<size_t>(key)].value.load(memory_order_relaxed);
+    }
+
+    /**
+     * @brief Lê as variáveis de ambiente e as flags ("--nome valor") e valida os valores.
+     *
+     * @return bool False se alguma variável ou flag for inválida, desconhecida ou estiver fora da faixa.
+     */
+    static bool load(int argc, char *argv[])
+    {
+        bool valid = true;
+
+        for (ConfigParameter &parameter : parameters)
+        {
+            const char *value = getenv(parameter.environment);
+
+            if (value != nullptr)
+            {
+                valid &= assign(parameter, value, "ambiente", parameter.environment);
+            }
+        }
+
+        for (int i = 1; i < argc; i++)
+        {
+            string_view flag = argv[i];
+            ConfigParameter *parameter = find(flag, &ConfigParameter::flag);
+
+            if (parameter == nullptr || i + 1 >= argc)
+            {
+                if (flag != "--help")
+                {
+                    LOGGER::error("Flag inválida: ", flag);
+                    LOGGER::flush();
+                }
+
+                printUsage(argv[0]);
+
+                return false;
+            }
+
+            valid &= assign(*parameter, argv[++i], "flag", parameter->flag);
+        }
+
+        return valid;
+    }
+
+    /**
+     * @brief Imprime no stderr a configuração efetiva (valor e origem de cada parâmetro).
+     *
+     * Usa o cerr e não o LOGGER::info, que é removido na compilação dos builds release e pgo (GARNIZE_LOG_LEVEL=2):
+     * justamente neles a configuração usada precisa aparecer.
+     */
+    static void logEffective()
+    {
+        for (const ConfigParameter &parameter : parameters)
+        {
+            cerr << "Config " << parameter.name << " = " << parameter.value.load() << " (" << parameter.source.load() << (parameter.live ? ", live)" : ")") << '\n';
+        }
+
+        cerr.flush();
+    }
+
+    /**
+     * @brief Escreve a configuração efetiva em JSON (GET /admin/config).
+     *
+     * @param output O buffer de saída.
+     */
+    static void render(pmr::string &output)
+    {
+        output.append("[");
+
+        for (const ConfigParameter &parameter : parameters)
+        {
+            output.append(&parameter == &parameters.front() ? "" : ",")
+                .append("{\"name\":\"")
+                .append(parameter.name)
+                .append("\",\"value\":")
+                .append(to_string(parameter.value.load()))
+                .append(",\"default\":")
+                .append(to_string(parameter.defaultValue))
+                .append(",\"min\":")
+                .append(to_string(parameter.minValue))
+                .append(",\"max\":")
+                .append(to_string(parameter.maxValue))
+                .append(",\"live\":")
+                .append(parameter.live ? "true" : "false")
+                .append(",\"source\":\"")
+                .append(parameter.source.load())
+                .append("\"}");
+        }
+
+        output.append("]");
+    }
+
+    /**
+     * @brief Altera parâmetros "live" a partir da query string (nome=valor&nome=valor), tudo ou nada.
+     *
+     * @param query A query string do POST /admin/config.
+     * @param error Recebe o motivo se a alteração for recusada.
+     * @return bool True se todos os parâmetros foram alterados, false se nenhum foi.
+     */
+    static bool update(string_view query, string &error)
+    {
+        vector<pair<ConfigParameter *, int64_t>> changes;
+
+        while (!query.empty())
+        {
+            size_t end = query.find('&');
+            string_view param = query.substr(0, end);
+            size_t equals = param.find('=');
+
+            query = end == string_view::npos ? string_view() : query.substr(end + 1);
+
+            if (param.empty())
+            {
+                continue;
+            }
+
+            string_view name = param.substr(0, equals);
+            ConfigParameter *parameter = find(name, &ConfigParameter::name);
+            int64_t value;
+
+            if (parameter == nullptr)
+            {
+                // O nome não é ecoado na resposta: pode ter caracteres que precisariam de escape no JSON
+                error = "Parâmetro desconhecido (veja GET /admin/config)";
+                return false;
+            }
+
+            if (!parameter->live)
+            {
+                error = "O parâmetro " + string(name) + " só pode ser alterado reiniciando o servidor";
+                return false;
+            }
+
+            if (equals == string_view::npos || !parse(param.substr(equals + 1), value) || value < parameter->minValue || value > parameter->maxValue)
+            {
+                error = "Valor inválido para " + string(name) + " (faixa " + to_string(parameter->minValue) + " - " + to_string(parameter->maxValue) + ")";
+                return false;
+            }
+
+            changes.emplace_back(parameter, value);
+        }
+
+        if (changes.empty())
+        {
+            error = "Nenhum parâmetro informado";
+            return false;
+        }
+
+        for (const auto &[parameter, value] : changes)
+        {
+            LOGGER::info("Config ", parameter->name, ": ", parameter->value.load(), " -> ", value);
+
+            parameter->value.store(value, memory_order_relaxed);
+            parameter->source.store("admin", memory_order_relaxed);
+        }
+
+        return true;
+    }
+
+private:
+    /**
+     * @brief Parâmetros, na ordem de ConfigKey (definidos em garnize.cpp).
+     */
+    static array<ConfigParameter, static_cast<size_t>(ConfigKey::COUNT)> parameters;
+
+    static ConfigParameter *find(string_view name, const char *ConfigParameter::*field)
+    {
+        for (ConfigParameter &parameter : parameters)
+        {
+            if (name == parameter.*field)
+            {
+                return &parameter;
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Converte um inteiro decimal (a string inteira, sem espaços nem sinal de '+').
+     */
+    static bool parse(string_view text, int64_t &value)
+    {
+        auto [end, error] = from_chars(text.data(), text.data() + text.size(), value);
+
+        return !text.empty() && error == errc() && end == text.data() + text.size();
+    }
+
+    static bool assign(ConfigParameter &parameter, string_view text, const char *source, const char *origin)
+    {
+        int64_t value;
+
+        if (!parse(text, value) || value < parameter.minValue || value > parameter.maxValue)
+        {
+            LOGGER::error("Valor inválido em ", origin, ": '", text, "' (faixa ", parameter.minValue, " - ", parameter.maxValue, ")");
+
+            return false;
+        }
+
+        parameter.value.store(value, memory_order_relaxed);
+        parameter.source.store(source, memory_order_relaxed);
+
+        return true;
+    }
+
+    static void printUsage(const char *program)
+    {
+        cerr << "Uso: " << program << " [opções]\n";
+
+        for (const ConfigParameter &parameter : parameters)
+        {
+            cerr << "  " << left << setw(30) << (string(parameter.flag) + " <n>") << setw(34) << parameter.environment
+                 << "padrão " << parameter.defaultValue << ", faixa " << parameter.minValue << " - " << parameter.maxValue
+                 << (parameter.live ? ", live" : "") << "\n";
+        }
+    }
+};
+
+#endif // GARNIZE_CONFIG_H
@@ -0,0 +1,335 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file constants.h
+ * @brief Constantes globais do servidor (portas, caminhos, tamanhos de buffers e pools).
+ */
+
+#ifndef GARNIZE_CONSTANTS_H
+#define GARNIZE_CONSTANTS_H
+
+#include "common.h"
+
+/**
+ * @brief Classe que armazena constantes globais.
+ */
+class Constants
+{
+public:
+    /**
+     * @brief Porta padrão para o servidor.
+     */
+    inline static const uint16_t PORT = 9999;
+
+    /**
+     * @brief Tamanho padrão da fila de conexões pendentes do listen().
+     */
+    inline static const uint16_t LISTEN_BACKLOG = 3;
+
+    /**
+     * @brief Intervalo padrão entre os health checks dos payment processors.
+     */
+    inline static const uint16_t HEALTH_CHECK_INTERVAL_MS = 5000;
+
+    /**
+     * @brief Tamanho do buffer para leitura de dados em bytes.
+     *
+     * Essa constante define o tamanho do buffer usado para ler dados de uma conexão de rede.
+     * O valor é de 256 bytes.
+     */
+    inline static const uint16_t BUFFER_SIZE = 256;
+
+    /**
+     * @brief Timeout das requisições cURL.
+     */
+    inline static const uint16_t CURL_TIMEOUT_MS = 7000L;
+
+    /**
+     * @brief Timeout do sqlite3 para evitar erro de database is locked.
+     */
+    inline static const uint16_t SQLITE_BUSY_TIMEOUT_MS = 2000;
+
+    /**
+     * @brief Quantidade de conexões abertas no pool de escrita do banco de pagamentos.
+     */
+    inline static const uint16_t WRITE_POOL_SIZE = 2;
+
+    /**
+     * @brief Quantidade de conexões (somente leitura) abertas no pool de leitura usado pelo /payments-summary.
+     */
+    inline static const uint16_t READ_POOL_SIZE = 4;
+
+    /**
+     * @brief Quantidade máxima de conexões em uso em cada pool antes de as threads precisarem esperar.
+     */
+    inline static const uint16_t POOL_MAX_QUEUE_SIZE = 5000;
+
+    /**
+     * @brief Tamanho da janela de tempo de cada partição da tabela de pagamentos (1 hora).
+     */
+    inline static const int64_t PAYMENTS_PARTITION_MS = 3600000;
+
+    /**
+     * @brief Capacidade do ring buffer de pagamentos do PaymentsDatabaseWriter.
+     *
+     * Deve ser uma potência de 2. Quando o buffer está cheio as threads produtoras
+     * aguardam (backpressure) até que a thread de escrita libere espaço.
+     */
+    inline static const uint32_t WRITER_QUEUE_CAPACITY = 16384;
+
+    /**
+     * @brief Quantidade máxima de pagamentos por transação da thread de escrita.
+     *
+     * Limita o tempo de cada transação sob carga contínua: o WAL não cresce sem limite, os leitores
+     * veem os pagamentos a cada commit e as tarefas de manutenção (purge, partições) rodam entre os lotes.
+     */
+    inline static const uint32_t WRITER_BATCH_MAX = 4096;
+
+    /**
+     * @brief Espera da thread de escrita antes de tentar de novo quando o pool não entrega uma conexão.
+     */
+    inline static const uint32_t WRITER_RETRY_DELAY_MS = 100;
+
+    /**
+     * @brief Diretório onde os pagamentos excedentes do PaymentsDatabaseWriter são gravados (spill).
+     */
+    inline static const string WRITER_SPILL_DIRECTORY = "database/spill";
+
+    /**
+     * @brief Quantidade de pagamentos por arquivo de segmento do spill.
+     */
+    inline static const uint32_t WRITER_SPILL_SEGMENT_RECORDS = 4096;
+
+    /**
+     * @brief Tamanho em bytes do buffer inicial da arena de memória de cada request.
+     *
+     * As strings que vivem somente durante a request (payload, respostas cURL) são alocadas nessa arena,
+     * que fica na stack da thread da request. Se o buffer acabar, a arena passa a usar o heap.
+     */
+    inline static const uint16_t REQUEST_ARENA_SIZE = 4096;
+
+    /**
+     * @brief Quantidade de mensagens que o LOGGER mantém no ring buffer até a thread de fundo escrevê-las.
+     */
+    inline static const uint32_t LOG_QUEUE_CAPACITY = 8192;
+
+    /**
+     * @brief Tamanho máximo de uma mensagem de log (o excedente é truncado).
+     */
+    inline static const uint16_t LOG_MESSAGE_MAX_SIZE = 500;
+
+    /**
+     * @brief Tamanho do lote (bytes por stream) escrito pela thread de log em um único write.
+     */
+    inline static const uint32_t LOG_BATCH_SIZE = 65536;
+
+    /**
+     * @brief Intervalo da thread de log quando não há mensagens pendentes.
+     */
+    inline static const uint16_t LOG_FLUSH_INTERVAL_MS = 2;
+
+    /**
+     * @brief Quantidade de buffers de trace (um por thread ativa; as threads excedentes não registram spans).
+     */
+    inline static const uint16_t TRACE_THREAD_BUFFERS = 64;
+
+    /**
+     * @brief Quantidade de spans mantidos por buffer de trace (os mais antigos são sobrescritos).
+     */
+    inline static const uint16_t TRACE_EVENTS_PER_THREAD = 1024;
+
+    /**
+     * @brief Nome do arquivo de banco de dados SQLite para salvar pagamentos.
+     */
+    inline static const string DATABASE_PAYMENTS = "database/garnize-payments.sqlite";
+
+    /**
+     * @brief Nome do arquivo de banco de dados SQLite para manter os dados de health check.
+     */
+    inline static const string DATABASE_HEALTH_CHECK = "database/garnize-health-check.sqlite";
+
+    /**
+     * @brief Resposta HTTP padrão para requisições inválidas (400 Bad Request).
+     */
+    inline static const string BAD_REQUEST_RESPONSE = "HTTP/1.1 400 Bad Request";
+
+    /**
+     * @brief Resposta HTTP padrão erro interno do servidor (500 Bad Request).
+     */
+    inline static const string INTERNAL_SERVER_ERROR = "HTTP/1.1 500 Internal Server Error";
+
+    /**
+     * @brief Resposta HTTP padrão para recursos não encontrados (404 Not Found).
+     */
+    inline static const string NOT_FOUND_RESPONSE = "HTTP/1.1 404 Not Found";
+
+    /**
+     * @brief Resposta HTTP para quando não há conexão disponível com o banco (503 Service Unavailable).
+     */
+    inline static const string SERVICE_UNAVAILABLE_RESPONSE = "HTTP/1.1 503 Service Unavailable";
+
+    /**
+     * @brief Resposta HTTP padrão para recursos criados com sucesso (201 Created).
+     */
+    inline static const string CREATED_RESPONSE = "HTTP/1.1 201 Created";
+
+    /**
+     * @brief Resposta HTTP padrão para requisições bem-sucedidas (200 OK).
+     */
+    inline static const string OK_RESPONSE = "HTTP/1.1 200 OK";
+
+    /**
+     * @brief Cabeçalho Content-Type para respostas JSON.
+     *
+     * Inclui o tipo de conteúdo e o campo para especificar o tamanho do corpo da resposta.
+     */
+    inline static const string CONTENT_TYPE_APPLICATION_JSON = "\r\nContent-Type: application/json\r\nContent-Length: ";
+
+    /**
+     * @brief Cabeçalho Content-Type para o formato texto do Prometheus (GET /metrics).
+     */
+    inline static const string CONTENT_TYPE_PROMETHEUS = "\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: ";
+
+    /**
+     * @brief Mensagem de erro para requisição inválida.
+     */
+    inline static const string INVALID_REQUEST_MSG = "Requisição inválida";
+
+    /**
+     * @brief Chave para o ID de correlação em uma requisição.
+     *
+     * Essa constante define a chave padrão para o campo "correlationId" em uma requisição.
+     */
+    inline static const string KEY_CORRELATION_ID = "correlationId";
+
+    /**
+     * @brief Chave para o valor do amount em uma requisição.
+     *
+     * Essa constante define a chave padrão para o campo "amount" em uma requisição.
+     */
+    inline static const string KEY_AMOUNT = "amount";
+
+    /**
+     * @brief URL padrão do processador de pagamentos.
+     *
+     * Essa URL é usada como padrão quando não há outra configuração específica.
+     */
+    inline static const string PROCESSOR_DEFAULT = getenv("PROCESSOR_DEFAULT") != nullptr ? getenv("PROCESSOR_DEFAULT") : "";
+    // inline static const string PROCESSOR_DEFAULT = "http://localhost:8001";
+
+    /**
+     * @brief URL de fallback do processador de pagamentos.
+     *
+     * Essa URL é usada como fallback quando o processador de pagamentos padrão não está disponível.
+     */
+    inline static const string PROCESSOR_FALLBACK = getenv("PROCESSOR_FALLBACK") != nullptr ? getenv("PROCESSOR_FALLBACK") : "";
+    // inline static const string PROCESSOR_FALLBACK = "http://localhost:8002";
+
+    /**
+     * @brief Diretório compartilhado entre as instâncias para os Unix sockets de resumo entre peers.
+     *
+     * Cada instância cria o socket "<hostname>-<pid>.sock" nesse diretório e consulta os demais sockets
+     * encontrados nele ao montar o /payments-summary local. Vazio (variável não definida) desativa o recurso.
+     */
+    inline static const string PEER_SOCKET_DIRECTORY = getenv("PEER_SOCKET_DIRECTORY") != nullptr ? getenv("PEER_SOCKET_DIRECTORY") : "";
+
+    /**
+     * @brief Prazo máximo em milissegundos para receber o resumo de todos os peers, contado a partir do fim do resumo local.
+     *
+     * Peers que não responderem dentro do prazo são ignorados no resumo.
+     */
+    inline static const uint16_t PEER_DEADLINE_MS = 150;
+
+    /**
+     * @brief Endpoint para operações de pagamento.
+     *
+     * Essa constante define o caminho base para operações de pagamento "/payments".
+     */
+    inline static const string PAYMENTS_ENDPOINT = "/payments";
+
+    /**
+     * @brief Endpoint para resumo de pagamentos.
+     *
+     * Essa constante define o caminho para obter um resumo de pagamentos "/payments-summary".
+     */
+    inline static const string PAYMENTS_SUMMARY_ENDPOINT = "/payments-summary";
+
+    /**
+     * @brief Endpoint para limpar pagamentos.
+     *
+     * Essa constante define o caminho para limpar o banco sqlite "/purge-payments".
+     */
+    inline static const string PURGE_PAYMENTS_ENDPOINT = "/purge-payments";
+
+    /**
+     * @brief Endpoint para resumo de pagamentos para administradores.
+     *
+     * Essa constante define o caminho para obter um resumo de pagamentos com acesso de administrador "/admin/payments-summary".
+     */
+    inline static const string PAYMENTS_SUMMARY_ADMIN_ENDPOINT = "/admin/payments-summary";
+
+    /**
+     * @brief Endpoint administrativo com o layout das partições da tabela de pagamentos "/admin/partitions".
+     */
+    inline static const string PARTITIONS_ADMIN_ENDPOINT = "/admin/partitions";
+
+    /**
+     * @brief Endpoint administrativo para remover as partições antigas "/admin/partitions/drop?before=<data>".
+     */
+    inline static const string DROP_PARTITIONS_ADMIN_ENDPOINT = "/admin/partitions/drop";
+
+    /**
+     * @brief Endpoint com as métricas no formato texto do Prometheus.
+     */
+    inline static const string METRICS_ENDPOINT = "/metrics";
+
+    /**
+     * @brief Endpoint que exporta os spans recentes no formato trace_event do Chrome (chrome://tracing / Perfetto).
+     */
+    inline static const string TRACE_ADMIN_ENDPOINT = "/admin/trace";
+
+    /**
+     * @brief Endpoint com a configuração efetiva (GET) e a alteração dos parâmetros "live" (POST).
+     */
+    inline static const string CONFIG_ADMIN_ENDPOINT = "/admin/config";
+
+    /**
+     * @brief Caminho padrão para o health check do processo.
+     *
+     * Essa constante define o caminho padrão que é usado para verificar a saúde do processo.
+     * O valor padrão é "/payments/service-health".
+     */
+    inline static const string HEALTH_CHECK_ENDPOINT = "/payments/service-health";
+
+    /**
+     * @brief Header de autenticação para a Rinha.
+     *
+     * Essa constante define o valor do header de autenticação X-Rinha-Token,
+     * que é usado para autenticar requisições na Rinha.
+     */
+    inline static const string X_RINHA_TOKEN = "X-Rinha-Token: 123";
+};
+
+#endif // GARNIZE_CONSTANTS_H
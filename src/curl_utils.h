@@ -0,0 +1,187 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file curl_utils.h
+ * @brief Chamadas cURL aos payment processors com métricas e spans (CURLUtils).
+ */
+
+#ifndef GARNIZE_CURL_UTILS_H
+#define GARNIZE_CURL_UTILS_H
+
+#include "common.h"
+#include "constants.h"
+#include "config.h"
+#include "metrics.h"
+#include "tracer.h"
+
+/**
+ * @brief Classe utilitária para fazer cURL requests.
+ *
+ */
+class CURLUtils
+{
+public:
+    /**
+     * @brief Função de callback para escrever dados recebidos do libcurl.
+     *
+     * Essa função é chamada pelo libcurl para escrever dados recebidos em uma string.
+     *
+     * @param contents Ponteiro para os dados recebidos.
+     * @param size Tamanho de cada elemento dos dados.
+     * @param nmemb Número de elementos dos dados.
+     * @param userp Ponteiro para a string que irá armazenar os dados. Deve ser um ponteiro para um objeto std::pmr::string.
+     *
+     * @return O tamanho total dos dados escritos.
+     *
+     * @note Essa função assume que o ponteiro userp é válido e aponta para um objeto std::pmr::string.
+     */
+    static size_t readCallback(void *contents, size_t size, size_t nmemb, void *userp)
+    {
+        ((pmr::string *)userp)->append((char *)contents, size * nmemb);
+
+        return size * nmemb;
+    }
+
+    /**
+     * @brief Retorna um ponteiro CURL para a URL com timeout de 1500 millisegundos.
+     *
+     * @param URL O endereço que será chamado
+     * @param payload O payload da requisição em formato JSON.
+     * @param responseBuffer O buffer que armazenará a resposta da requisição.
+     * @return CURL * O objeto CURL que foi utilizado para fazer a requisição.
+     */
+    static CURL *setupCurlForPostRequest(const string &URL, string_view payload, pmr::string &responseBuffer)
+    {
+        CURL *curl = curl_easy_init();
+
+        if (curl)
+        {
+            curl_easy_setopt(curl, CURLOPT_URL, URL.c_str());
+            curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+            curl_easy_setopt(curl, CURLOPT_POST, 1L);
+            // Com o tamanho informado o cURL não precisa de '\0' no fim do payload
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(payload.size()));
+            curl_easy_setopt(curl, CURLOPT_POSTFIELDS, payload.data());
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, CURLUtils::readCallback);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBuffer);
+            curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(Config::get(ConfigKey::CURL_TIMEOUT_MS)));
+        }
+
+        return curl;
+    }
+
+    /**
+     * @brief Retorna um ponteiro CURL para a URL com timeout de 7 segundos.
+     *
+     * @param URL O endereço que será chamado
+     * @param responseBuffer O buffer que armazenará a resposta da requisição.
+     * @return CURL * O objeto CURL que foi utilizado para fazer a requisição.
+     */
+    static CURL *setupCurlForGetRequest(const string &URL, pmr::string &responseBuffer)
+    {
+        CURL *curl = curl_easy_init();
+
+        if (curl)
+        {
+            curl_easy_setopt(curl, CURLOPT_URL, URL.c_str());
+            curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L); // Ativa a opção NOSIGNAL
+            curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, CURLUtils::readCallback);
+            curl_easy_setopt(curl, CURLOPT_WRITEDATA, &responseBuffer);
+            curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, static_cast<long>(Config::get(ConfigKey::CURL_TIMEOUT_MS)));
+        }
+
+        return curl;
+    }
+
+    /**
+     * @brief Executa a request para um payment processor e registra a latência no Metrics.
+     *
+     * @param curl O handle configurado.
+     * @param defaultService Se o processor é o 'default' (ou o 'fallback').
+     * @param call A chamada feita.
+     * @return CURLcode O resultado do curl_easy_perform.
+     */
+    static CURLcode perform(CURL *curl, bool defaultService, ProcessorCall call)
+    {
+        static constexpr array<const char *, static_cast<size_t>(ProcessorCall::COUNT)> SPAN_NAMES = {"processor.payments", "processor.payments-summary", "processor.health-check"};
+
+        TraceSpan span(SPAN_NAMES[static_cast<size_t>(call)]);
+
+        auto start = chrono::steady_clock::now();
+
+        CURLcode responseCode = curl_easy_perform(curl);
+
+        uint64_t nanoseconds = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+
+        long HTTP_RESPONSE_CODE = 0;
+
+        if (responseCode == CURLE_OK)
+        {
+            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &HTTP_RESPONSE_CODE);
+
+            recordPhases(curl, defaultService);
+        }
+
+        Metrics::recordProcessorCall(defaultService, call, nanoseconds, HTTP_RESPONSE_CODE != 200);
+
+        return responseCode;
+    }
+
+private:
+    /**
+     * @brief Lê os tempos de cada fase da chamada (CURLINFO_*_TIME_T, acumulados desde o início) e registra a
+     * duração de cada uma no Metrics, junto com o reaproveitamento da conexão.
+     *
+     * Mostra quanto da latência é DNS / handshake (conexão nova a cada curl_easy_init) e quanto é o próprio processor (STARTTRANSFER).
+     */
+    static void recordPhases(CURL *curl, bool defaultService)
+    {
+        static constexpr array<CURLINFO, static_cast<size_t>(CurlPhase::COUNT)> PHASE_INFOS = {
+            CURLINFO_NAMELOOKUP_TIME_T, CURLINFO_CONNECT_TIME_T, CURLINFO_PRETRANSFER_TIME_T, CURLINFO_STARTTRANSFER_TIME_T, CURLINFO_TOTAL_TIME_T};
+
+        array<uint64_t, static_cast<size_t>(CurlPhase::COUNT)> phaseNanoseconds{};
+        curl_off_t previous = 0;
+
+        for (size_t phase = 0; phase < PHASE_INFOS.size(); phase++)
+        {
+            curl_off_t elapsedMicroseconds = 0;
+            curl_easy_getinfo(curl, PHASE_INFOS[phase], &elapsedMicroseconds);
+
+            // O TOTAL é a chamada inteira; as demais fases contam a partir do fim da anterior
+            bool total = phase == static_cast<size_t>(CurlPhase::TOTAL);
+            curl_off_t duration = total ? elapsedMicroseconds : max<curl_off_t>(0, elapsedMicroseconds - previous);
+
+            phaseNanoseconds[phase] = static_cast<uint64_t>(duration) * 1000;
+            previous = max(previous, elapsedMicroseconds);
+        }
+
+        long newConnections = 0;
+        curl_easy_getinfo(curl, CURLINFO_NUM_CONNECTS, &newConnections);
+
+        Metrics::recordProcessorPhases(defaultService, phaseNanoseconds, newConnections == 0);
+    }
+};
+
+#endif // GARNIZE_CURL_UTILS_H
@@ -0,0 +1,58 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file garnize.cpp
+ * @brief Definições dos membros estáticos das classes (veja "Por que inicializar variáveis estáticas declaradas dentro de uma classe, fora dela ?" no README).
+ *
+ * Compilado uma única vez na biblioteca libgarnize.a, que é ligada no servidor, nos benchmarks e nas ferramentas de carga.
+ */
+
+#include "request_arena.h"
+#include "tracer.h"
+#include "health_check.h"
+#include "config.h"
+
+thread_local pmr::memory_resource *RequestArena::current = nullptr;
+
+array<Tracer::ThreadBuffer, Constants::TRACE_THREAD_BUFFERS> Tracer::buffers;
+atomic<uint32_t> Tracer::nextThreadId{0};
+thread_local Tracer::Owner Tracer::owner;
+
+HealthCheck HealthCheckUtils::healthCheckDefault;
+HealthCheck HealthCheckUtils::healthCheckFallback;
+
+array<ConfigParameter, static_cast<size_t>(ConfigKey::COUNT)> Config::parameters = {{
+    {"port", "GARNIZE_PORT", "--port", Constants::PORT, 1, 65535, false, Constants::PORT, "padrão"},
+    {"listenBacklog", "GARNIZE_LISTEN_BACKLOG", "--listen-backlog", Constants::LISTEN_BACKLOG, 1, 65535, false, Constants::LISTEN_BACKLOG, "padrão"},
+    {"writePoolSize", "GARNIZE_WRITE_POOL_SIZE", "--write-pool-size", Constants::WRITE_POOL_SIZE, 1, 64, false, Constants::WRITE_POOL_SIZE, "padrão"},
+    {"readPoolSize", "GARNIZE_READ_POOL_SIZE", "--read-pool-size", Constants::READ_POOL_SIZE, 1, 64, false, Constants::READ_POOL_SIZE, "padrão"},
+    {"poolMaxQueueSize", "GARNIZE_POOL_MAX_QUEUE_SIZE", "--pool-max-queue-size", Constants::POOL_MAX_QUEUE_SIZE, 1, 1000000, false, Constants::POOL_MAX_QUEUE_SIZE, "padrão"},
+    {"writerQueueCapacity", "GARNIZE_WRITER_QUEUE_CAPACITY", "--writer-queue-capacity", Constants::WRITER_QUEUE_CAPACITY, 1024, 16777216, false, Constants::WRITER_QUEUE_CAPACITY, "padrão"},
+    {"sqliteBusyTimeoutMs", "GARNIZE_SQLITE_BUSY_TIMEOUT_MS", "--sqlite-busy-timeout-ms", Constants::SQLITE_BUSY_TIMEOUT_MS, 0, 60000, false, Constants::SQLITE_BUSY_TIMEOUT_MS, "padrão"},
+    {"bufferSize", "GARNIZE_BUFFER_SIZE", "--buffer-size", Constants::BUFFER_SIZE, 128, 65536, true, Constants::BUFFER_SIZE, "padrão"},
+    {"curlTimeoutMs", "GARNIZE_CURL_TIMEOUT_MS", "--curl-timeout-ms", Constants::CURL_TIMEOUT_MS, 1, 60000, true, Constants::CURL_TIMEOUT_MS, "padrão"},
+    {"healthCheckIntervalMs", "GARNIZE_HEALTH_CHECK_INTERVAL_MS", "--health-check-interval-ms", Constants::HEALTH_CHECK_INTERVAL_MS, 100, 600000, true, Constants::HEALTH_CHECK_INTERVAL_MS, "padrão"},
+    {"peerDeadlineMs", "GARNIZE_PEER_DEADLINE_MS", "--peer-deadline-ms", Constants::PEER_DEADLINE_MS, 1, 10000, true, Constants::PEER_DEADLINE_MS, "padrão"},
+}};
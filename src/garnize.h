@@ -0,0 +1,64 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file garnize.h
+ * @brief Inclui todas as classes do servidor (usado pela main, pelos benchmarks e pelas ferramentas de carga).
+ *
+ * As classes são header-only para que o caminho quente possa ser inlinado mesmo sem LTO; o estado estático
+ * delas é definido uma única vez em garnize.cpp, que forma a biblioteca (libgarnize.a) ligada em todos os executáveis.
+ */
+
+#ifndef GARNIZE_H
+#define GARNIZE_H
+
+#include "constants.h"
+#include "config.h"
+#include "mpsc_ring_buffer.h"
+#include "logger.h"
+#include "timer.h"
+#include "request_arena.h"
+#include "http_status.h"
+#include "latency_histogram.h"
+#include "metrics.h"
+#include "tracer.h"
+#include "curl_utils.h"
+#include "simd_scanner.h"
+#include "json_parser.h"
+#include "http.h"
+#include "string_utils.h"
+#include "time_utils.h"
+#include "uuid_generator.h"
+#include "sqlite_utils.h"
+#include "health_check.h"
+#include "payment.h"
+#include "json_serializer.h"
+#include "payments_utils.h"
+#include "payments_database_writer.h"
+#include "peer_summary.h"
+#include "saturation_metrics.h"
+#include "payments_processor.h"
+#include "request_handler.h"
+
+#endif // GARNIZE_H
@@ -0,0 +1,479 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file health_check.h
+ * @brief Health check dos payment processors (HealthCheckUtils / HealthCheckServiceThread).
+ */
+
+#ifndef GARNIZE_HEALTH_CHECK_H
+#define GARNIZE_HEALTH_CHECK_H
+
+#include "common.h"
+#include "constants.h"
+#include "config.h"
+#include "logger.h"
+#include "metrics.h"
+#include "curl_utils.h"
+#include "json_parser.h"
+#include "time_utils.h"
+#include "sqlite_utils.h"
+
+/**
+ * @brief Representa um registro de HealthCheck.
+ */
+struct HealthCheck
+{
+    /**
+     * @brief Nome do serviço.
+     */
+    string service;
+
+    /**
+     * @brief Indica se o serviço está falhando (0 = não, 1 = sim).
+     */
+    int failing;
+
+    /**
+     * @brief Tempo de resposta mínimo do serviço.
+     */
+    int minResponseTime;
+
+    /**
+     * @brief Data e hora da última verificação do serviço.
+     */
+    string lastCheck;
+};
+
+/**
+ * @brief Classe utilitária para gerenciamento de health check.
+ *
+ * Essa classe fornece métodos estáticos para inicializar e verificar o health check dos serviços de pagamentos.
+ */
+class HealthCheckUtils
+{
+public:
+    /**
+     * @brief Inicializa o health check dos serviços de pagamentos.
+     *
+     * Esse método cria a tabela de health check se necessário,
+     * verifica se os registros de health check para os serviços "default" e "fallback" estão criados.
+     *
+     * @return true se a inicialização foi bem-sucedida, false caso contrário.
+     */
+    static bool init()
+    {
+
+        bool success = createHealthCkeckTable();
+        LOGGER::info(success ? "Tabela do health check OK" : "Erro ao verificar tabela do health check");
+
+        return success;
+    }
+
+    /**
+     * @brief Escolhe se o serviço 'default' deve ser utilizado.
+     *
+     * @return true se o serviço está OK, false caso contrário.
+     */
+    static bool useDefault()
+    {
+        LOGGER::info("Serviço 'default' está funcionando: ", (healthCheckDefault.service.size() > 0 && !healthCheckDefault.failing) ? "Sim" : "Não");
+
+        bool isToUse = !healthCheckDefault.failing;
+
+        if (isToUse && !healthCheckFallback.failing && (healthCheckFallback.minResponseTime < healthCheckDefault.minResponseTime))
+        {
+            isToUse = false;
+        }
+
+        return isToUse;
+    }
+
+    /**
+     * @brief Escolhe se o serviço 'fallback' deve ser utilizado.
+     *
+     * @return true se o serviço está OK, false caso contrário.
+     */
+    static bool useFallback()
+    {
+        LOGGER::info("Serviço 'fallback' está funcionando: ", (healthCheckFallback.service.size() > 0 && !healthCheckFallback.failing) ? "Sim" : "Não");
+
+        bool isToUse = !healthCheckFallback.failing;
+
+        if (isToUse && !healthCheckDefault.failing && (healthCheckDefault.minResponseTime < healthCheckFallback.minResponseTime))
+        {
+            isToUse = false;
+        }
+
+        return isToUse;
+    }
+
+    /**
+     * @brief Atualiza um registro na tabela service_health_check.
+     *
+     * @param healthCheck Registro de HealthCheck a ser atualizado.
+     * @return bool True se o registro foi atualizado com sucesso, false caso contrário.
+     */
+    static bool updateHealthRecord(const HealthCheck &healthCheck)
+    {
+
+        sqlite3 *database = getDatabase();
+
+        const char *SQL_QUERY = R"(
+            UPDATE service_health_check SET service = ?, failing = ?, minResponseTime = ?, lastCheck = ? WHERE service = ?;
+        )";
+
+        sqlite3_stmt *statement;
+
+        int response = sqlite3_prepare_v2(database, SQL_QUERY, -1, &statement, nullptr);
+        bool success = (response == SQLITE_OK);
+
+        if (!success)
+        {
+            LOGGER::error("Erro ao preparar a query: ", sqlite3_errmsg(database));
+        }
+        else
+        {
+
+            sqlite3_bind_text(statement, 1, healthCheck.service.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_int(statement, 2, healthCheck.failing);
+            sqlite3_bind_int(statement, 3, healthCheck.minResponseTime);
+            sqlite3_bind_text(statement, 4, healthCheck.lastCheck.c_str(), -1, SQLITE_STATIC);
+            sqlite3_bind_text(statement, 5, healthCheck.service.c_str(), -1, SQLITE_STATIC);
+
+            response = sqlite3_step(statement);
+
+            success = (response == SQLITE_DONE);
+
+            if (!success)
+            {
+                LOGGER::error("Erro ao executar a query: ", sqlite3_errmsg(database));
+            }
+            else
+            {
+                auto setHealthCheckFor = [&](HealthCheck &healthcheckService)
+                {
+                    healthcheckService.service = healthCheck.service;
+                    healthcheckService.failing = healthCheck.failing;
+                    healthcheckService.minResponseTime = healthCheck.minResponseTime;
+                    healthcheckService.lastCheck = healthCheck.lastCheck;
+                };
+
+                setHealthCheckFor((healthCheck.service == "default") ? healthCheckDefault : healthCheckFallback);
+            }
+
+            sqlite3_finalize(statement);
+        }
+
+        SQLiteDatabaseUtils::closeConnection(database);
+
+        return success;
+    }
+
+    /**
+     * @brief Recupera o registro mais atual da tabela service_health_check.
+     *
+     * @param service String para escolher qual o serviço que deseja recuperar.
+     * @return HealthCheck contendo os valores do registro mais atual.
+     */
+    static HealthCheck getLastHealthCheck(const string &service)
+    {
+
+        sqlite3 *database = getDatabase();
+
+        const char *SQL_QUERY = R"(
+            SELECT service, 
+                   failing, 
+                   minResponseTime, 
+                   datetime(lastCheck, 'localtime') AS lastCheck 
+              FROM service_health_check 
+             WHERE service = ?;
+        )";
+
+        HealthCheck healthCheck;
+
+        sqlite3_stmt *statement;
+
+        int response = sqlite3_prepare_v2(database, SQL_QUERY, -1, &statement, nullptr);
+        bool success = (response == SQLITE_OK);
+
+        if (!success)
+        {
+            LOGGER::error("Erro ao preparar a query: ", sqlite3_errmsg(database));
+        }
+        else
+        {
+
+            sqlite3_bind_text(statement, 1, service.c_str(), -1, SQLITE_STATIC);
+
+            response = sqlite3_step(statement);
+
+            if (response == SQLITE_ROW)
+            {
+                healthCheck.service = reinterpret_cast<const char *>(sqlite3_column_text(statement, 0));
+                healthCheck.failing = sqlite3_column_int(statement, 1);
+                healthCheck.minResponseTime = sqlite3_column_int(statement, 2);
+                healthCheck.lastCheck = reinterpret_cast<const char *>(sqlite3_column_text(statement, 3));
+            }
+            else if (response == SQLITE_DONE)
+            {
+                LOGGER::info("Nenhum registro de service_health_check encontrado");
+            }
+            else
+            {
+                LOGGER::error("Erro ao executar a query: ", sqlite3_errmsg(database));
+            }
+
+            sqlite3_finalize(statement);
+        }
+
+        SQLiteDatabaseUtils::closeConnection(database);
+
+        return healthCheck;
+    }
+
+private:
+    /**
+     * @brief Instancia de HealthCheck para verificar se o serviço 'default' está funcionando.
+     */
+    static HealthCheck healthCheckDefault;
+
+    /**
+     * @brief Instancia de HealthCheck para verificar se o serviço'fallback' está funcionando.
+     */
+    static HealthCheck healthCheckFallback;
+
+    /**
+     * @brief Retorna um conexão com o banco de dados de health check.
+     *
+     * @return sqlite3* Ponteiro para o banco de dados.
+     */
+    static sqlite3 *getDatabase()
+    {
+        return SQLiteDatabaseUtils::openConnection(Constants::DATABASE_HEALTH_CHECK);
+    }
+
+    /**
+     * @brief Cria a tabela service_health_check no banco de dados se ela não existir.
+     *
+     * @return bool True se a tabela foi criada com sucesso, false caso contrário.
+     */
+    static bool createHealthCkeckTable()
+    {
+
+        sqlite3 *database = getDatabase();
+
+        const char *SQL_QUERY = R"(
+            CREATE TABLE IF NOT EXISTS service_health_check (
+                service TEXT CHECK(service IN ('default', 'fallback')) NOT NULL,
+                failing INTEGER NOT NULL,
+                minResponseTime INTEGER NOT NULL,
+                lastCheck DATETIME NOT NULL
+            );
+            INSERT INTO `service_health_check` (`service`, `failing`, `minResponseTime`, `lastCheck`) SELECT 'default', 0, 0, DATETIME('now', 'localtime') WHERE NOT EXISTS (SELECT 1 FROM service_health_check WHERE service = 'default');
+            INSERT INTO `service_health_check` (`service`, `failing`, `minResponseTime`, `lastCheck`) SELECT 'fallback', 0, 0, DATETIME('now', 'localtime') WHERE NOT EXISTS (SELECT 1 FROM service_health_check WHERE service = 'fallback');
+        )";
+
+        char *error;
+
+        int response = sqlite3_exec(database, SQL_QUERY, nullptr, nullptr, &error);
+
+        bool success = (response == SQLITE_OK);
+
+        if (!success)
+        {
+            LOGGER::error("Erro ao criar tabela service_health_check: ", error);
+
+            sqlite3_free(error);
+        }
+
+        SQLiteDatabaseUtils::closeConnection(database);
+
+        healthCheckDefault = getLastHealthCheck("default");
+        healthCheckFallback = getLastHealthCheck("fallback");
+
+        return success;
+    }
+};
+
+/**
+ * @brief Classe responsável por executar o health check dos serviços em uma thread separada.
+ *
+ * Essa classe fornece métodos estáticos para inicializar e executar o health check dos serviços.
+ */
+class HealthCheckServiceThread
+{
+public:
+    /**
+     * @brief Lê os campos 'failing' e 'minResponseTime' da resposta do health check de um processador.
+     *
+     * @param json A resposta do endpoint de health check.
+     * @param healthCheck O registro que recebe os valores.
+     * @return bool False se a resposta for inválida.
+     */
+    static bool parseHealthCheck(string_view json, HealthCheck &healthCheck)
+    {
+        JsonObject jsonResponse;
+        int64_t minResponseTime;
+
+        if (!JsonParser::parse(json, jsonResponse) || !jsonResponse.getInt64("minResponseTime", minResponseTime))
+        {
+            return false;
+        }
+
+        // 'failing' pode vir como booleano ou como 0 / 1
+        bool failing;
+        int64_t failingFlag;
+
+        if (jsonResponse.getBool("failing", failing))
+        {
+            healthCheck.failing = failing ? 1 : 0;
+        }
+        else if (jsonResponse.getInt64("failing", failingFlag))
+        {
+            healthCheck.failing = failingFlag != 0 ? 1 : 0;
+        }
+        else
+        {
+            return false;
+        }
+
+        healthCheck.minResponseTime = static_cast<int>(minResponseTime);
+
+        return true;
+    }
+
+    /**
+     * @brief Executa o health check dos serviços.
+     *
+     * Esse método faz requests para os serviços "default" e "fallback" para verificar seu status.
+     */
+    static void check()
+    {
+
+        /**
+         * @todo Débito técnico - Código duplicado
+         */
+        LOGGER::info("Fazendo request de health check para a o serviço 'default'");
+
+        CURLcode responseCodeDefault;
+        string URL_DEFAULT = Constants::PROCESSOR_DEFAULT + Constants::HEALTH_CHECK_ENDPOINT;
+        pmr::string defaultResponseBuffer;
+
+        CURL *curl_default = CURLUtils::setupCurlForGetRequest(URL_DEFAULT, defaultResponseBuffer);
+
+        if (curl_default)
+        {
+            responseCodeDefault = CURLUtils::perform(curl_default, true, ProcessorCall::HEALTH_CHECK);
+
+            if (responseCodeDefault != CURLE_OK)
+            {
+                LOGGER::error("Erro ao fazer curl request para o serviço 'default': ", curl_easy_strerror(responseCodeDefault));
+            }
+            else if (HealthCheck healthCheckDefault; !parseHealthCheck(defaultResponseBuffer, healthCheckDefault))
+            {
+                LOGGER::error("Resposta inválida do health check do serviço 'default': ", defaultResponseBuffer);
+            }
+            else
+            {
+                LOGGER::info("Dados recebidos (default): ", defaultResponseBuffer);
+
+                healthCheckDefault.service = "default";
+                healthCheckDefault.lastCheck = TimeUtils::getTimestampUTC();
+
+                LOGGER::info("Atualizando no banco de dados o registro do serviço 'default'");
+
+                HealthCheckUtils::updateHealthRecord(healthCheckDefault);
+
+                LOGGER::info("Health ckeck mais atual (default): ", healthCheckDefault.lastCheck);
+            }
+
+            curl_easy_cleanup(curl_default);
+        }
+        //--
+
+        /**
+         * @todo Débito técnico - Código duplicado
+         */
+        LOGGER::info("Fazendo request de health check para a o serviço 'fallback'");
+
+        CURLcode responseCodeFallback;
+        string URL_FALLBACK = Constants::PROCESSOR_FALLBACK + Constants::HEALTH_CHECK_ENDPOINT;
+        pmr::string fallbackResponseBuffer;
+
+        CURL *curl_fallback = CURLUtils::setupCurlForGetRequest(URL_FALLBACK, fallbackResponseBuffer);
+
+        if (curl_fallback)
+        {
+            responseCodeFallback = CURLUtils::perform(curl_fallback, false, ProcessorCall::HEALTH_CHECK);
+
+            if (responseCodeFallback != CURLE_OK)
+            {
+                LOGGER::error("Erro ao fazer curl request para o serviço 'fallback': ", curl_easy_strerror(responseCodeFallback));
+            }
+            else if (HealthCheck healthCheckFallback; !parseHealthCheck(fallbackResponseBuffer, healthCheckFallback))
+            {
+                LOGGER::error("Resposta inválida do health check do serviço 'fallback': ", fallbackResponseBuffer);
+            }
+            else
+            {
+                LOGGER::info("Dados recebidos (fallback): ", fallbackResponseBuffer);
+
+                healthCheckFallback.service = "fallback";
+                healthCheckFallback.lastCheck = TimeUtils::getTimestampUTC();
+
+                LOGGER::info("Atualizando no banco de dados o registro do serviço 'fallback'");
+
+                HealthCheckUtils::updateHealthRecord(healthCheckFallback);
+
+                LOGGER::info("Health ckeck mais atual (fallback): ", healthCheckFallback.lastCheck);
+            }
+
+            curl_easy_cleanup(curl_fallback);
+        }
+        //--
+    }
+
+    /**
+     * @brief Inicializa a thread de health check.
+     *
+     * Esse método cria uma thread que executa o método `check()` a cada healthCheckIntervalMs (5 segundos por padrão, veja Config).
+     * @note A thread é executada em um loop infinito.
+     */
+    static void init()
+    {
+        thread([]()
+               {
+                   while (true)
+                   {                    
+                       check();
+
+                       // O intervalo é lido a cada volta: pode ser alterado pelo POST /admin/config
+                       this_thread::sleep_for(chrono::milliseconds(Config::get(ConfigKey::HEALTH_CHECK_INTERVAL_MS)));
+                   } })
+            .detach();
+    }
+};
+
+#endif // GARNIZE_HEALTH_CHECK_H
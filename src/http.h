@@ -0,0 +1,226 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file http.h
+ * @brief Requisição e resposta HTTP (HttpRequest / HttpRequestParser / HttpResponse).
+ */
+
+#ifndef GARNIZE_HTTP_H
+#define GARNIZE_HTTP_H
+
+#include "common.h"
+#include "constants.h"
+#include "request_arena.h"
+#include "http_status.h"
+#include "simd_scanner.h"
+
+/**
+ * @brief Requisição HTTP já parseada.
+ *
+ * Todos os campos são views para o buffer da conexão (RequestHandler::handle), então o objeto
+ * não aloca nada e só é válido enquanto esse buffer existir.
+ */
+struct HttpRequest
+{
+    /**
+     * @brief Método da requisição ("GET", "POST", ...).
+     */
+    string_view method;
+
+    /**
+     * @brief Alvo completo da requisição (caminho + query string), usado nos logs.
+     */
+    string_view target;
+
+    /**
+     * @brief Caminho da requisição, sem a query string.
+     */
+    string_view path;
+
+    /**
+     * @brief Query string sem o '?' (vazia se não houver).
+     */
+    string_view query;
+
+    /**
+     * @brief Corpo da requisição (vazio se não houver).
+     */
+    string_view body;
+};
+
+/**
+ * @brief Classe que fornece métodos para parsear requisições HTTP.
+ */
+class HttpRequestParser
+{
+public:
+    /**
+     * @brief Parseia a linha de requisição e localiza o corpo, sem copiar nenhum byte.
+     *
+     * @param raw Os bytes lidos da conexão.
+     * @param request A requisição, com views para `raw`.
+     * @return true Se a linha de requisição for válida ("<método> <alvo> ...").
+     * @return false Caso contrário.
+     */
+    static bool parse(string_view raw, HttpRequest &request)
+    {
+        size_t methodEnd = raw.find(' ');
+
+        if (methodEnd == string_view::npos || methodEnd == 0)
+        {
+            return false;
+        }
+
+        size_t targetEnd = raw.find(' ', methodEnd + 1);
+
+        if (targetEnd == string_view::npos)
+        {
+            return false;
+        }
+
+        request.method = raw.substr(0, methodEnd);
+        request.target = raw.substr(methodEnd + 1, targetEnd - methodEnd - 1);
+
+        size_t queryPos = request.target.find('?');
+
+        request.path = request.target.substr(0, queryPos);
+        request.query = queryPos != string_view::npos ? request.target.substr(queryPos + 1) : string_view();
+
+        const char *headerEnd = SimdScanner::findHeaderEnd(raw.data(), raw.data() + raw.size());
+
+        request.body = headerEnd != raw.data() + raw.size() ? string_view(headerEnd + 4, raw.data() + raw.size() - headerEnd - 4) : string_view();
+
+        return true;
+    }
+
+    /**
+     * @brief Retorna o valor de um parâmetro da query string (ainda URL-encoded).
+     *
+     * @param query A query string, sem o '?'.
+     * @param key O nome do parâmetro.
+     * @param value O valor do parâmetro (view para `query`).
+     * @return true Se o parâmetro existir.
+     * @return false Caso contrário.
+     */
+    static bool getQueryParam(string_view query, string_view key, string_view &value)
+    {
+        while (!query.empty())
+        {
+            size_t end = query.find('&');
+            string_view param = query.substr(0, end);
+
+            if (param.size() > key.size() && param[key.size()] == '=' && param.compare(0, key.size(), key) == 0)
+            {
+                value = param.substr(key.size() + 1);
+
+                return true;
+            }
+
+            query = end != string_view::npos ? query.substr(end + 1) : string_view();
+        }
+
+        return false;
+    }
+};
+
+/**
+ * @brief Resposta HTTP: o status e o corpo JSON.
+ *
+ * O corpo é alocado na RequestArena, então o objeto deve ser criado dentro da request
+ * (RequestHandler::handle) e não alocar na heap.
+ */
+struct HttpResponse
+{
+    /**
+     * @brief Tamanho máximo dos cabeçalhos gerados por writeHeaders.
+     */
+    static constexpr size_t HEADERS_MAX_SIZE = 128;
+
+    HttpResponse(HttpStatus status = HttpStatus::OK, string_view body = {}) : status(status), body(body, RequestArena::getResource()) {}
+
+    /**
+     * @brief Status da resposta.
+     */
+    HttpStatus status;
+
+    /**
+     * @brief Cabeçalho Content-Type (até o "Content-Length: "), JSON por padrão.
+     */
+    string_view contentType = Constants::CONTENT_TYPE_APPLICATION_JSON;
+
+    /**
+     * @brief Corpo da resposta.
+     */
+    pmr::string body;
+
+    /**
+     * @brief Retorna a linha de status ("HTTP/1.1 200 OK", ...).
+     */
+    static string_view statusLine(HttpStatus status)
+    {
+        switch (status)
+        {
+        case HttpStatus::OK:
+            return Constants::OK_RESPONSE;
+        case HttpStatus::CREATED:
+            return Constants::CREATED_RESPONSE;
+        case HttpStatus::BAD_REQUEST:
+            return Constants::BAD_REQUEST_RESPONSE;
+        case HttpStatus::NOT_FOUND:
+            return Constants::NOT_FOUND_RESPONSE;
+        case HttpStatus::SERVICE_UNAVAILABLE:
+            return Constants::SERVICE_UNAVAILABLE_RESPONSE;
+        default:
+            return Constants::INTERNAL_SERVER_ERROR;
+        }
+    }
+
+    /**
+     * @brief Escreve a linha de status e os cabeçalhos (Content-Type / Content-Length) no buffer.
+     *
+     * @param buffer Buffer com pelo menos HEADERS_MAX_SIZE bytes.
+     * @return string_view Os cabeçalhos escritos, terminados em "\r\n\r\n".
+     */
+    string_view writeHeaders(char *buffer) const
+    {
+        char *output = buffer;
+
+        string_view line = statusLine(status);
+        memcpy(output, line.data(), line.size());
+        output += line.size();
+
+        memcpy(output, contentType.data(), contentType.size());
+        output += contentType.size();
+
+        output = to_chars(output, buffer + HEADERS_MAX_SIZE - 4, body.size()).ptr;
+
+        memcpy(output, "\r\n\r\n", 4);
+        output += 4;
+
+        return string_view(buffer, output - buffer);
+    }
+};
+
+#endif // GARNIZE_HTTP_H
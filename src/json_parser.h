@@ -0,0 +1,768 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file json_parser.h
+ * @brief Parser de JSON sem alocação (JsonValue / JsonObject / JsonParser).
+ */
+
+#ifndef GARNIZE_JSON_PARSER_H
+#define GARNIZE_JSON_PARSER_H
+
+#include "common.h"
+#include "simd_scanner.h"
+
+/**
+ * @brief Valor de um campo de um objeto JSON.
+ *
+ * Não copia nada: `raw` aponta para o buffer de entrada, que precisa continuar vivo enquanto o valor for usado.
+ */
+struct JsonValue
+{
+    /**
+     * @brief Tipos de valores JSON.
+     */
+    enum class Type : uint8_t
+    {
+        String,
+        Number,
+        Boolean,
+        Null,
+        Object,
+        Array
+    };
+
+    /**
+     * @brief O tipo do valor.
+     */
+    Type type;
+
+    /**
+     * @brief O texto do valor na entrada.
+     *
+     * Para strings é o conteúdo entre as aspas, com os escapes preservados (veja JsonParser::unescape);
+     * para objetos e arrays é o texto completo, incluindo os delimitadores.
+     */
+    string_view raw;
+
+    /**
+     * @brief Indica se a string contém sequências de escape.
+     */
+    bool hasEscapes;
+};
+
+/**
+ * @brief Objeto JSON parseado por JsonParser::parse, com acessores tipados.
+ *
+ * Os campos ficam em um array de tamanho fixo (sem alocação). Os acessores retornam false se o campo
+ * não existir ou não for do tipo pedido. Chaves repetidas: vale a última, como no parser anterior.
+ */
+class JsonObject
+{
+public:
+    /**
+     * @brief Quantidade máxima de campos de um objeto.
+     */
+    static const size_t MAX_FIELDS = 16;
+
+    /**
+     * @brief Retorna o valor do campo ou nullptr se ele não existir.
+     *
+     * @param key A chave do campo.
+     * @return const JsonValue* O valor do campo.
+     */
+    const JsonValue *find(string_view key) const
+    {
+        for (size_t i = fieldCount; i > 0; i--)
+        {
+            if (keys[i - 1] == key)
+            {
+                return &values[i - 1];
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief Retorna o conteúdo de um campo string (escapes preservados).
+     */
+    bool getString(string_view key, string_view &value) const
+    {
+        const JsonValue *field = find(key);
+
+        if (field == nullptr || field->type != JsonValue::Type::String)
+        {
+            return false;
+        }
+
+        value = field->raw;
+
+        return true;
+    }
+
+    /**
+     * @brief Retorna um campo numérico inteiro.
+     */
+    bool getInt64(string_view key, int64_t &value) const
+    {
+        const JsonValue *field = find(key);
+
+        if (field == nullptr || field->type != JsonValue::Type::Number)
+        {
+            return false;
+        }
+
+        auto [end, error] = from_chars(field->raw.data(), field->raw.data() + field->raw.size(), value);
+
+        return error == errc() && end == field->raw.data() + field->raw.size();
+    }
+
+    /**
+     * @brief Retorna um campo numérico como double.
+     */
+    bool getDouble(string_view key, double &value) const
+    {
+        const JsonValue *field = find(key);
+
+        if (field == nullptr || field->type != JsonValue::Type::Number)
+        {
+            return false;
+        }
+
+        auto [end, error] = from_chars(field->raw.data(), field->raw.data() + field->raw.size(), value);
+
+        return error == errc() && end == field->raw.data() + field->raw.size();
+    }
+
+    /**
+     * @brief Retorna um campo numérico de valor monetário em centavos, sem passar por double.
+     *
+     * Arredonda pela terceira casa decimal (meio para longe do zero). Números com expoente passam por double.
+     */
+    bool getAmountInCents(string_view key, int64_t &value) const
+    {
+        const JsonValue *field = find(key);
+
+        if (field == nullptr || field->type != JsonValue::Type::Number)
+        {
+            return false;
+        }
+
+        string_view raw = field->raw;
+
+        if (raw.find_first_of("eE") != string_view::npos)
+        {
+            double amount;
+
+            if (!getDouble(key, amount) || !isfinite(amount) || fabs(amount) > 9.0e15)
+            {
+                return false;
+            }
+
+            value = llround(amount * 100);
+
+            return true;
+        }
+
+        bool negative = raw[0] == '-';
+        size_t pos = negative ? 1 : 0;
+        size_t dot = raw.find('.');
+        size_t integerEnd = dot == string_view::npos ? raw.size() : dot;
+
+        // Até 16 dígitos inteiros cabem em int64 depois de multiplicar por 100
+        if (integerEnd - pos > 16)
+        {
+            return false;
+        }
+
+        int64_t cents = 0;
+
+        for (; pos < integerEnd; pos++)
+        {
+            cents = cents * 10 + (raw[pos] - '0');
+        }
+
+        int digits[3] = {0, 0, 0};
+
+        for (size_t i = 0; dot != string_view::npos && i < 3 && dot + 1 + i < raw.size(); i++)
+        {
+            digits[i] = raw[dot + 1 + i] - '0';
+        }
+
+        cents = cents * 100 + digits[0] * 10 + digits[1] + (digits[2] >= 5 ? 1 : 0);
+
+        value = negative ? -cents : cents;
+
+        return true;
+    }
+
+    /**
+     * @brief Retorna um campo booleano.
+     */
+    bool getBool(string_view key, bool &value) const
+    {
+        const JsonValue *field = find(key);
+
+        if (field == nullptr || field->type != JsonValue::Type::Boolean)
+        {
+            return false;
+        }
+
+        value = field->raw[0] == 't';
+
+        return true;
+    }
+
+    /**
+     * @brief Indica se o campo existe e é null.
+     */
+    bool isNull(string_view key) const
+    {
+        const JsonValue *field = find(key);
+
+        return field != nullptr && field->type == JsonValue::Type::Null;
+    }
+
+    /**
+     * @brief Quantidade de campos do objeto.
+     */
+    size_t size() const
+    {
+        return fieldCount;
+    }
+
+private:
+    friend class JsonParser;
+
+    /**
+     * @brief As chaves dos campos (escapes preservados).
+     */
+    string_view keys[MAX_FIELDS];
+
+    /**
+     * @brief Os valores dos campos.
+     */
+    JsonValue values[MAX_FIELDS];
+
+    /**
+     * @brief Quantidade de campos preenchidos.
+     */
+    size_t fieldCount = 0;
+};
+
+/**
+ * @brief Classe responsável por realizar o parse de uma string em formato JSON.
+ *
+ * Tokenizer de passada única sobre a entrada, sem alocação: valida a sintaxe completa (strings com escapes,
+ * números, true/false/null, objetos e arrays aninhados) e guarda em um JsonObject views para os campos do
+ * objeto de nível superior. Objetos e arrays aninhados são validados e devolvidos como texto bruto,
+ * que pode ser parseado de novo com parse (objetos) se necessário.
+ */
+class JsonParser
+{
+public:
+    /**
+     * @brief Faz o parse de um objeto JSON.
+     *
+     * @param json O texto JSON (precisa continuar vivo enquanto o JsonObject for usado).
+     * @param object O objeto que recebe os campos.
+     * @return bool True se o JSON é um objeto válido com até JsonObject::MAX_FIELDS campos, false caso contrário.
+     */
+    static bool parse(string_view json, JsonObject &object)
+    {
+        Cursor cursor{json.data(), json.data() + json.size()};
+
+        object.fieldCount = 0;
+
+        skipWhitespace(cursor);
+
+        if (!consume(cursor, '{'))
+        {
+            return false;
+        }
+
+        skipWhitespace(cursor);
+
+        if (!consume(cursor, '}'))
+        {
+            while (true)
+            {
+                JsonValue key;
+
+                skipWhitespace(cursor);
+
+                if (cursor.position == cursor.end || *cursor.position != '"' || !parseString(cursor, key))
+                {
+                    return false;
+                }
+
+                skipWhitespace(cursor);
+
+                if (!consume(cursor, ':'))
+                {
+                    return false;
+                }
+
+                skipWhitespace(cursor);
+
+                JsonValue value;
+
+                if (object.fieldCount == JsonObject::MAX_FIELDS || !parseValue(cursor, value, 1))
+                {
+                    return false;
+                }
+
+                object.keys[object.fieldCount] = key.raw;
+                object.values[object.fieldCount] = value;
+                object.fieldCount++;
+
+                skipWhitespace(cursor);
+
+                if (consume(cursor, '}'))
+                {
+                    break;
+                }
+
+                if (!consume(cursor, ','))
+                {
+                    return false;
+                }
+            }
+        }
+
+        skipWhitespace(cursor);
+
+        return cursor.position == cursor.end;
+    }
+
+    /**
+     * @brief Decodifica os escapes de uma string JSON (inclusive \uXXXX e pares surrogate) para UTF-8.
+     *
+     * @param raw O conteúdo da string, como em JsonValue::raw.
+     * @param output O buffer que recebe a string decodificada.
+     * @return bool False se houver um escape inválido.
+     */
+    static bool unescape(string_view raw, pmr::string &output)
+    {
+        output.clear();
+        output.reserve(raw.size());
+
+        for (size_t i = 0; i < raw.size(); i++)
+        {
+            if (raw[i] != '\\')
+            {
+                output += raw[i];
+                continue;
+            }
+
+            if (++i == raw.size())
+            {
+                return false;
+            }
+
+            switch (raw[i])
+            {
+            case '"':
+            case '\\':
+            case '/':
+                output += raw[i];
+                break;
+            case 'b':
+                output += '\b';
+                break;
+            case 'f':
+                output += '\f';
+                break;
+            case 'n':
+                output += '\n';
+                break;
+            case 'r':
+                output += '\r';
+                break;
+            case 't':
+                output += '\t';
+                break;
+            case 'u':
+            {
+                uint32_t codePoint;
+
+                if (!parseHex4(raw.substr(i + 1), codePoint))
+                {
+                    return false;
+                }
+
+                i += 4;
+
+                // Par surrogate (caracteres fora do BMP)
+                if (codePoint >= 0xD800 && codePoint <= 0xDBFF)
+                {
+                    uint32_t low;
+
+                    if (i + 2 >= raw.size() || raw[i + 1] != '\\' || raw[i + 2] != 'u' || !parseHex4(raw.substr(i + 3), low) || low < 0xDC00 || low > 0xDFFF)
+                    {
+                        return false;
+                    }
+
+                    i += 6;
+                    codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+                }
+
+                appendUtf8(codePoint, output);
+                break;
+            }
+            default:
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+private:
+    /**
+     * @brief Profundidade máxima de objetos / arrays aninhados.
+     */
+    static const int MAX_DEPTH = 32;
+
+    /**
+     * @brief Posição atual e fim da entrada.
+     */
+    struct Cursor
+    {
+        const char *position;
+        const char *end;
+    };
+
+    static void skipWhitespace(Cursor &cursor)
+    {
+        while (cursor.position < cursor.end && (*cursor.position == ' ' || *cursor.position == '\n' || *cursor.position == '\r' || *cursor.position == '\t'))
+        {
+            cursor.position++;
+        }
+    }
+
+    static bool consume(Cursor &cursor, char character)
+    {
+        if (cursor.position < cursor.end && *cursor.position == character)
+        {
+            cursor.position++;
+            return true;
+        }
+
+        return false;
+    }
+
+    static bool isDigit(char character)
+    {
+        return character >= '0' && character <= '9';
+    }
+
+    static bool isHex(char character)
+    {
+        return isDigit(character) || (character >= 'a' && character <= 'f') || (character >= 'A' && character <= 'F');
+    }
+
+    /**
+     * @brief Faz o parse de um valor qualquer a partir do primeiro caractere.
+     */
+    static bool parseValue(Cursor &cursor, JsonValue &value, int depth)
+    {
+        if (cursor.position == cursor.end)
+        {
+            return false;
+        }
+
+        switch (*cursor.position)
+        {
+        case '"':
+            return parseString(cursor, value);
+        case '{':
+        case '[':
+            return parseContainer(cursor, value, depth);
+        case 't':
+            return parseLiteral(cursor, "true", JsonValue::Type::Boolean, value);
+        case 'f':
+            return parseLiteral(cursor, "false", JsonValue::Type::Boolean, value);
+        case 'n':
+            return parseLiteral(cursor, "null", JsonValue::Type::Null, value);
+        default:
+            return parseNumber(cursor, value);
+        }
+    }
+
+    /**
+     * @brief Faz o parse de uma string (o cursor está nas aspas de abertura).
+     */
+    static bool parseString(Cursor &cursor, JsonValue &value)
+    {
+        const char *start = ++cursor.position;
+
+        value.type = JsonValue::Type::String;
+        value.hasEscapes = false;
+
+        while (cursor.position < cursor.end)
+        {
+            // Pula de uma vez o conteúdo sem aspas, escapes ou caracteres de controle
+            cursor.position = SimdScanner::findStringSpecial(cursor.position, cursor.end);
+
+            if (cursor.position == cursor.end)
+            {
+                return false;
+            }
+
+            char character = *cursor.position;
+
+            if (character == '"')
+            {
+                value.raw = string_view(start, cursor.position - start);
+                cursor.position++;
+
+                return true;
+            }
+
+            // Caracteres de controle precisam estar escapados
+            if (static_cast<unsigned char>(character) < 0x20)
+            {
+                return false;
+            }
+
+            if (character == '\\')
+            {
+                value.hasEscapes = true;
+
+                if (++cursor.position == cursor.end)
+                {
+                    return false;
+                }
+
+                if (*cursor.position == 'u')
+                {
+                    if (cursor.end - cursor.position < 5 || !isHex(cursor.position[1]) || !isHex(cursor.position[2]) || !isHex(cursor.position[3]) || !isHex(cursor.position[4]))
+                    {
+                        return false;
+                    }
+
+                    cursor.position += 4;
+                }
+                else if (string_view("\"\\/bfnrt").find(*cursor.position) == string_view::npos)
+                {
+                    return false;
+                }
+            }
+
+            cursor.position++;
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief Faz o parse de um número: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+     */
+    static bool parseNumber(Cursor &cursor, JsonValue &value)
+    {
+        const char *start = cursor.position;
+
+        consume(cursor, '-');
+
+        if (cursor.position == cursor.end || !isDigit(*cursor.position))
+        {
+            return false;
+        }
+
+        if (!consume(cursor, '0'))
+        {
+            while (cursor.position < cursor.end && isDigit(*cursor.position))
+            {
+                cursor.position++;
+            }
+        }
+
+        if (consume(cursor, '.'))
+        {
+            if (cursor.position == cursor.end || !isDigit(*cursor.position))
+            {
+                return false;
+            }
+
+            while (cursor.position < cursor.end && isDigit(*cursor.position))
+            {
+                cursor.position++;
+            }
+        }
+
+        if (consume(cursor, 'e') || consume(cursor, 'E'))
+        {
+            if (!consume(cursor, '+'))
+            {
+                consume(cursor, '-');
+            }
+
+            if (cursor.position == cursor.end || !isDigit(*cursor.position))
+            {
+                return false;
+            }
+
+            while (cursor.position < cursor.end && isDigit(*cursor.position))
+            {
+                cursor.position++;
+            }
+        }
+
+        value.type = JsonValue::Type::Number;
+        value.raw = string_view(start, cursor.position - start);
+        value.hasEscapes = false;
+
+        return true;
+    }
+
+    /**
+     * @brief Faz o parse de true, false ou null.
+     */
+    static bool parseLiteral(Cursor &cursor, string_view literal, JsonValue::Type type, JsonValue &value)
+    {
+        if (static_cast<size_t>(cursor.end - cursor.position) < literal.size() || string_view(cursor.position, literal.size()) != literal)
+        {
+            return false;
+        }
+
+        value.type = type;
+        value.raw = string_view(cursor.position, literal.size());
+        value.hasEscapes = false;
+
+        cursor.position += literal.size();
+
+        return true;
+    }
+
+    /**
+     * @brief Valida um objeto ou array aninhado e devolve o texto completo.
+     */
+    static bool parseContainer(Cursor &cursor, JsonValue &value, int depth)
+    {
+        if (depth > MAX_DEPTH)
+        {
+            return false;
+        }
+
+        const char *start = cursor.position;
+        bool isObject = *cursor.position == '{';
+        char close = isObject ? '}' : ']';
+
+        cursor.position++;
+
+        skipWhitespace(cursor);
+
+        if (!consume(cursor, close))
+        {
+            while (true)
+            {
+                JsonValue element;
+
+                skipWhitespace(cursor);
+
+                if (isObject)
+                {
+                    if (cursor.position == cursor.end || *cursor.position != '"' || !parseString(cursor, element))
+                    {
+                        return false;
+                    }
+
+                    skipWhitespace(cursor);
+
+                    if (!consume(cursor, ':'))
+                    {
+                        return false;
+                    }
+
+                    skipWhitespace(cursor);
+                }
+
+                if (!parseValue(cursor, element, depth + 1))
+                {
+                    return false;
+                }
+
+                skipWhitespace(cursor);
+
+                if (consume(cursor, close))
+                {
+                    break;
+                }
+
+                if (!consume(cursor, ','))
+                {
+                    return false;
+                }
+            }
+        }
+
+        value.type = isObject ? JsonValue::Type::Object : JsonValue::Type::Array;
+        value.raw = string_view(start, cursor.position - start);
+        value.hasEscapes = false;
+
+        return true;
+    }
+
+    static bool parseHex4(string_view hex, uint32_t &codePoint)
+    {
+        if (hex.size() < 4)
+        {
+            return false;
+        }
+
+        auto [end, error] = from_chars(hex.data(), hex.data() + 4, codePoint, 16);
+
+        return error == errc() && end == hex.data() + 4;
+    }
+
+    static void appendUtf8(uint32_t codePoint, pmr::string &output)
+    {
+        if (codePoint < 0x80)
+        {
+            output += static_cast<char>(codePoint);
+        }
+        else if (codePoint < 0x800)
+        {
+            output += static_cast<char>(0xC0 | (codePoint >> 6));
+            output += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else if (codePoint < 0x10000)
+        {
+            output += static_cast<char>(0xE0 | (codePoint >> 12));
+            output += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            output += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+        else
+        {
+            output += static_cast<char>(0xF0 | (codePoint >> 18));
+            output += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+            output += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+            output += static_cast<char>(0x80 | (codePoint & 0x3F));
+        }
+    }
+};
+
+#endif // GARNIZE_JSON_PARSER_H
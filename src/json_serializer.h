@@ -0,0 +1,344 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file json_serializer.h
+ * @brief Serialização JSON sem alocação das respostas (JsonWriter / JsonSerializer / PaymentsJSONConverter).
+ */
+
+#ifndef GARNIZE_JSON_SERIALIZER_H
+#define GARNIZE_JSON_SERIALIZER_H
+
+#include "common.h"
+#include "request_arena.h"
+#include "time_utils.h"
+#include "uuid_generator.h"
+#include "payment.h"
+
+/**
+ * @brief Funções de escrita de JSON direto no buffer do chamador, usadas pelos JsonSerializer.
+ *
+ * Os trechos fixos (chaves, aspas, separadores) são literais com tamanho conhecido em tempo de compilação
+ * e os números são escritos com std::to_chars, sem stringstream e sem alocação.
+ */
+class JsonWriter
+{
+public:
+    /**
+     * @brief Tamanho máximo de um double com 2 casas decimais (DBL_MAX tem 309 dígitos inteiros).
+     */
+    static constexpr size_t FIXED2_MAX_SIZE = 320;
+
+    /**
+     * @brief Tamanho máximo de um inteiro de 64 bits.
+     */
+    static constexpr size_t INTEGER_MAX_SIZE = 20;
+
+    /**
+     * @brief Tamanho de um literal de string sem o '\0'.
+     */
+    template <size_t N>
+    static constexpr size_t length(const char (&)[N])
+    {
+        return N - 1;
+    }
+
+    /**
+     * @brief Copia um literal (tamanho conhecido em tempo de compilação).
+     */
+    template <size_t N>
+    static char *writeLiteral(char *buffer, const char (&literal)[N])
+    {
+        memcpy(buffer, literal, N - 1);
+
+        return buffer + N - 1;
+    }
+
+    /**
+     * @brief Copia um texto já em formato JSON (ou uma string já escapada).
+     */
+    static char *writeRaw(char *buffer, string_view text)
+    {
+        memcpy(buffer, text.data(), text.size());
+
+        return buffer + text.size();
+    }
+
+    static char *writeInteger(char *buffer, int64_t value)
+    {
+        return to_chars(buffer, buffer + INTEGER_MAX_SIZE, value).ptr;
+    }
+
+    /**
+     * @brief Escreve um double com 2 casas decimais (mesmo resultado de `std::fixed << setprecision(2)`).
+     */
+    static char *writeFixed2(char *buffer, double value)
+    {
+        return to_chars(buffer, buffer + FIXED2_MAX_SIZE, value, chars_format::fixed, 2).ptr;
+    }
+
+    /**
+     * @brief Escreve um valor em centavos como número decimal com 6 casas (ex.: 1990 -> 19.900000).
+     *
+     * É o formato do to_string(double) usado desde a versão inicial no payload enviado aos payment
+     * processors e na resposta do POST /payments.
+     */
+    static char *writeCents(char *buffer, int64_t amountInCents)
+    {
+        uint64_t absolute = amountInCents < 0 ? -static_cast<uint64_t>(amountInCents) : amountInCents;
+
+        if (amountInCents < 0)
+        {
+            *buffer++ = '-';
+        }
+
+        buffer = to_chars(buffer, buffer + INTEGER_MAX_SIZE, absolute / 100).ptr;
+
+        buffer[0] = '.';
+        buffer[1] = static_cast<char>('0' + absolute % 100 / 10);
+        buffer[2] = static_cast<char>('0' + absolute % 10);
+        buffer[3] = '0';
+        buffer[4] = '0';
+        buffer[5] = '0';
+        buffer[6] = '0';
+
+        return buffer + 7;
+    }
+
+    static char *writeBool(char *buffer, bool value)
+    {
+        return value ? writeLiteral(buffer, "true") : writeLiteral(buffer, "false");
+    }
+};
+
+/**
+ * @brief Resposta do POST /payments: a mensagem do processador (já escapada) e o JSON do pagamento.
+ */
+struct PaymentResponse
+{
+    string_view message;
+    string_view payment;
+};
+
+/**
+ * @brief Resposta do POST /purge-payments.
+ */
+struct PurgeResponse
+{
+    string_view message;
+    bool success;
+};
+
+/**
+ * @brief Serializador JSON de um tipo, especializado para cada estrutura de resposta.
+ *
+ * Cada especialização fornece `maxSize(value)` (constexpr MAX_SIZE quando o tamanho não depende do valor)
+ * e `write(value, buffer)`, que escreve no buffer do chamador e retorna o ponteiro para o fim do JSON.
+ */
+template <typename T>
+struct JsonSerializer;
+
+template <>
+struct JsonSerializer<Payment>
+{
+    static constexpr char PREFIX[] = "{\"correlationId\": \"";
+    static constexpr char AMOUNT[] = "\", \"amount\": ";
+    static constexpr char REQUESTED_AT[] = ", \"requestedAt\" : \"";
+    static constexpr char SUFFIX[] = "\"}";
+
+    static constexpr size_t MAX_SIZE = JsonWriter::length(PREFIX) + 36 + JsonWriter::length(AMOUNT) + JsonWriter::INTEGER_MAX_SIZE + 8 +
+                                       JsonWriter::length(REQUESTED_AT) + TimeUtils::TIMESTAMP_MAX_SIZE + JsonWriter::length(SUFFIX);
+
+    static constexpr size_t maxSize(const Payment &)
+    {
+        return MAX_SIZE;
+    }
+
+    static char *write(const Payment &payment, char *buffer)
+    {
+        buffer = JsonWriter::writeLiteral(buffer, PREFIX);
+        buffer = UUIDGenerator::toChars(payment.correlationId, buffer);
+        buffer = JsonWriter::writeLiteral(buffer, AMOUNT);
+        buffer = JsonWriter::writeCents(buffer, payment.amountInCents);
+        buffer = JsonWriter::writeLiteral(buffer, REQUESTED_AT);
+        buffer = TimeUtils::formatTimestampUTC(payment.requestedAt, buffer);
+
+        return JsonWriter::writeLiteral(buffer, SUFFIX);
+    }
+};
+
+template <>
+struct JsonSerializer<PaymentsSummary>
+{
+    static constexpr char DEFAULT[] = "{\"default\":{\"totalRequests\":";
+    static constexpr char FALLBACK[] = "},\"fallback\":{\"totalRequests\":";
+    static constexpr char TOTAL_AMOUNT[] = ",\"totalAmount\":";
+    static constexpr char SUFFIX[] = "}}";
+
+    static constexpr size_t MAX_SIZE = JsonWriter::length(DEFAULT) + JsonWriter::length(FALLBACK) + 2 * JsonWriter::length(TOTAL_AMOUNT) +
+                                       2 * (JsonWriter::INTEGER_MAX_SIZE + JsonWriter::FIXED2_MAX_SIZE) + JsonWriter::length(SUFFIX);
+
+    static constexpr size_t maxSize(const PaymentsSummary &)
+    {
+        return MAX_SIZE;
+    }
+
+    static char *write(const PaymentsSummary &summary, char *buffer)
+    {
+        buffer = JsonWriter::writeLiteral(buffer, DEFAULT);
+        buffer = JsonWriter::writeInteger(buffer, summary.defaultStats.totalRequests);
+        buffer = JsonWriter::writeLiteral(buffer, TOTAL_AMOUNT);
+        buffer = JsonWriter::writeFixed2(buffer, summary.defaultStats.totalAmount);
+        buffer = JsonWriter::writeLiteral(buffer, FALLBACK);
+        buffer = JsonWriter::writeInteger(buffer, summary.fallbackStats.totalRequests);
+        buffer = JsonWriter::writeLiteral(buffer, TOTAL_AMOUNT);
+        buffer = JsonWriter::writeFixed2(buffer, summary.fallbackStats.totalAmount);
+
+        return JsonWriter::writeLiteral(buffer, SUFFIX);
+    }
+};
+
+template <>
+struct JsonSerializer<PaymentResponse>
+{
+    static constexpr char PREFIX[] = "{ \"message\":\"";
+    static constexpr char PAYMENT[] = "\", \"payment\": ";
+    static constexpr char SUFFIX[] = "}";
+
+    static size_t maxSize(const PaymentResponse &response)
+    {
+        return JsonWriter::length(PREFIX) + response.message.size() + JsonWriter::length(PAYMENT) + response.payment.size() + JsonWriter::length(SUFFIX);
+    }
+
+    static char *write(const PaymentResponse &response, char *buffer)
+    {
+        buffer = JsonWriter::writeLiteral(buffer, PREFIX);
+        buffer = JsonWriter::writeRaw(buffer, response.message);
+        buffer = JsonWriter::writeLiteral(buffer, PAYMENT);
+        buffer = JsonWriter::writeRaw(buffer, response.payment);
+
+        return JsonWriter::writeLiteral(buffer, SUFFIX);
+    }
+};
+
+template <>
+struct JsonSerializer<PurgeResponse>
+{
+    static constexpr char PREFIX[] = "{ \"message\": \"";
+    static constexpr char SUCCESS[] = "\", \"success\": ";
+    static constexpr char SUFFIX[] = "}";
+
+    static size_t maxSize(const PurgeResponse &response)
+    {
+        return JsonWriter::length(PREFIX) + response.message.size() + JsonWriter::length(SUCCESS) + 5 + JsonWriter::length(SUFFIX);
+    }
+
+    static char *write(const PurgeResponse &response, char *buffer)
+    {
+        buffer = JsonWriter::writeLiteral(buffer, PREFIX);
+        buffer = JsonWriter::writeRaw(buffer, response.message);
+        buffer = JsonWriter::writeLiteral(buffer, SUCCESS);
+        buffer = JsonWriter::writeBool(buffer, response.success);
+
+        return JsonWriter::writeLiteral(buffer, SUFFIX);
+    }
+};
+
+/**
+ * @brief Classe responsável por converter estruturas para string JSON.
+ *
+ * Fornece um métodos estáticos para converter em uma string JSON (veja JsonSerializer).
+ */
+class PaymentsJSONConverter
+{
+public:
+    /**
+     * @brief Escreve o JSON de `value` no buffer do chamador, sem alocação.
+     *
+     * @param value O valor a ser convertido.
+     * @param buffer Buffer com pelo menos JsonSerializer<T>::maxSize(value) bytes.
+     * @return string_view O JSON escrito no buffer.
+     */
+    template <typename T>
+    static string_view write(const T &value, char *buffer)
+    {
+        return string_view(buffer, JsonSerializer<T>::write(value, buffer) - buffer);
+    }
+
+    /**
+     * @brief Converte `value` para uma string JSON alocada na arena da request corrente.
+     *
+     * @param value O valor a ser convertido.
+     * @return std::pmr::string A string JSON.
+     */
+    template <typename T>
+    static pmr::string toJsonString(const T &value)
+    {
+        pmr::string json(RequestArena::getResource());
+
+        json.resize(JsonSerializer<T>::maxSize(value));
+        json.resize(JsonSerializer<T>::write(value, json.data()) - json.data());
+
+        return json;
+    }
+
+    /**
+     * @brief Converte um PaymentSummary para uma string JSON.
+     *
+     * @param summary O PaymentSummary a ser convertido.
+     * @return std::string A string JSON representando o PaymentsSummary.
+     */
+    static string summaryToJson(const PaymentsSummary &summary)
+    {
+        char buffer[JsonSerializer<PaymentsSummary>::MAX_SIZE];
+
+        return string(write(summary, buffer));
+    }
+
+    /**
+     * @brief Converte um Payment para uma string JSON alocada na arena da request corrente.
+     *
+     * @param payment O Payment a ser convertido.
+     * @return std::pmr::string A string JSON representando o Payment.
+     */
+    static pmr::string toJson(const Payment &payment)
+    {
+        return toJsonString(payment);
+    }
+
+    /**
+     * @brief Formata um valor em centavos como número decimal com 6 casas (ex.: 1990 -> "19.900000").
+     *
+     * @param amountInCents O valor em centavos.
+     * @return std::string O valor formatado.
+     */
+    static string formatAmount(int64_t amountInCents)
+    {
+        char buffer[JsonWriter::INTEGER_MAX_SIZE + 8];
+
+        return string(buffer, JsonWriter::writeCents(buffer, amountInCents));
+    }
+};
+
+#endif // GARNIZE_JSON_SERIALIZER_H
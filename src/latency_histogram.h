@@ -0,0 +1,153 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file latency_histogram.h
+ * @brief Histograma de latências log-linear sem lock (LatencyHistogram).
+ */
+
+#ifndef GARNIZE_LATENCY_HISTOGRAM_H
+#define GARNIZE_LATENCY_HISTOGRAM_H
+
+#include "common.h"
+
+/**
+ * @brief Histograma de latências no estilo HDR, lock-free e sem alocação.
+ *
+ * Os valores (em nanossegundos) são agrupados em buckets log-lineares: cada potência de 2 é dividida em
+ * SUB_BUCKETS buckets lineares, o que dá uma precisão relativa de ~6% em toda a faixa de uint64_t.
+ * O registro é um fetch_add relaxed em três contadores; os percentis são calculados na leitura.
+ */
+class LatencyHistogram
+{
+public:
+    /**
+     * @brief Bits de sub-bucket por potência de 2 (16 buckets lineares).
+     */
+    static constexpr uint32_t SUB_BUCKET_BITS = 4;
+
+    static constexpr uint64_t SUB_BUCKETS = uint64_t(1) << SUB_BUCKET_BITS;
+
+    /**
+     * @brief Quantidade total de buckets: os valores < SUB_BUCKETS são exatos, os demais ocupam SUB_BUCKETS buckets por potência de 2.
+     */
+    static constexpr size_t BUCKETS = SUB_BUCKETS + (64 - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+    /**
+     * @brief Registra um valor (pode ser chamado por várias threads).
+     */
+    void record(uint64_t value)
+    {
+        buckets[bucketIndex(value)].fetch_add(1, memory_order_relaxed);
+        count.fetch_add(1, memory_order_relaxed);
+        sum.fetch_add(value, memory_order_relaxed);
+    }
+
+    /**
+     * @brief Quantidade de valores registrados.
+     */
+    uint64_t getCount() const
+    {
+        return count.load(memory_order_relaxed);
+    }
+
+    /**
+     * @brief Soma dos valores registrados.
+     */
+    uint64_t getSum() const
+    {
+        return sum.load(memory_order_relaxed);
+    }
+
+    /**
+     * @brief Retorna o maior valor equivalente ao percentil (0 < percentile <= 1), ou 0 se o histograma estiver vazio.
+     */
+    uint64_t getPercentile(double percentile) const
+    {
+        uint64_t total = 0;
+
+        for (const atomic<uint64_t> &bucket : buckets)
+        {
+            total += bucket.load(memory_order_relaxed);
+        }
+
+        if (total == 0)
+        {
+            return 0;
+        }
+
+        uint64_t target = max<uint64_t>(1, static_cast<uint64_t>(ceil(percentile * total)));
+        uint64_t accumulated = 0;
+
+        for (size_t index = 0; index < BUCKETS; index++)
+        {
+            accumulated += buckets[index].load(memory_order_relaxed);
+
+            if (accumulated >= target)
+            {
+                return bucketUpperBound(index);
+            }
+        }
+
+        return bucketUpperBound(BUCKETS - 1);
+    }
+
+    /**
+     * @brief Índice do bucket de um valor.
+     */
+    static size_t bucketIndex(uint64_t value)
+    {
+        if (value < SUB_BUCKETS)
+        {
+            return value;
+        }
+
+        uint32_t shift = 63 - __builtin_clzll(value) - SUB_BUCKET_BITS;
+
+        return SUB_BUCKETS + shift * SUB_BUCKETS + ((value >> shift) - SUB_BUCKETS);
+    }
+
+    /**
+     * @brief Maior valor que cai no bucket.
+     */
+    static uint64_t bucketUpperBound(size_t index)
+    {
+        if (index < SUB_BUCKETS)
+        {
+            return index;
+        }
+
+        uint64_t shift = (index - SUB_BUCKETS) / SUB_BUCKETS;
+        uint64_t top = SUB_BUCKETS + (index - SUB_BUCKETS) % SUB_BUCKETS;
+
+        return ((top + 1) << shift) - 1;
+    }
+
+private:
+    array<atomic<uint64_t>, BUCKETS> buckets{};
+    atomic<uint64_t> count{0};
+    atomic<uint64_t> sum{0};
+};
+
+#endif // GARNIZE_LATENCY_HISTOGRAM_H
@@ -0,0 +1,326 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file logger.h
+ * @brief Logs assíncronos (LOGGER) com níveis removidos em tempo de compilação.
+ */
+
+#ifndef GARNIZE_LOGGER_H
+#define GARNIZE_LOGGER_H
+
+#include "common.h"
+#include "constants.h"
+#include "mpsc_ring_buffer.h"
+
+#ifndef GARNIZE_LOG_LEVEL
+/**
+ * @brief Nível mínimo de log compilado (0 = debug, 1 = info, 2 = erro, 3 = nenhum).
+ *
+ * Chamadas abaixo desse nível são removidas em tempo de compilação (ex.: -DGARNIZE_LOG_LEVEL=2 no build de produção).
+ */
+#define GARNIZE_LOG_LEVEL 1
+#endif
+
+/**
+ * @brief Níveis de log, em ordem crescente de severidade.
+ */
+enum class LogLevel : uint8_t
+{
+    DEBUG = 0,
+    INFO = 1,
+    ERROR = 2,
+    OFF = 3
+};
+
+/**
+ * @brief Classe que fornece métodos para registro de logs.
+ *
+ * As mensagens são formatadas na thread chamadora direto em um LogRecord de tamanho fixo (sem alocação)
+ * e publicadas em um MPSCRingBuffer. Uma thread de fundo drena o buffer e escreve as mensagens em lote,
+ * com um único write(2) por stream, sem endl / flush por mensagem. Se o buffer estiver cheio a mensagem
+ * é descartada (e contada) em vez de bloquear a request.
+ *
+ * Os argumentos são concatenados (textos, números e bools), então a mensagem só é montada se o nível
+ * estiver habilitado: LOGGER::info("Persistidos ", records, " pagamentos").
+ */
+class LOGGER
+{
+public:
+    /**
+     * @brief Nível mínimo de log compilado.
+     */
+    static constexpr LogLevel MIN_LEVEL = static_cast<LogLevel>(GARNIZE_LOG_LEVEL);
+
+    /**
+     * @brief Verifica em tempo de compilação se um nível de log está habilitado.
+     *
+     * Útil para evitar o cálculo de argumentos caros: if constexpr (LOGGER::isEnabled(LogLevel::INFO)) { ... }
+     */
+    static constexpr bool isEnabled(LogLevel level)
+    {
+        return level >= MIN_LEVEL && level != LogLevel::OFF;
+    }
+
+    /**
+     * @brief Registra uma mensagem de depuração.
+     */
+    template <typename... Args>
+    static void debug(const Args &...args)
+    {
+        log<LogLevel::DEBUG>(args...);
+    }
+
+    /**
+     * @brief Registra uma mensagem informativa.
+     */
+    template <typename... Args>
+    static void info(const Args &...args)
+    {
+        log<LogLevel::INFO>(args...);
+    }
+
+    /**
+     * @brief Registra uma mensagem de erro.
+     */
+    template <typename... Args>
+    static void error(const Args &...args)
+    {
+        log<LogLevel::ERROR>(args...);
+    }
+
+    /**
+     * @brief Aguarda (até 1 segundo) a thread de fundo escrever as mensagens já publicadas.
+     *
+     * É chamado automaticamente na saída do processo (atexit).
+     */
+    static void flush()
+    {
+        if constexpr (MIN_LEVEL != LogLevel::OFF)
+        {
+            AsyncWriter &writer = getWriter();
+
+            uint64_t published = writer.published.load(memory_order_acquire);
+            auto deadline = chrono::steady_clock::now() + chrono::seconds(1);
+
+            while (writer.written.load(memory_order_acquire) < published && chrono::steady_clock::now() < deadline)
+            {
+                this_thread::sleep_for(chrono::milliseconds(1));
+            }
+        }
+    }
+
+private:
+    /**
+     * @brief Mensagem formatada, copiada para um slot do ring buffer.
+     */
+    struct LogRecord
+    {
+        LogLevel level;
+        uint16_t length;
+        char text[Constants::LOG_MESSAGE_MAX_SIZE];
+    };
+
+    /**
+     * @brief Ring buffer das mensagens e thread de fundo que o drena.
+     *
+     * O objeto nunca é destruído (é criado com new): threads detached ainda podem logar durante a saída do processo.
+     */
+    struct AsyncWriter
+    {
+        AsyncWriter() : records(Constants::LOG_QUEUE_CAPACITY)
+        {
+            thread([this]()
+                   { drain(); })
+                .detach();
+        }
+
+        /**
+         * @brief Loop da thread de fundo: junta as mensagens disponíveis em um buffer por stream e escreve em lote.
+         */
+        void drain()
+        {
+            string output, errors;
+            LogRecord record;
+
+            output.reserve(Constants::LOG_BATCH_SIZE);
+            errors.reserve(Constants::LOG_BATCH_SIZE);
+
+            while (true)
+            {
+                uint64_t batch = 0;
+
+                while (output.size() < Constants::LOG_BATCH_SIZE && errors.size() < Constants::LOG_BATCH_SIZE && records.tryPop(record))
+                {
+                    string &stream = record.level == LogLevel::ERROR ? errors : output;
+
+                    stream.append(record.level == LogLevel::ERROR ? "Erro: " : record.level == LogLevel::INFO ? "Info: "
+                                                                                                              : "Debug: ");
+                    stream.append(record.text, record.length).push_back('\n');
+
+                    batch++;
+                }
+
+                if (uint64_t droppedRecords = dropped.exchange(0, memory_order_relaxed); droppedRecords > 0)
+                {
+                    errors.append("Erro: ").append(to_string(droppedRecords)).append(" mensagens de log descartadas (buffer cheio)\n");
+                }
+
+                writeAll(STDOUT_FILENO, output);
+                writeAll(STDERR_FILENO, errors);
+
+                written.fetch_add(batch, memory_order_release);
+
+                if (batch == 0)
+                {
+                    this_thread::sleep_for(chrono::milliseconds(Constants::LOG_FLUSH_INTERVAL_MS));
+                }
+            }
+        }
+
+        /**
+         * @brief Escreve todo o buffer no descritor e o esvazia.
+         */
+        static void writeAll(int descriptor, string &buffer)
+        {
+            size_t offset = 0;
+
+            while (offset < buffer.size())
+            {
+                ssize_t count = write(descriptor, buffer.data() + offset, buffer.size() - offset);
+
+                if (count < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+
+                if (count <= 0)
+                {
+                    break;
+                }
+
+                offset += count;
+            }
+
+            buffer.clear();
+        }
+
+        /**
+         * @brief Mensagens publicadas e ainda não escritas.
+         */
+        MPSCRingBuffer<LogRecord> records;
+
+        /**
+         * @brief Quantidade de mensagens publicadas (usada pelo flush).
+         */
+        atomic<uint64_t> published{0};
+
+        /**
+         * @brief Quantidade de mensagens já escritas pela thread de fundo.
+         */
+        atomic<uint64_t> written{0};
+
+        /**
+         * @brief Mensagens descartadas desde a última escrita, por falta de espaço no buffer.
+         */
+        atomic<uint64_t> dropped{0};
+    };
+
+    /**
+     * @brief Retorna o AsyncWriter, criando-o (e a thread de fundo) no primeiro log.
+     */
+    static AsyncWriter &getWriter()
+    {
+        static AsyncWriter *writer = []()
+        {
+            AsyncWriter *instance = new AsyncWriter();
+            atexit(LOGGER::flush);
+
+            return instance;
+        }();
+
+        return *writer;
+    }
+
+    /**
+     * @brief Formata os argumentos em um LogRecord e o publica, se o nível estiver habilitado.
+     */
+    template <LogLevel Level, typename... Args>
+    static void log(const Args &...args)
+    {
+        if constexpr (isEnabled(Level))
+        {
+            LogRecord record;
+            record.level = Level;
+            record.length = 0;
+
+            (append(record, args), ...);
+
+            AsyncWriter &writer = getWriter();
+
+            if (writer.records.tryPush(record))
+            {
+                writer.published.fetch_add(1, memory_order_release);
+            }
+            else
+            {
+                writer.dropped.fetch_add(1, memory_order_relaxed);
+            }
+        }
+    }
+
+    /**
+     * @brief Acrescenta um argumento ao texto da mensagem (truncando no tamanho máximo).
+     */
+    template <typename T>
+    static void append(LogRecord &record, const T &value)
+    {
+        char *output = record.text + record.length;
+        char *end = record.text + sizeof(record.text);
+
+        if constexpr (is_same_v<T, bool>)
+        {
+            append(record, value ? "true" : "false");
+        }
+        else if constexpr (is_integral_v<T> || is_floating_point_v<T>)
+        {
+            to_chars_result result = to_chars(output, end, value);
+
+            if (result.ec == errc())
+            {
+                record.length = static_cast<uint16_t>(result.ptr - record.text);
+            }
+        }
+        else
+        {
+            string_view text(value);
+            size_t length = min(text.size(), static_cast<size_t>(end - output));
+
+            memcpy(output, text.data(), length);
+            record.length = static_cast<uint16_t>(record.length + length);
+        }
+    }
+};
+
+#endif // GARNIZE_LOGGER_H
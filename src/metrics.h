@@ -0,0 +1,395 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file metrics.h
+ * @brief Métricas de latência e contadores exportados no GET /metrics (Metrics).
+ */
+
+#ifndef GARNIZE_METRICS_H
+#define GARNIZE_METRICS_H
+
+#include "common.h"
+#include "http_status.h"
+#include "latency_histogram.h"
+
+/**
+ * @brief Endpoints medidos pelo Metrics (OTHER agrupa requests inválidas e rotas não mapeadas).
+ */
+enum class MetricsEndpoint : uint8_t
+{
+    PAYMENTS,
+    PAYMENTS_SUMMARY,
+    PURGE_PAYMENTS,
+    PARTITIONS,
+    DROP_PARTITIONS,
+    TRACE,
+    METRICS,
+    CONFIG,
+    OTHER,
+    COUNT
+};
+
+/**
+ * @brief Chamadas feitas para os payment processors.
+ */
+enum class ProcessorCall : uint8_t
+{
+    PAYMENTS,
+    PAYMENTS_SUMMARY,
+    HEALTH_CHECK,
+    COUNT
+};
+
+/**
+ * @brief Fases de uma chamada cURL (CURLINFO_*_TIME_T), na ordem em que acontecem.
+ */
+enum class CurlPhase : uint8_t
+{
+    NAMELOOKUP,
+    CONNECT,
+    PRETRANSFER,
+    STARTTRANSFER,
+    TOTAL,
+    COUNT
+};
+
+/**
+ * @brief Decisão de roteamento de um pagamento (HealthCheckUtils).
+ */
+enum class RoutingDecision : uint8_t
+{
+    DEFAULT,
+    FALLBACK,
+    UNAVAILABLE,
+    COUNT
+};
+
+/**
+ * @brief Métricas do processo (latências e contadores), expostas em GET /metrics no formato texto do Prometheus.
+ *
+ * Todo o estado é estático e pré-alocado: registrar uma métrica só faz fetch_add relaxed.
+ */
+class Metrics
+{
+public:
+    /**
+     * @brief Registra a latência e o status de uma request.
+     */
+    static void recordRequest(MetricsEndpoint endpoint, HttpStatus status, uint64_t nanoseconds)
+    {
+        requestLatency[index(endpoint)].record(nanoseconds);
+        responses[index(endpoint)][statusIndex(status)].fetch_add(1, memory_order_relaxed);
+    }
+
+    /**
+     * @brief Registra a latência de uma chamada a um payment processor (e se ela falhou).
+     */
+    static void recordProcessorCall(bool defaultService, ProcessorCall call, uint64_t nanoseconds, bool failed)
+    {
+        processorLatency[defaultService ? 0 : 1][index(call)].record(nanoseconds);
+
+        if (failed)
+        {
+            processorErrors[defaultService ? 0 : 1][index(call)].fetch_add(1, memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Registra a duração de cada fase de uma chamada a um payment processor e se a conexão foi reaproveitada.
+     *
+     * @param defaultService Se o processor é o 'default' (ou o 'fallback').
+     * @param phaseNanoseconds Duração de cada fase (desde o fim da fase anterior; TOTAL é a chamada inteira).
+     * @param reusedConnection Se o cURL reaproveitou uma conexão (CURLINFO_NUM_CONNECTS == 0).
+     */
+    static void recordProcessorPhases(bool defaultService, const array<uint64_t, static_cast<size_t>(CurlPhase::COUNT)> &phaseNanoseconds, bool reusedConnection)
+    {
+        for (size_t phase = 0; phase < PHASES; phase++)
+        {
+            processorPhaseLatency[defaultService ? 0 : 1][phase].record(phaseNanoseconds[phase]);
+        }
+
+        processorConnections[defaultService ? 0 : 1][reusedConnection ? 1 : 0].fetch_add(1, memory_order_relaxed);
+    }
+
+    /**
+     * @brief Conta uma decisão de roteamento.
+     */
+    static void recordRouting(RoutingDecision decision)
+    {
+        routingDecisions[index(decision)].fetch_add(1, memory_order_relaxed);
+    }
+
+    /**
+     * @brief Escreve todas as métricas no formato texto do Prometheus (0.0.4).
+     */
+    static void render(pmr::string &output)
+    {
+        output.append("# HELP garnize_request_duration_seconds Latência das requests por endpoint.\n"
+                      "# TYPE garnize_request_duration_seconds summary\n");
+
+        for (size_t endpoint = 0; endpoint < ENDPOINTS; endpoint++)
+        {
+            appendSummary(output, "garnize_request_duration_seconds", requestLatency[endpoint], "endpoint=\"", ENDPOINT_LABELS[endpoint], "\"");
+        }
+
+        output.append("# HELP garnize_http_responses_total Respostas por endpoint e status.\n"
+                      "# TYPE garnize_http_responses_total counter\n");
+
+        for (size_t endpoint = 0; endpoint < ENDPOINTS; endpoint++)
+        {
+            for (size_t status = 0; status <= OTHER_STATUS; status++)
+            {
+                uint64_t value = responses[endpoint][status].load(memory_order_relaxed);
+
+                if (value > 0)
+                {
+                    output.append("garnize_http_responses_total{endpoint=\"").append(ENDPOINT_LABELS[endpoint]).append("\",status=\"");
+
+                    if (status == OTHER_STATUS)
+                    {
+                        output.append("other");
+                    }
+                    else
+                    {
+                        appendInteger(output, static_cast<uint16_t>(STATUSES[status]));
+                    }
+
+                    output.append("\"} ");
+                    appendInteger(output, value);
+                    output.push_back('\n');
+                }
+            }
+        }
+
+        output.append("# HELP garnize_processor_call_duration_seconds Latência das chamadas aos payment processors.\n"
+                      "# TYPE garnize_processor_call_duration_seconds summary\n");
+
+        for (size_t processor = 0; processor < 2; processor++)
+        {
+            for (size_t call = 0; call < CALLS; call++)
+            {
+                appendSummary(output, "garnize_processor_call_duration_seconds", processorLatency[processor][call],
+                              processor == 0 ? "processor=\"default\",call=\"" : "processor=\"fallback\",call=\"", CALL_LABELS[call], "\"");
+            }
+        }
+
+        output.append("# HELP garnize_processor_call_errors_total Chamadas aos payment processors com erro de transporte ou status diferente de 200.\n"
+                      "# TYPE garnize_processor_call_errors_total counter\n");
+
+        for (size_t processor = 0; processor < 2; processor++)
+        {
+            for (size_t call = 0; call < CALLS; call++)
+            {
+                output.append("garnize_processor_call_errors_total{processor=\"").append(processor == 0 ? "default" : "fallback");
+                output.append("\",call=\"").append(CALL_LABELS[call]).append("\"} ");
+                appendInteger(output, processorErrors[processor][call].load(memory_order_relaxed));
+                output.push_back('\n');
+            }
+        }
+
+        output.append("# HELP garnize_processor_phase_duration_seconds Duração de cada fase das chamadas aos payment processors (CURLINFO), desde o fim da fase anterior.\n"
+                      "# TYPE garnize_processor_phase_duration_seconds summary\n");
+
+        for (size_t processor = 0; processor < 2; processor++)
+        {
+            for (size_t phase = 0; phase < PHASES; phase++)
+            {
+                appendSummary(output, "garnize_processor_phase_duration_seconds", processorPhaseLatency[processor][phase],
+                              processor == 0 ? "processor=\"default\",phase=\"" : "processor=\"fallback\",phase=\"", PHASE_LABELS[phase], "\"");
+            }
+        }
+
+        output.append("# HELP garnize_processor_connections_total Chamadas aos payment processors por conexão nova ou reaproveitada.\n"
+                      "# TYPE garnize_processor_connections_total counter\n");
+
+        for (size_t processor = 0; processor < 2; processor++)
+        {
+            for (size_t reused = 0; reused < 2; reused++)
+            {
+                output.append("garnize_processor_connections_total{processor=\"").append(processor == 0 ? "default" : "fallback");
+                output.append(reused == 1 ? "\",reused=\"true\"} " : "\",reused=\"false\"} ");
+                appendInteger(output, processorConnections[processor][reused].load(memory_order_relaxed));
+                output.push_back('\n');
+            }
+        }
+
+        output.append("# HELP garnize_active_handler_threads Threads de request (detached) em execução.\n"
+                      "# TYPE garnize_active_handler_threads gauge\n");
+        appendSample(output, "garnize_active_handler_threads", "", activeHandlers.load(memory_order_relaxed));
+
+        output.append("# HELP garnize_routing_decisions_total Processor escolhido para cada pagamento.\n"
+                      "# TYPE garnize_routing_decisions_total counter\n");
+
+        for (size_t decision = 0; decision < DECISIONS; decision++)
+        {
+            output.append("garnize_routing_decisions_total{decision=\"").append(DECISION_LABELS[decision]).append("\"} ");
+            appendInteger(output, routingDecisions[decision].load(memory_order_relaxed));
+            output.push_back('\n');
+        }
+    }
+
+    /**
+     * @brief Escreve um inteiro sem alocar.
+     */
+    static void appendInteger(pmr::string &output, uint64_t value)
+    {
+        char buffer[20];
+        output.append(buffer, to_chars(buffer, buffer + sizeof(buffer), value).ptr);
+    }
+
+    /**
+     * @brief Escreve um valor dividido por `divisor` (ex.: nanossegundos em segundos, a unidade base do Prometheus).
+     */
+    static void appendScaled(pmr::string &output, uint64_t value, double divisor)
+    {
+        char buffer[32];
+        output.append(buffer, to_chars(buffer, buffer + sizeof(buffer), value / divisor).ptr);
+    }
+
+    /**
+     * @brief Escreve uma linha "nome{labels} valor" (labels pode ser vazio).
+     */
+    static void appendSample(pmr::string &output, string_view name, string_view labels, uint64_t value)
+    {
+        output.append(name);
+
+        if (!labels.empty())
+        {
+            output.append("{").append(labels).append("}");
+        }
+
+        output.push_back(' ');
+        appendInteger(output, value);
+        output.push_back('\n');
+    }
+
+    /**
+     * @brief Marca a thread corrente como uma thread de request ativa enquanto o objeto existir.
+     */
+    class ActiveHandler
+    {
+    public:
+        ActiveHandler()
+        {
+            activeHandlers.fetch_add(1, memory_order_relaxed);
+        }
+
+        ~ActiveHandler()
+        {
+            activeHandlers.fetch_sub(1, memory_order_relaxed);
+        }
+
+        ActiveHandler(const ActiveHandler &) = delete;
+        ActiveHandler &operator=(const ActiveHandler &) = delete;
+    };
+
+    /**
+     * @brief Escreve uma série do tipo summary (p50, p99, p999, _sum e _count) com os labels informados.
+     *
+     * @param divisor Divisor aplicado aos valores do histograma (1e9 converte nanossegundos em segundos; 1 mantém contagens).
+     */
+    static void appendSummary(pmr::string &output, string_view name, const LatencyHistogram &histogram, string_view labelsPrefix, string_view label, string_view labelsSuffix, double divisor = 1e9)
+    {
+        static constexpr array<pair<const char *, double>, 3> QUANTILES = {{{"0.5", 0.5}, {"0.99", 0.99}, {"0.999", 0.999}}};
+
+        bool hasLabels = !labelsPrefix.empty() || !label.empty() || !labelsSuffix.empty();
+
+        for (const auto &[quantileLabel, quantile] : QUANTILES)
+        {
+            output.append(name).push_back('{');
+            output.append(labelsPrefix).append(label).append(labelsSuffix).append(hasLabels ? ",quantile=\"" : "quantile=\"").append(quantileLabel).append("\"} ");
+            appendScaled(output, histogram.getPercentile(quantile), divisor);
+            output.push_back('\n');
+        }
+
+        output.append(name).append("_sum");
+        appendLabels(output, hasLabels, labelsPrefix, label, labelsSuffix);
+        appendScaled(output, histogram.getSum(), divisor);
+        output.push_back('\n');
+
+        output.append(name).append("_count");
+        appendLabels(output, hasLabels, labelsPrefix, label, labelsSuffix);
+        appendInteger(output, histogram.getCount());
+        output.push_back('\n');
+    }
+
+private:
+    static void appendLabels(pmr::string &output, bool hasLabels, string_view labelsPrefix, string_view label, string_view labelsSuffix)
+    {
+        if (hasLabels)
+        {
+            output.push_back('{');
+            output.append(labelsPrefix).append(label).append(labelsSuffix).push_back('}');
+        }
+
+        output.push_back(' ');
+    }
+
+    static constexpr size_t ENDPOINTS = static_cast<size_t>(MetricsEndpoint::COUNT);
+    static constexpr size_t CALLS = static_cast<size_t>(ProcessorCall::COUNT);
+    static constexpr size_t DECISIONS = static_cast<size_t>(RoutingDecision::COUNT);
+    static constexpr size_t PHASES = static_cast<size_t>(CurlPhase::COUNT);
+
+    static constexpr array<const char *, ENDPOINTS> ENDPOINT_LABELS = {"/payments", "/payments-summary", "/purge-payments", "/admin/partitions", "/admin/partitions/drop", "/admin/trace", "/metrics", "/admin/config", "other"};
+    static constexpr array<const char *, CALLS> CALL_LABELS = {"payments", "payments-summary", "health-check"};
+    static constexpr array<const char *, DECISIONS> DECISION_LABELS = {"default", "fallback", "unavailable"};
+    static constexpr array<const char *, PHASES> PHASE_LABELS = {"namelookup", "connect", "pretransfer", "starttransfer", "total"};
+    static constexpr array<HttpStatus, 6> STATUSES = {HttpStatus::OK, HttpStatus::CREATED, HttpStatus::BAD_REQUEST, HttpStatus::NOT_FOUND, HttpStatus::INTERNAL_SERVER_ERROR, HttpStatus::SERVICE_UNAVAILABLE};
+
+    /**
+     * @brief Contador dos status fora de STATUSES (exportado com status="other", e não somado ao 500).
+     */
+    static constexpr size_t OTHER_STATUS = STATUSES.size();
+
+    template <typename Enum>
+    static size_t index(Enum value)
+    {
+        return static_cast<size_t>(value);
+    }
+
+    static size_t statusIndex(HttpStatus status)
+    {
+        for (size_t i = 0; i < STATUSES.size(); i++)
+        {
+            if (STATUSES[i] == status)
+            {
+                return i;
+            }
+        }
+
+        return OTHER_STATUS;
+    }
+
+    inline static array<LatencyHistogram, ENDPOINTS> requestLatency;
+    inline static array<array<atomic<uint64_t>, OTHER_STATUS + 1>, ENDPOINTS> responses{};
+    inline static array<array<LatencyHistogram, CALLS>, 2> processorLatency;
+    inline static array<array<atomic<uint64_t>, CALLS>, 2> processorErrors{};
+    inline static array<atomic<uint64_t>, DECISIONS> routingDecisions{};
+    inline static array<array<LatencyHistogram, PHASES>, 2> processorPhaseLatency;
+    inline static array<array<atomic<uint64_t>, 2>, 2> processorConnections{};
+    inline static atomic<uint64_t> activeHandlers{0};
+};
+
+#endif // GARNIZE_METRICS_H
@@ -0,0 +1,213 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file mpsc_ring_buffer.h
+ * @brief Fila circular limitada de múltiplos produtores e um consumidor (MPSCRingBuffer).
+ */
+
+#ifndef GARNIZE_MPSC_RING_BUFFER_H
+#define GARNIZE_MPSC_RING_BUFFER_H
+
+#include "common.h"
+
+/**
+ * @class MPSCRingBuffer
+ * @brief Fila circular limitada e lock-free com múltiplos produtores e um único consumidor.
+ *
+ * Implementação baseada no algoritmo de Dmitry Vyukov: cada slot possui um número de
+ * sequência que indica se ele está livre para escrita ou pronto para leitura. Os produtores
+ * disputam a posição de escrita com um compare-and-swap, sem mutex, e o único consumidor
+ * lê os slots em ordem.
+ *
+ * Os slots são pré-alocados na construção, então nenhuma alocação da fila acontece no caminho da request.
+ *
+ * @tparam T Tipo armazenado em cada slot.
+ */
+template <typename T>
+class MPSCRingBuffer
+{
+public:
+    /**
+     * @brief Constrói o ring buffer.
+     *
+     * @param capacity Número de slots. É arredondado para a próxima potência de 2.
+     */
+    explicit MPSCRingBuffer(size_t capacity) : slots(roundUpToPowerOfTwo(capacity)), mask(slots.size() - 1)
+    {
+        for (size_t i = 0; i < slots.size(); i++)
+        {
+            slots[i].sequence.store(i, memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Tenta inserir um item no buffer (pode ser chamado por várias threads).
+     *
+     * @param item O item a ser copiado para o slot.
+     * @return true se o item foi inserido, false se o buffer está cheio.
+     */
+    bool tryPush(const T &item)
+    {
+        Slot *slot;
+        size_t position = enqueuePosition.load(memory_order_relaxed);
+
+        while (true)
+        {
+            slot = &slots[position & mask];
+
+            size_t sequence = slot->sequence.load(memory_order_acquire);
+            intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+            if (difference == 0)
+            {
+                // Slot livre: tenta reservar a posição
+                if (enqueuePosition.compare_exchange_weak(position, position + 1, memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (difference < 0)
+            {
+                // O consumidor ainda não liberou esse slot: buffer cheio
+                return false;
+            }
+            else
+            {
+                // Outro produtor reservou a posição antes, recarrega
+                position = enqueuePosition.load(memory_order_relaxed);
+            }
+        }
+
+        slot->value = item;
+        slot->sequence.store(position + 1, memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * @brief Tenta remover um item do buffer (deve ser chamado somente pela thread consumidora).
+     *
+     * @param item Referência que recebe o item removido.
+     * @return true se um item foi removido, false se o buffer está vazio.
+     */
+    bool tryPop(T &item)
+    {
+        size_t position = dequeuePosition.load(memory_order_relaxed);
+        Slot &slot = slots[position & mask];
+
+        size_t sequence = slot.sequence.load(memory_order_acquire);
+
+        if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1) < 0)
+        {
+            return false;
+        }
+
+        item = std::move(slot.value);
+        slot.sequence.store(position + mask + 1, memory_order_release);
+
+        dequeuePosition.store(position + 1, memory_order_relaxed);
+
+        return true;
+    }
+
+    /**
+     * @brief Verifica se existe um item pronto para ser lido (somente a thread consumidora).
+     *
+     * @return true se o próximo slot ainda não foi publicado por nenhum produtor.
+     */
+    bool isEmpty() const
+    {
+        size_t position = dequeuePosition.load(memory_order_relaxed);
+        const Slot &slot = slots[position & mask];
+
+        return static_cast<intptr_t>(slot.sequence.load(memory_order_acquire)) - static_cast<intptr_t>(position + 1) < 0;
+    }
+
+    /**
+     * @brief Quantidade aproximada de itens no buffer (pode ser chamado de qualquer thread).
+     */
+    size_t size() const
+    {
+        size_t enqueued = enqueuePosition.load(memory_order_relaxed);
+        size_t dequeued = dequeuePosition.load(memory_order_relaxed);
+
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    /**
+     * @brief Capacidade total do buffer.
+     */
+    size_t capacity() const
+    {
+        return slots.size();
+    }
+
+private:
+    /**
+     * @brief Slot do buffer alinhado na linha de cache para evitar false sharing entre produtores.
+     */
+    struct alignas(64) Slot
+    {
+        atomic<size_t> sequence;
+        T value;
+    };
+
+    /**
+     * @brief Arredonda o valor para a próxima potência de 2 (mínimo 2).
+     */
+    static size_t roundUpToPowerOfTwo(size_t value)
+    {
+        size_t power = 2;
+
+        while (power < value)
+        {
+            power <<= 1;
+        }
+
+        return power;
+    }
+
+    /**
+     * @brief Slots pré-alocados.
+     */
+    vector<Slot> slots;
+
+    /**
+     * @brief Máscara para calcular o índice do slot (capacidade - 1).
+     */
+    const size_t mask;
+
+    /**
+     * @brief Próxima posição de escrita, disputada pelos produtores.
+     */
+    alignas(64) atomic<size_t> enqueuePosition{0};
+
+    /**
+     * @brief Próxima posição de leitura, alterada somente pelo consumidor.
+     */
+    alignas(64) atomic<size_t> dequeuePosition{0};
+};
+
+#endif // GARNIZE_MPSC_RING_BUFFER_H
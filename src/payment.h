@@ -0,0 +1,126 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file payment.h
+ * @brief Registro de pagamento e resumo por serviço (Payment / PaymentsSummary).
+ */
+
+#ifndef GARNIZE_PAYMENT_H
+#define GARNIZE_PAYMENT_H
+
+#include "common.h"
+
+/**
+ * @brief Estrutura que representa um pagamento.
+ *
+ * Registro compacto e trivialmente copiável (40 bytes): pode ser copiado para o ring buffer do
+ * PaymentsDatabaseWriter sem nenhuma alocação. As representações textuais (UUID e ISO 8601)
+ * só são geradas quando necessário.
+ */
+struct Payment
+{
+    /**
+     * @brief Bit de flags que indica se o pagamento foi pelo serviço 'default'.
+     */
+    static const uint8_t FLAG_DEFAULT_SERVICE = 1 << 0;
+
+    /**
+     * @brief Bit de flags que indica se esse pagamento foi processado por algum dos serviços.
+     */
+    static const uint8_t FLAG_PROCESSED = 1 << 1;
+
+    /**
+     * @brief Identificador único do pagamento (UUID binário de 16 bytes).
+     */
+    uint8_t correlationId[16];
+
+    /**
+     * @brief Data do pagamento em milissegundos desde a epoch (UTC).
+     */
+    int64_t requestedAt;
+
+    /**
+     * @brief Valor do pagamento em centavos.
+     */
+    int64_t amountInCents;
+
+    /**
+     * @brief Flags do pagamento (FLAG_DEFAULT_SERVICE, FLAG_PROCESSED).
+     */
+    uint8_t flags;
+
+    /**
+     * @brief Indica se o pagamento foi pelo serviço 'default'.
+     */
+    bool isDefaultService() const
+    {
+        return flags & FLAG_DEFAULT_SERVICE;
+    }
+
+    /**
+     * @brief Indica se esse pagamento foi processado por algum dos serviços.
+     */
+    bool isProcessed() const
+    {
+        return flags & FLAG_PROCESSED;
+    }
+
+    /**
+     * @brief Define as flags de serviço utilizado e de processamento.
+     *
+     * @param defaultService Se o serviço 'default' foi utilizado.
+     * @param processed Se o pagamento foi processado.
+     */
+    void setFlags(bool defaultService, bool processed)
+    {
+        flags = (defaultService ? FLAG_DEFAULT_SERVICE : 0) | (processed ? FLAG_PROCESSED : 0);
+    }
+};
+
+static_assert(is_trivially_copyable<Payment>::value, "Payment deve ser trivialmente copiável");
+
+/**
+ * @brief Estrutura que representa um resumo de estatísticas.
+ *
+ * Contém informações sobre o total de requisições e o valor total.
+ */
+struct Summary
+{
+    int totalRequests;
+    double totalAmount;
+};
+
+/**
+ * @brief Estrutura que representa um resumo de pagamentos.
+ *
+ * Contém estatísticas para o default e o fallback.
+ */
+struct PaymentsSummary
+{
+    Summary defaultStats;
+    Summary fallbackStats;
+};
+
+#endif // GARNIZE_PAYMENT_H
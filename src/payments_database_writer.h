@@ -0,0 +1,1113 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file payments_database_writer.h
+ * @brief Fila de escrita, spill em disco e thread de escrita dos pagamentos (PaymentsDatabaseWriter).
+ */
+
+#ifndef GARNIZE_PAYMENTS_DATABASE_WRITER_H
+#define GARNIZE_PAYMENTS_DATABASE_WRITER_H
+
+#include "common.h"
+#include "constants.h"
+#include "config.h"
+#include "mpsc_ring_buffer.h"
+#include "logger.h"
+#include "timer.h"
+#include "latency_histogram.h"
+#include "tracer.h"
+#include "sqlite_utils.h"
+#include "payment.h"
+#include "payments_utils.h"
+
+/**
+ * @brief Contadores da fila de escrita do PaymentsDatabaseWriter.
+ */
+struct WriterQueueStats
+{
+    /**
+     * @brief Pagamentos aguardando no ring buffer em memória.
+     */
+    size_t queueDepth;
+
+    /**
+     * @brief Capacidade do ring buffer em memória.
+     */
+    size_t queueCapacity;
+
+    /**
+     * @brief Pagamentos gravados em disco que ainda não foram persistidos no banco.
+     */
+    uint64_t spillPendingRecords;
+
+    /**
+     * @brief Quantidade de arquivos de segmento existentes.
+     */
+    size_t spillSegments;
+
+    /**
+     * @brief Total de pagamentos que já foram para o disco desde o início.
+     */
+    uint64_t spilledRecordsTotal;
+
+    /**
+     * @brief Total de bytes que já foram para o disco desde o início.
+     */
+    uint64_t spilledBytesTotal;
+};
+
+/**
+ * @class PaymentsSpillQueue
+ * @brief Fila em disco para os pagamentos que não couberam no ring buffer do PaymentsDatabaseWriter.
+ *
+ * Os pagamentos são gravados sequencialmente (bytes crus do struct Payment) em arquivos de segmento
+ * de tamanho fixo no diretório Constants::WRITER_SPILL_DIRECTORY. A thread de escrita consome os
+ * segmentos na ordem em que foram criados e apaga cada arquivo depois de lê-lo.
+ *
+ * Esse caminho só é usado quando o SQLite não acompanha o ritmo das requests, então um mutex é suficiente.
+ * Segmentos que sobraram de uma execução anterior são recuperados na construção.
+ */
+class PaymentsSpillQueue
+{
+public:
+    /**
+     * @brief Constrói a fila, criando o diretório e recuperando segmentos antigos.
+     *
+     * @param _directory Diretório dos arquivos de segmento.
+     * @param _segmentRecords Quantidade de pagamentos por segmento.
+     */
+    PaymentsSpillQueue(const string &_directory, uint32_t _segmentRecords) : directory(_directory), segmentRecords(_segmentRecords)
+    {
+        error_code errorCode;
+
+        filesystem::create_directories(directory, errorCode);
+
+        if (errorCode)
+        {
+            LOGGER::error("Erro ao criar o diretório de spill: ", errorCode.message());
+            return;
+        }
+
+        // Recupera segmentos que não foram consumidos na execução anterior (id do segmento, pagamentos)
+        vector<pair<uint64_t, uint64_t>> existingSegments;
+
+        for (const auto &entry : filesystem::directory_iterator(directory, errorCode))
+        {
+            string name = entry.path().filename().string();
+
+            if (name.rfind("segment-", 0) != 0)
+            {
+                continue;
+            }
+
+            // Arquivos que não seguem o nome "segment-<id>" (ex.: "segment-1.tmp") são ignorados, e não derrubam a inicialização
+            uint64_t segmentId;
+            const char *idBegin = name.data() + 8;
+            const char *idEnd = name.data() + name.size();
+            auto [idPointer, idError] = from_chars(idBegin, idEnd, segmentId);
+
+            if (idBegin == idEnd || idError != errc() || idPointer != idEnd)
+            {
+                LOGGER::error("Arquivo ignorado no diretório de spill: ", name);
+                continue;
+            }
+
+            error_code sizeError;
+            uintmax_t size = entry.file_size(sizeError);
+
+            if (sizeError)
+            {
+                LOGGER::error("Segmento do spill ignorado (", name, "): ", sizeError.message());
+                continue;
+            }
+
+            if (size > 0)
+            {
+                existingSegments.push_back({segmentId, size / sizeof(Payment)});
+            }
+        }
+
+        sort(existingSegments.begin(), existingSegments.end());
+
+        for (const auto &[segmentId, records] : existingSegments)
+        {
+            segments.push_back(segmentId);
+            pendingRecords.fetch_add(records);
+            nextSegmentId = segmentId + 1;
+        }
+
+        if (!segments.empty())
+        {
+            LOGGER::info("Recuperados ", pendingRecords.load(), " pagamentos do spill em disco");
+        }
+    }
+
+    /**
+     * @brief Fecha o segmento que está sendo escrito. Os arquivos continuam no disco para a próxima execução.
+     */
+    ~PaymentsSpillQueue()
+    {
+        if (writeFileDescriptor >= 0)
+        {
+            close(writeFileDescriptor);
+        }
+    }
+
+    /**
+     * @brief Grava um pagamento no final do segmento corrente.
+     *
+     * @param payment O pagamento a ser gravado.
+     * @return true se foi gravado, false em caso de erro de I/O.
+     */
+    bool append(const Payment &payment)
+    {
+        lock_guard<mutex> lock(mutexLock);
+
+        if (writeFileDescriptor < 0 || writeSegmentRecords >= segmentRecords)
+        {
+            if (!openNextSegment())
+            {
+                return false;
+            }
+        }
+
+        if (write(writeFileDescriptor, &payment, sizeof(Payment)) != static_cast<ssize_t>(sizeof(Payment)))
+        {
+            LOGGER::error("Erro ao gravar pagamento no spill em disco");
+            return false;
+        }
+
+        writeSegmentRecords++;
+
+        pendingRecords.fetch_add(1);
+        spilledRecordsTotal.fetch_add(1, memory_order_relaxed);
+        spilledBytesTotal.fetch_add(sizeof(Payment), memory_order_relaxed);
+
+        return true;
+    }
+
+    /**
+     * @brief Lê o segmento mais antigo, entrega os pagamentos em ordem e apaga o arquivo.
+     *
+     * Deve ser chamado somente pela thread de escrita. O arquivo só é apagado se `commit` retornar true;
+     * caso contrário o segmento volta para o início da fila.
+     *
+     * @param consumer Função chamada para cada pagamento do segmento.
+     * @param commit Função chamada depois do último pagamento para confirmar a persistência.
+     * @return size_t A quantidade de pagamentos persistidos (0 se não há segmentos ou se o commit falhou).
+     */
+    size_t drainOldestSegment(const function<void(const Payment &)> &consumer, const function<bool()> &commit)
+    {
+        uint64_t segmentId;
+
+        {
+            lock_guard<mutex> lock(mutexLock);
+
+            if (segments.empty())
+            {
+                return 0;
+            }
+
+            segmentId = segments.front();
+            segments.pop_front();
+
+            // Se é o segmento que está sendo escrito, fecha para que os próximos pagamentos vão para um novo
+            if (segmentId == writeSegmentId && writeFileDescriptor >= 0)
+            {
+                close(writeFileDescriptor);
+                writeFileDescriptor = -1;
+            }
+        }
+
+        string path = segmentPath(segmentId);
+
+        int fileDescriptor = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+
+        if (fileDescriptor < 0)
+        {
+            LOGGER::error("Erro ao abrir segmento do spill: ", path);
+            return 0;
+        }
+
+        size_t records = 0;
+        Payment payment;
+
+        while (read(fileDescriptor, &payment, sizeof(Payment)) == static_cast<ssize_t>(sizeof(Payment)))
+        {
+            consumer(payment);
+            records++;
+        }
+
+        close(fileDescriptor);
+
+        if (!commit())
+        {
+            lock_guard<mutex> lock(mutexLock);
+            segments.push_front(segmentId);
+
+            return 0;
+        }
+
+        unlink(path.c_str());
+
+        pendingRecords.fetch_sub(records);
+
+        return records;
+    }
+
+    /**
+     * @brief Descarta todos os segmentos (usado pelo purge dos pagamentos).
+     */
+    void clear()
+    {
+        lock_guard<mutex> lock(mutexLock);
+
+        if (writeFileDescriptor >= 0)
+        {
+            close(writeFileDescriptor);
+            writeFileDescriptor = -1;
+        }
+
+        for (uint64_t segmentId : segments)
+        {
+            unlink(segmentPath(segmentId).c_str());
+        }
+
+        segments.clear();
+        pendingRecords.store(0);
+    }
+
+    /**
+     * @brief Quantidade de pagamentos no disco aguardando a thread de escrita.
+     */
+    uint64_t getPendingRecords() const
+    {
+        return pendingRecords.load();
+    }
+
+    /**
+     * @brief Preenche os contadores do spill em WriterQueueStats.
+     *
+     * @param stats Estrutura que recebe os contadores.
+     */
+    void fillStats(WriterQueueStats &stats)
+    {
+        lock_guard<mutex> lock(mutexLock);
+
+        stats.spillPendingRecords = pendingRecords.load();
+        stats.spillSegments = segments.size();
+        stats.spilledRecordsTotal = spilledRecordsTotal.load(memory_order_relaxed);
+        stats.spilledBytesTotal = spilledBytesTotal.load(memory_order_relaxed);
+    }
+
+private:
+    /**
+     * @brief Retorna o caminho do arquivo de um segmento (ex.: database/spill/segment-000000000001).
+     */
+    string segmentPath(uint64_t segmentId) const
+    {
+        char name[32];
+        snprintf(name, sizeof(name), "segment-%012llu", static_cast<unsigned long long>(segmentId));
+
+        return directory + "/" + name;
+    }
+
+    /**
+     * @brief Fecha o segmento corrente e abre um novo no final da fila (chamado com o mutex travado).
+     */
+    bool openNextSegment()
+    {
+        if (writeFileDescriptor >= 0)
+        {
+            close(writeFileDescriptor);
+        }
+
+        writeSegmentId = nextSegmentId++;
+        writeSegmentRecords = 0;
+
+        string path = segmentPath(writeSegmentId);
+
+        writeFileDescriptor = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND | O_CLOEXEC, 0644);
+
+        if (writeFileDescriptor < 0)
+        {
+            LOGGER::error("Erro ao criar segmento do spill: ", path);
+            return false;
+        }
+
+        segments.push_back(writeSegmentId);
+
+        return true;
+    }
+
+    /**
+     * @brief Diretório dos arquivos de segmento.
+     */
+    string directory;
+
+    /**
+     * @brief Quantidade de pagamentos por segmento.
+     */
+    uint32_t segmentRecords;
+
+    /**
+     * @brief O mutex que protege os segmentos e o arquivo corrente.
+     */
+    mutex mutexLock;
+
+    /**
+     * @brief Segmentos ainda não consumidos, do mais antigo para o mais novo.
+     */
+    deque<uint64_t> segments;
+
+    /**
+     * @brief Próximo identificador de segmento.
+     */
+    uint64_t nextSegmentId = 1;
+
+    /**
+     * @brief Segmento que está sendo escrito.
+     */
+    uint64_t writeSegmentId = 0;
+
+    /**
+     * @brief Descritor do segmento que está sendo escrito (-1 se nenhum).
+     */
+    int writeFileDescriptor = -1;
+
+    /**
+     * @brief Pagamentos gravados no segmento corrente.
+     */
+    uint32_t writeSegmentRecords = 0;
+
+    /**
+     * @brief Pagamentos no disco aguardando a thread de escrita.
+     */
+    atomic<uint64_t> pendingRecords{0};
+
+    /**
+     * @brief Total de pagamentos que já foram para o disco.
+     */
+    atomic<uint64_t> spilledRecordsTotal{0};
+
+    /**
+     * @brief Total de bytes que já foram para o disco.
+     */
+    atomic<uint64_t> spilledBytesTotal{0};
+};
+
+/**
+ * @class PaymentsDatabaseWriter
+ * @brief Gerencia a escrita de pagamentos no banco de dados de forma segura e eficiente.
+ *
+ * Essa classe utiliza uma única thread dedicada para guardar em uma fila os pagamentos e a serem persistidos.
+ *
+ * As threads das requests publicam os pagamentos em um MPSCRingBuffer sem lock. A thread de escrita
+ * esvazia o buffer inserindo os pagamentos em lote (uma transação por lote) e, quando não há mais nada
+ * para escrever, dorme em um eventfd. Os produtores só escrevem no eventfd quando a thread está ociosa.
+ *
+ * O ring buffer é limitado: quando está cheio (SQLite lento), os pagamentos excedentes vão para o
+ * PaymentsSpillQueue em disco e são persistidos assim que o buffer em memória esvazia. Enquanto houver
+ * pagamentos no spill, os novos também vão para o disco, atrás deles: assim a ordem de chegada é mantida
+ * (buffer, depois spill) e o spill não fica esperando indefinidamente sob carga contínua. Os pagamentos de
+ * um lote cujo commit falhou também vão para o spill, em vez de serem descartados com o rollback.
+ */
+class PaymentsDatabaseWriter
+{
+public:
+    /**
+     * @brief Constrói um objeto PaymentsDatabaseWriter.
+     *
+     * @param _connectionPoolUtils O pool de conexões (escrita) com o banco de dados.
+     * @param _readConnectionPoolUtils O pool de conexões somente leitura, reiniciado junto no purge.
+     */
+    PaymentsDatabaseWriter(SQLiteConnectionPoolUtils &_connectionPoolUtils, SQLiteConnectionPoolUtils &_readConnectionPoolUtils)
+        : connectionPoolUtils(_connectionPoolUtils),
+          readConnectionPoolUtils(_readConnectionPoolUtils),
+          paymentsQueue(Config::get(ConfigKey::WRITER_QUEUE_CAPACITY)),
+          spillQueue(Constants::WRITER_SPILL_DIRECTORY, Constants::WRITER_SPILL_SEGMENT_RECORDS),
+          isRunning(true),
+          writerIsIdle(false)
+    {
+        eventFileDescriptor = eventfd(0, EFD_CLOEXEC);
+
+        if (eventFileDescriptor < 0)
+        {
+            LOGGER::error("Erro ao criar o eventfd do PaymentsDatabaseWriter");
+        }
+
+        batch.reserve(Constants::WRITER_BATCH_MAX);
+
+        threadWriter = thread([this]()
+                              { savePayments(); });
+    }
+
+    /**
+     * @brief Adiciona um pagamento à fila.
+     *
+     * Não utiliza mutex. Se o buffer estiver cheio, ou se ainda houver pagamentos no spill (que são mais
+     * antigos que o novo), o pagamento é gravado no spill em disco; se nem isso for possível, a thread
+     * acorda o escritor e cede a CPU até haver espaço no buffer.
+     *
+     * @param payment O pagamento a ser salvo no banco de dados.
+     */
+    void addPaymentToQueue(const Payment &payment)
+    {
+        TraceSpan span("writer.enqueue");
+
+        bool queued = spillQueue.getPendingRecords() == 0 && paymentsQueue.tryPush(payment);
+
+        if (!queued && !spillQueue.append(payment))
+        {
+            while (!paymentsQueue.tryPush(payment))
+            {
+                wakeUpWriter();
+                this_thread::yield();
+            }
+        }
+
+        // Garante que a publicação do slot seja vista antes de ler writerIsIdle (par com savePayments)
+        atomic_thread_fence(memory_order_seq_cst);
+
+        if (writerIsIdle.load(memory_order_relaxed))
+        {
+            wakeUpWriter();
+        }
+    }
+
+    /**
+     * @brief Destrói o objeto PaymentsDatabaseWriter.
+     *
+     * Para a thread dedicada e limpa a fila de pagamentos.
+     */
+    ~PaymentsDatabaseWriter()
+    {
+        stop();
+
+        if (eventFileDescriptor >= 0)
+        {
+            close(eventFileDescriptor);
+        }
+    }
+
+    /**
+     * @brief Apaga todos os pagamentos: os que estão na fila, no spill em disco e no banco.
+     *
+     * A operação é executada pela própria thread de escrita (única que escreve no banco), que descarta
+     * a fila, limpa o spill e troca o arquivo do banco com todas as conexões do pool fechadas.
+     * Bloqueia até a conclusão.
+     *
+     * @return bool Indica se a operação foi bem-sucedida.
+     */
+    bool purgePayments()
+    {
+        return runOnWriterThread([this]()
+                                 { return purge(); });
+    }
+
+    /**
+     * @brief Remove as partições de pagamentos que terminam antes do instante informado.
+     *
+     * Executado pela thread de escrita, entre dois lotes. Bloqueia até a conclusão.
+     *
+     * @param beforeMillis Instante (milissegundos desde a epoch).
+     * @return int A quantidade de partições removidas, ou -1 em caso de erro.
+     */
+    int dropPartitionsBefore(int64_t beforeMillis)
+    {
+        int dropped = -1;
+
+        runOnWriterThread([this, beforeMillis, &dropped]()
+                          {
+                              sqlite3 *database = connectionPoolUtils.getConnectionFromPool();
+
+                              if (database == nullptr)
+                              {
+                                  return false;
+                              }
+
+                              sqlite3_exec(database, "BEGIN", nullptr, nullptr, nullptr);
+
+                              dropped = PaymentsUtils::dropPartitionsBefore(database, beforeMillis);
+
+                              if (dropped < 0 || sqlite3_exec(database, "COMMIT", nullptr, nullptr, nullptr) != SQLITE_OK)
+                              {
+                                  sqlite3_exec(database, "ROLLBACK", nullptr, nullptr, nullptr);
+
+                                  dropped = -1;
+                              }
+
+                              connectionPoolUtils.returnConnectionToPool(database);
+
+                              // As partições removidas precisam ser recriadas se receberem pagamentos de novo
+                              knownPartitions.erase(knownPartitions.begin(), knownPartitions.lower_bound(PaymentsUtils::getPartition(beforeMillis).id));
+
+                              return dropped >= 0; });
+
+        return dropped;
+    }
+
+    /**
+     * @brief Retorna a profundidade da fila em memória e os contadores do spill em disco.
+     *
+     * @return WriterQueueStats Os contadores da fila de escrita.
+     */
+    WriterQueueStats getQueueStats()
+    {
+        WriterQueueStats stats;
+
+        stats.queueDepth = paymentsQueue.size();
+        stats.queueCapacity = paymentsQueue.capacity();
+
+        spillQueue.fillStats(stats);
+
+        return stats;
+    }
+
+    /**
+     * @brief Histograma da quantidade de pagamentos por transação.
+     */
+    const LatencyHistogram &getBatchSizes() const
+    {
+        return batchSizes;
+    }
+
+    /**
+     * @brief Histograma do tempo de commit de cada transação.
+     */
+    const LatencyHistogram &getCommitLatency() const
+    {
+        return commitLatency;
+    }
+
+    /**
+     * @brief Pool de conexões de escrita usado pela thread de escrita.
+     */
+    SQLiteConnectionPoolUtils &getConnectionPool()
+    {
+        return connectionPoolUtils;
+    }
+
+    /**
+     * @brief Para a thread dedicada depois de esvaziar a fila de pagamentos.
+     *
+     * Os pagamentos da fila são persistidos no SQLite ou, se o commit falhar, no spill em disco. Segmentos do
+     * spill que não puderem ser persistidos ficam no disco e são recuperados na próxima inicialização.
+     * Tarefas de runOnWriterThread que a thread não chegou a executar retornam false para quem as espera.
+     */
+    void stop()
+    {
+        {
+            lock_guard<mutex> lock(tasksMutex);
+            isRunning.store(false);
+        }
+
+        signalEventFileDescriptor();
+
+        if (threadWriter.joinable())
+        {
+            threadWriter.join();
+        }
+
+        lock_guard<mutex> lock(tasksMutex);
+
+        for (auto &[task, taskDone] : tasks)
+        {
+            taskDone->set_value(false);
+        }
+
+        tasks.clear();
+        tasksRequested.store(false);
+    }
+
+private:
+    /**
+     * @brief Função que é executada pela thread dedicada.
+     *
+     * Lê os dados da fila de pagamentos e os escreve no banco de dados.
+     */
+    void savePayments()
+    {
+        while (true)
+        {
+            if (tasksRequested.load())
+            {
+                runTasks();
+                continue;
+            }
+
+            if (!batch.empty() || !paymentsQueue.isEmpty())
+            {
+                writeBatch();
+                continue;
+            }
+
+            // O buffer em memória esvaziou: persiste o que foi para o disco, do segmento mais antigo ao mais novo.
+            // Os pagamentos novos vão para o spill até ele esvaziar, então o buffer não volta a passar na frente
+            if (spillQueue.getPendingRecords() > 0)
+            {
+                // Parando, um segmento que não foi persistido fica no disco e é recuperado na próxima inicialização
+                if (!writeSpilledSegment() && !isRunning.load())
+                {
+                    return;
+                }
+
+                continue;
+            }
+
+            if (!isRunning.load())
+            {
+                return; // Sai da thread se não estiver mais rodando e a fila estiver vazia
+            }
+
+            writerIsIdle.store(true, memory_order_relaxed);
+
+            // Par com a fence de addPaymentToQueue: ou o produtor vê writerIsIdle, ou nós vemos o pagamento
+            atomic_thread_fence(memory_order_seq_cst);
+
+            if (paymentsQueue.isEmpty() && spillQueue.getPendingRecords() == 0 && !tasksRequested.load() && isRunning.load())
+            {
+                uint64_t counter;
+
+                if (read(eventFileDescriptor, &counter, sizeof(counter)) < 0 && errno != EINTR)
+                {
+                    LOGGER::error("Erro ao aguardar o eventfd do PaymentsDatabaseWriter");
+                }
+            }
+
+            writerIsIdle.store(false, memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief Grava em uma única transação os pagamentos disponíveis no buffer, até Constants::WRITER_BATCH_MAX.
+     *
+     * O restante fica para o próximo lote, depois das tarefas de manutenção pendentes (ver savePayments).
+     * Os pagamentos retirados do buffer ficam em `batch` até o commit: se ele falhar, vão para o spill em disco.
+     */
+    void writeBatch()
+    {
+        sqlite3 *database = acquireConnection();
+
+        if (database == nullptr)
+        {
+            return;
+        }
+
+        if (batch.empty())
+        {
+            Payment payment;
+
+            while (batch.size() < Constants::WRITER_BATCH_MAX && paymentsQueue.tryPop(payment))
+            {
+                batch.push_back(payment);
+            }
+        }
+
+        sqlite3_exec(database, "BEGIN", nullptr, nullptr, nullptr);
+
+        for (const Payment &payment : batch)
+        {
+            insertPayment(database, payment);
+        }
+
+        bool committed = commitBatch(database);
+
+        connectionPoolUtils.returnConnectionToPool(database);
+
+        if (committed)
+        {
+            batch.clear();
+        }
+        else
+        {
+            spillFailedBatch();
+        }
+    }
+
+    /**
+     * @brief Move para o spill em disco os pagamentos de um lote cujo commit falhou.
+     *
+     * O spill é persistido (com novas tentativas) quando o buffer esvaziar. O que não puder ser gravado em
+     * disco continua em `batch` e é tentado de novo no próximo lote, depois de Constants::WRITER_RETRY_DELAY_MS.
+     */
+    void spillFailedBatch()
+    {
+        size_t spilled = 0;
+
+        while (spilled < batch.size() && spillQueue.append(batch[spilled]))
+        {
+            spilled++;
+        }
+
+        batch.erase(batch.begin(), batch.begin() + spilled);
+
+        LOGGER::error("Lote não persistido: ", spilled, " pagamentos foram para o spill em disco, ", batch.size(), " serão tentados de novo");
+
+        this_thread::sleep_for(chrono::milliseconds(Constants::WRITER_RETRY_DELAY_MS));
+    }
+
+    /**
+     * @brief Obtém a conexão de escrita do lote.
+     *
+     * Se o pool não entregar uma conexão, espera Constants::WRITER_RETRY_DELAY_MS e retorna nullptr:
+     * os pagamentos continuam na fila (ou no spill) e o lote é tentado de novo por savePayments.
+     */
+    sqlite3 *acquireConnection()
+    {
+        sqlite3 *database = connectionPoolUtils.getConnectionFromPool();
+
+        if (database == nullptr)
+        {
+            LOGGER::error("Sem conexão de escrita, tentando de novo em ", Constants::WRITER_RETRY_DELAY_MS, " ms");
+
+            this_thread::sleep_for(chrono::milliseconds(Constants::WRITER_RETRY_DELAY_MS));
+        }
+
+        return database;
+    }
+
+    /**
+     * @brief Insere um pagamento, criando antes a tabela da partição se ela ainda não existir.
+     *
+     * @param database A conexão de escrita.
+     * @param payment O pagamento.
+     */
+    void insertPayment(sqlite3 *database, const Payment &payment)
+    {
+        TraceSpan span("sqlite.insert");
+
+        batchRecords++;
+
+        PaymentsPartition partition = PaymentsUtils::getPartition(payment.requestedAt);
+
+        if (knownPartitions.count(partition.id) == 0 && PaymentsUtils::createPartition(database, partition))
+        {
+            knownPartitions.insert(partition.id);
+        }
+
+        // Um pagamento que não foi gravado (ex.: partição que não pôde ser criada) não entra no rollup, para o resumo bater com a partição
+        if (PaymentsUtils::insert(database, payment, payment.isDefaultService(), payment.isProcessed()) && payment.isProcessed())
+        {
+            PaymentsRollup &rollup = pendingRollups[{payment.requestedAt / 1000, payment.isDefaultService()}];
+
+            rollup.records++;
+            rollup.amountInCents += payment.amountInCents;
+        }
+    }
+
+    /**
+     * @brief Grava os rollups do lote e faz o commit da transação (ou rollback em caso de erro).
+     *
+     * @param database A conexão de escrita, com a transação do lote em andamento.
+     * @return bool Indica se o commit foi bem-sucedido.
+     */
+    bool commitBatch(sqlite3 *database)
+    {
+        TraceSpan span("sqlite.commit");
+
+        auto start = chrono::steady_clock::now();
+
+        bool success = PaymentsUtils::upsertRollups(database, pendingRollups) && sqlite3_exec(database, "COMMIT", nullptr, nullptr, nullptr) == SQLITE_OK;
+
+        commitLatency.record(chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+        batchSizes.record(batchRecords);
+
+        pendingRollups.clear();
+        batchRecords = 0;
+
+        if (!success)
+        {
+            LOGGER::error("Erro ao fazer commit do lote de pagamentos: ", sqlite3_errmsg(database));
+
+            sqlite3_exec(database, "ROLLBACK", nullptr, nullptr, nullptr);
+
+            // O rollback também desfaz as partições criadas no lote
+            knownPartitions.clear();
+        }
+
+        return success;
+    }
+
+    /**
+     * @brief Entrega uma tarefa de manutenção (purge, remoção de partições) para a thread de escrita e espera o resultado.
+     *
+     * @param task A tarefa, executada na thread de escrita.
+     * @return bool O retorno da tarefa, ou false se a thread de escrita já foi parada.
+     */
+    bool runOnWriterThread(const function<bool()> &task)
+    {
+        promise<bool> taskDone;
+        future<bool> taskResult = taskDone.get_future();
+
+        {
+            lock_guard<mutex> lock(tasksMutex);
+
+            // Sem a thread de escrita ninguém executaria a tarefa e o future.get() bloquearia para sempre
+            if (!isRunning.load())
+            {
+                LOGGER::error("Tarefa recusada: a thread de escrita já foi parada");
+                return false;
+            }
+
+            tasks.push_back({task, &taskDone});
+            tasksRequested.store(true);
+        }
+
+        signalEventFileDescriptor();
+
+        return taskResult.get();
+    }
+
+    /**
+     * @brief Executa as tarefas pendentes de runOnWriterThread (executado na thread de escrita).
+     *
+     * Uma tarefa que lança exceção (ex.: erro do filesystem na troca do arquivo) é registrada no log e
+     * retorna false: quem espera o resultado não fica bloqueado e a thread de escrita continua viva.
+     */
+    void runTasks()
+    {
+        vector<pair<function<bool()>, promise<bool> *>> pendingTasks;
+
+        {
+            lock_guard<mutex> lock(tasksMutex);
+
+            pendingTasks.swap(tasks);
+            tasksRequested.store(false);
+        }
+
+        for (auto &[task, taskDone] : pendingTasks)
+        {
+            bool success = false;
+
+            try
+            {
+                success = task();
+            }
+            catch (const exception &exception)
+            {
+                LOGGER::error("Erro ao executar tarefa na thread de escrita: ", exception.what());
+            }
+            catch (...)
+            {
+                LOGGER::error("Erro desconhecido ao executar tarefa na thread de escrita");
+            }
+
+            taskDone->set_value(success);
+        }
+    }
+
+    /**
+     * @brief Apaga a fila, o spill e o banco de pagamentos (executado na thread de escrita).
+     *
+     * @return bool Indica se a operação foi bem-sucedida.
+     */
+    bool purge()
+    {
+        Timer timer;
+
+        Payment discarded;
+
+        while (paymentsQueue.tryPop(discarded))
+        {
+        }
+
+        batch.clear();
+
+        spillQueue.clear();
+
+        // Fecha os dois pools (leitura e escrita) antes de trocar o arquivo do banco
+        bool success = readConnectionPoolUtils.resetConnections([this]()
+                                                                { return connectionPoolUtils.resetConnections([]()
+                                                                                                              { return PaymentsUtils::recreateDatabaseFile(Constants::DATABASE_PAYMENTS); }); });
+
+        knownPartitions.clear();
+
+        return success;
+    }
+
+    /**
+     * @brief Persiste o segmento mais antigo do spill em disco em uma única transação.
+     *
+     * Se o commit falhar, o segmento volta para o início da fila e a thread espera Constants::WRITER_RETRY_DELAY_MS
+     * antes da próxima tentativa, para não repetir a transação sem pausa enquanto o banco estiver falhando.
+     *
+     * @return bool Indica se o segmento foi persistido.
+     */
+    bool writeSpilledSegment()
+    {
+        sqlite3 *database = acquireConnection();
+
+        if (database == nullptr)
+        {
+            return false;
+        }
+
+        sqlite3_exec(database, "BEGIN", nullptr, nullptr, nullptr);
+
+        auto insertSpilledPayment = [this, database](const Payment &payment)
+        {
+            insertPayment(database, payment);
+        };
+
+        bool committed = true;
+
+        auto commit = [this, database, &committed]()
+        {
+            committed = commitBatch(database);
+
+            return committed;
+        };
+
+        size_t records = spillQueue.drainOldestSegment(insertSpilledPayment, commit);
+
+        if (records > 0)
+        {
+            LOGGER::info("Persistidos ", records, " pagamentos do spill em disco");
+        }
+
+        connectionPoolUtils.returnConnectionToPool(database);
+
+        if (!committed)
+        {
+            LOGGER::error("Segmento do spill não persistido, tentando de novo em ", Constants::WRITER_RETRY_DELAY_MS, " ms");
+
+            this_thread::sleep_for(chrono::milliseconds(Constants::WRITER_RETRY_DELAY_MS));
+        }
+
+        return committed;
+    }
+
+    /**
+     * @brief Acorda a thread de escrita se ela estiver ociosa (somente um produtor escreve no eventfd).
+     */
+    void wakeUpWriter()
+    {
+        if (writerIsIdle.exchange(false))
+        {
+            signalEventFileDescriptor();
+        }
+    }
+
+    /**
+     * @brief Incrementa o contador do eventfd, desbloqueando o read da thread de escrita.
+     */
+    void signalEventFileDescriptor()
+    {
+        uint64_t one = 1;
+
+        if (write(eventFileDescriptor, &one, sizeof(one)) < 0)
+        {
+            LOGGER::error("Erro ao sinalizar o eventfd do PaymentsDatabaseWriter");
+        }
+    }
+
+    /**
+     * @brief  O pool de conexões com o banco de dados.
+     */
+    SQLiteConnectionPoolUtils &connectionPoolUtils;
+
+    /**
+     * @brief O pool de conexões somente leitura com o banco de dados.
+     */
+    SQLiteConnectionPoolUtils &readConnectionPoolUtils;
+
+    /**
+     * @brief A thread dedicada para escrever os dados.
+     */
+    thread threadWriter;
+
+    /**
+     * @brief  A fila lock-free de dados a serem escritos.
+     */
+    MPSCRingBuffer<Payment> paymentsQueue;
+
+    /**
+     * @brief A fila em disco para os pagamentos que não couberam no ring buffer.
+     */
+    PaymentsSpillQueue spillQueue;
+
+    /**
+     * @brief eventfd em que a thread de escrita dorme quando o buffer está vazio.
+     */
+    int eventFileDescriptor;
+
+    /**
+     * @brief  Indica se a thread dedicada está em execução.
+     */
+    atomic<bool> isRunning;
+
+    /**
+     * @brief Indica se a thread de escrita está (ou vai ficar) bloqueada no eventfd.
+     */
+    atomic<bool> writerIsIdle;
+
+    /**
+     * @brief Indica que existem tarefas de runOnWriterThread pendentes.
+     */
+    atomic<bool> tasksRequested{false};
+
+    /**
+     * @brief O mutex que protege tasks.
+     */
+    mutex tasksMutex;
+
+    /**
+     * @brief Tarefas aguardando a thread de escrita, com a promise de cada resultado.
+     */
+    vector<pair<function<bool()>, promise<bool> *>> tasks;
+
+    /**
+     * @brief Pagamentos retirados do buffer para o lote em andamento (acessado somente pela thread de escrita).
+     */
+    vector<Payment> batch;
+
+    /**
+     * @brief Partições que já existem no banco (acessado somente pela thread de escrita).
+     */
+    set<int64_t> knownPartitions;
+
+    /**
+     * @brief Rollups por (segundo, serviço 'default') do lote em andamento, gravados no commit (acessado somente pela thread de escrita).
+     */
+    map<pair<int64_t, bool>, PaymentsRollup> pendingRollups;
+
+    /**
+     * @brief Pagamentos inseridos na transação em andamento.
+     */
+    uint64_t batchRecords = 0;
+
+    /**
+     * @brief Distribuição da quantidade de pagamentos por transação.
+     */
+    LatencyHistogram batchSizes;
+
+    /**
+     * @brief Distribuição do tempo de commit (rollups + COMMIT) de cada transação.
+     */
+    LatencyHistogram commitLatency;
+};
+
+#endif // GARNIZE_PAYMENTS_DATABASE_WRITER_H
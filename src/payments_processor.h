@@ -0,0 +1,470 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file payments_processor.h
+ * @brief Regras dos endpoints de pagamentos (PaymentsProcessor).
+ */
+
+#ifndef GARNIZE_PAYMENTS_PROCESSOR_H
+#define GARNIZE_PAYMENTS_PROCESSOR_H
+
+#include "common.h"
+#include "constants.h"
+#include "config.h"
+#include "logger.h"
+#include "timer.h"
+#include "request_arena.h"
+#include "http_status.h"
+#include "metrics.h"
+#include "tracer.h"
+#include "curl_utils.h"
+#include "json_parser.h"
+#include "http.h"
+#include "time_utils.h"
+#include "uuid_generator.h"
+#include "sqlite_utils.h"
+#include "health_check.h"
+#include "payment.h"
+#include "json_serializer.h"
+#include "payments_utils.h"
+#include "payments_database_writer.h"
+#include "peer_summary.h"
+
+/**
+ * @brief Classe responsável por lidar com pagamentos.
+ *
+ * Essa classe fornece métodos estáticos para lidar com requisições de pagamento, incluindo
+ * a criação de pagamentos e o cálculo do total de pagamentos em um período.
+ */
+class PaymentsProcessor
+{
+public:
+    /**
+     * @brief Lida com requisições POST /payments.
+     *
+     * Esse método verifica se a requisição é válida, parseia o corpo da requisição,
+     * cria um pagamento e o armazena na fila compartilhada entre as threads.
+     *
+     * @param body Corpo da requisição (view para o buffer da conexão).
+     * @param paymentsDatabaseWriter Classe que gerencia a escrita de pagamentos no banco de dados de forma segura e eficiente.
+     * @return Resposta HTTP.
+     */
+    static HttpResponse payment(string_view body, PaymentsDatabaseWriter &paymentsDatabaseWriter)
+    {
+        Timer timer;
+
+        HttpResponse response;
+
+        if (body.find(Constants::KEY_CORRELATION_ID) == string_view::npos)
+        {
+            // Retorna um json de request invalida (faltou parametro 'correlationId')
+            return HttpResponse(HttpStatus::BAD_REQUEST, "{ \"message\":\"Invalid params. Missing 'correlationId'\" }");
+        }
+
+        if (body.find(Constants::KEY_AMOUNT) == string_view::npos)
+        {
+            // Retorna um json de request invalida (faltou parametro 'amount')
+            return HttpResponse(HttpStatus::BAD_REQUEST, "{ \"message\":\"Invalid params. Missing 'amount'\" }");
+        }
+
+        // Parse do corpo da requisição
+        JsonObject json;
+
+        Payment payment;
+        bool validPayment;
+
+        {
+            TraceSpan span("json.parse");
+
+            validPayment = JsonParser::parse(body, json) && json.getAmountInCents(Constants::KEY_AMOUNT, payment.amountInCents);
+        }
+
+        if (!validPayment)
+        {
+            // Retorna um json de request invalida (JSON ou 'amount' inválido)
+            return HttpResponse(HttpStatus::BAD_REQUEST, "{ \"message\":\"Invalid params. Invalid JSON or 'amount'\" }");
+        }
+
+        /**
+         * @todo Descomentar linha abaixo pois o valor vai ser enviado na request
+         */
+        // payment.correlationId = json.at(Constants::KEY_CORRELATION_ID);
+        payment.requestedAt = TimeUtils::getEpochMillisUTC();
+        UUIDGenerator::createUUID(payment.correlationId, payment.requestedAt);
+        payment.flags = 0;
+
+        // O JSON do pagamento é gerado uma única vez, na pilha, e reutilizado no payload e na resposta
+        char payloadBuffer[JsonSerializer<Payment>::MAX_SIZE];
+        const string_view payload = PaymentsJSONConverter::write(payment, payloadBuffer);
+
+        auto sendPaymentRequestToFn = [&](bool useDefault, const string &URL, CURLcode &responseCode)
+        {
+            LOGGER::info("Usando", useDefault ? " 'default' " : " 'fallback' ", "payment service: ", URL);
+
+            pmr::string responseBuffer(RequestArena::getResource());
+
+            CURL *curl = CURLUtils::setupCurlForPostRequest(URL, payload, responseBuffer);
+
+            if (curl)
+            {
+                struct curl_slist *headers = NULL;
+                headers = curl_slist_append(headers, "Content-Type: application/json");
+                curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+
+                // Faz request para o servico
+                responseCode = CURLUtils::perform(curl, useDefault, ProcessorCall::PAYMENTS);
+
+                if (responseCode != CURLE_OK)
+                {
+                    LOGGER::error("Erro ao fazer curl request para /payments", useDefault ? " 'default' : " : " 'fallback' : ", curl_easy_strerror(responseCode));
+
+                    // O pagamento não foi processado nem enfileirado: o cliente precisa saber para tentar de novo
+                    response.status = HttpStatus::SERVICE_UNAVAILABLE;
+                    response.body.assign("{ \"message\": \"Payment processor indisponível\"}");
+                }
+                else
+                {
+
+                    long HTTP_RESPONSE_CODE = 0;
+                    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &HTTP_RESPONSE_CODE);
+                    bool requestOK = (HTTP_RESPONSE_CODE == 200);
+
+                    LOGGER::info("Service /payments", useDefault ? " 'default' " : " 'fallback' ", "respondeu com o código:  ", HTTP_RESPONSE_CODE);
+
+                    payment.setFlags(useDefault, requestOK);
+
+                    // Adiciona na fila do PaymentsDatabaseWriter para ser persistido
+                    paymentsDatabaseWriter.addPaymentToQueue(payment);
+
+                    if (requestOK)
+                    {
+
+                        // A mensagem continua escapada, então pode ser copiada direto para o JSON de resposta
+                        JsonObject jsonResponse;
+                        string_view message;
+
+                        if (!JsonParser::parse(responseBuffer, jsonResponse) || !jsonResponse.getString("message", message))
+                        {
+                            LOGGER::error("Resposta inesperada do serviço /payments: ", responseBuffer);
+                        }
+
+                        // Os argumentos abaixo alocam: só são calculados se o nível INFO foi compilado
+                        if constexpr (LOGGER::isEnabled(LogLevel::INFO))
+                        {
+                            LOGGER::info("Inserindo Payment(correlationId=", UUIDGenerator::toString(payment.correlationId),
+                                         ", amount=", PaymentsJSONConverter::formatAmount(payment.amountInCents),
+                                         ", requestedAt=", TimeUtils::formatTimestampUTC(payment.requestedAt),
+                                         ", defaultService=", useDefault, ", processed=", requestOK, ")");
+                        }
+
+                        // Ambas as strings estão na RequestArena: o move não copia o JSON
+                        response.status = HttpStatus::CREATED;
+                        response.body = PaymentsJSONConverter::toJsonString(PaymentResponse{message, payload});
+                    }
+                    else
+                    {
+                        response.status = HttpStatus::BAD_REQUEST;
+                        response.body.assign("Erro na request payload: ").append(payload);
+                    }
+                }
+
+                curl_easy_cleanup(curl);
+                curl_slist_free_all(headers);
+            }
+            else
+            {
+                responseCode = CURLE_FAILED_INIT;
+
+                response.status = HttpStatus::INTERNAL_SERVER_ERROR;
+                response.body.assign("{ \"message\": \"Erro interno do servidor\"}");
+            }
+        };
+
+        CURLcode responseCode;
+        bool useDefaultService, useFallbackService;
+
+        {
+            TraceSpan span("routing.decision");
+
+            useDefaultService = HealthCheckUtils::useDefault();
+            useFallbackService = !useDefaultService ? HealthCheckUtils::useFallback() : false;
+        }
+
+        Metrics::recordRouting(useDefaultService ? RoutingDecision::DEFAULT : useFallbackService ? RoutingDecision::FALLBACK
+                                                                                                 : RoutingDecision::UNAVAILABLE);
+
+        if (useDefaultService)
+        {
+            sendPaymentRequestToFn(true, string(Constants::PROCESSOR_DEFAULT + Constants::PAYMENTS_ENDPOINT), responseCode);
+        }
+        else
+        {
+            if (useFallbackService)
+            {
+                sendPaymentRequestToFn(false, string(Constants::PROCESSOR_FALLBACK + Constants::PAYMENTS_ENDPOINT), responseCode);
+            }
+            else
+            {
+
+                /**
+                 * @todo Débito Técnico - Implementar uma lógica para tratar esse cenário
+                 */
+                LOGGER::error("Nenhum serviço está funcionando");
+
+                response.status = HttpStatus::INTERNAL_SERVER_ERROR;
+                response.body.assign("{ \"message\": \"Erro interno do servidor\"}");
+            }
+        }
+
+        return response;
+    }
+
+    /**
+     * @brief Lida com requisições GET /payments-summary.
+     *
+     * Esse método verifica se a query string é válida, calcula o total de pagamentos
+     * no período especificado e retorna a resposta.
+     *
+     * @param query Query string da requisição (view para o buffer da conexão).
+     * @param readConnectionPoolUtils Pool de conexões somente leitura do banco de pagamentos.
+     *
+     * @return Resposta HTTP.
+     */
+    static HttpResponse payments_summary(string_view query, SQLiteConnectionPoolUtils &readConnectionPoolUtils)
+    {
+        Timer timer;
+
+        // Parse da query string (os valores continuam URL-encoded, o parseTimestampUTC decodifica)
+        string_view from, to;
+
+        if (!HttpRequestParser::getQueryParam(query, "from", from))
+        {
+            return HttpResponse(HttpStatus::BAD_REQUEST, "{ \"message\":\"Invalid params. Missing 'from'\" }");
+        }
+
+        if (!HttpRequestParser::getQueryParam(query, "to", to))
+        {
+            return HttpResponse(HttpStatus::BAD_REQUEST, "{ \"message\":\"Invalid params. Missing 'to'\" }");
+        }
+
+        PaymentsSummary paymentSummary{};
+
+        // Resumo local lido sob demanda (somente se algum processador não responder), em um único snapshot
+        // e somado aos resumos das outras réplicas (PeerSummaryService)
+        bool hasLocalSummary = false;
+        bool localSummaryAvailable = true;
+        PaymentsSummary localSummary{};
+
+        auto getLocalSummary = [&]() -> const PaymentsSummary &
+        {
+            if (!hasLocalSummary)
+            {
+                hasLocalSummary = true;
+
+                int64_t fromMillis, toMillis;
+
+                if (!TimeUtils::parseTimestampUTC(from, fromMillis) || !TimeUtils::parseTimestampUTC(to, toMillis))
+                {
+                    LOGGER::error("Parâmetros 'from' / 'to' inválidos para o resumo local: ", query);
+
+                    return localSummary;
+                }
+
+                // Os peers calculam seus resumos em paralelo com o resumo local. O prazo só começa a contar depois do
+                // resumo local: uma consulta local lenta não pode consumir o tempo de espera das respostas dos peers
+                vector<int> peerSockets = PeerSummaryService::sendRequests(fromMillis, toMillis);
+
+                localSummaryAvailable = PaymentsUtils::getSummary(readConnectionPoolUtils, fromMillis, toMillis, localSummary);
+
+                auto deadline = chrono::steady_clock::now() + chrono::milliseconds(Config::get(ConfigKey::PEER_DEADLINE_MS));
+
+                PeerSummaryService::collectResponses(peerSockets, deadline, localSummary);
+            }
+
+            return localSummary;
+        };
+
+        /**
+         * @todo Débito técnico - Não pode consultar o backend, recuperar da base local (evitando phantom reads usar transaction)
+         */
+        auto sendPaymentsSummaryRequestFn = [&](const string &URL, bool defaultService)
+        {
+            string serviceURL = URL + Constants::PAYMENTS_SUMMARY_ADMIN_ENDPOINT + "?";
+            serviceURL.append(query);
+
+            pmr::string responseBuffer(RequestArena::getResource());
+
+            CURL *curl = CURLUtils::setupCurlForGetRequest(serviceURL, responseBuffer);
+
+            if (curl)
+            {
+                struct curl_slist *headers = NULL;
+                headers = curl_slist_append(headers, "Content-Type: application/json");
+                headers = curl_slist_append(headers, Constants::X_RINHA_TOKEN.c_str());
+                curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+
+                CURLcode responseCode = CURLUtils::perform(curl, defaultService, ProcessorCall::PAYMENTS_SUMMARY);
+
+                if (responseCode != CURLE_OK)
+                {
+                    LOGGER::error("Erro ao fazer curl request para /admin/payments-summary ", defaultService ? "'default'" : "'fallback'", curl_easy_strerror(responseCode));
+                }
+                else
+                {
+
+                    long HTTP_RESPONSE_CODE = 0;
+                    curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &HTTP_RESPONSE_CODE);
+
+                    LOGGER::info("Endpoint /admin/payments-summary ", defaultService ? "'default'" : "'fallback'", " respondeu com o código:  ", HTTP_RESPONSE_CODE);
+
+                    JsonObject jsonResponse;
+                    int64_t totalRequests;
+                    double totalAmount;
+
+                    if (HTTP_RESPONSE_CODE == 200 && JsonParser::parse(responseBuffer, jsonResponse) &&
+                        jsonResponse.getInt64("totalRequests", totalRequests) && jsonResponse.getDouble("totalAmount", totalAmount))
+                    {
+                        if (defaultService)
+                        {
+                            paymentSummary.defaultStats.totalRequests = static_cast<int>(totalRequests);
+                            paymentSummary.defaultStats.totalAmount = totalAmount;
+                        }
+                        else
+                        {
+                            paymentSummary.fallbackStats.totalRequests = static_cast<int>(totalRequests);
+                            paymentSummary.fallbackStats.totalAmount = totalAmount;
+                        }
+                    }
+                    else
+                    {
+                        if (defaultService)
+                        {
+                            paymentSummary.defaultStats = getLocalSummary().defaultStats;
+                        }
+                        else
+                        {
+                            paymentSummary.fallbackStats = getLocalSummary().fallbackStats;
+                        }
+                    }
+                }
+
+                curl_easy_cleanup(curl);
+                curl_slist_free_all(headers);
+            }
+        };
+
+        sendPaymentsSummaryRequestFn(Constants::PROCESSOR_DEFAULT, true);
+        sendPaymentsSummaryRequestFn(Constants::PROCESSOR_FALLBACK, false);
+
+        // Sem conexão de leitura o resumo local estaria incompleto: melhor o cliente tentar de novo
+        if (!localSummaryAvailable)
+        {
+            return HttpResponse(HttpStatus::SERVICE_UNAVAILABLE, "{\"success\": false}");
+        }
+
+        char summaryBuffer[JsonSerializer<PaymentsSummary>::MAX_SIZE];
+
+        return HttpResponse(HttpStatus::OK, PaymentsJSONConverter::write(paymentSummary, summaryBuffer));
+    }
+
+    /**
+     * @brief Lista as partições da tabela de pagamentos com a janela de tempo e a quantidade de registros.
+     *
+     * @param readConnectionPoolUtils Pool de conexões somente leitura.
+     * @return HttpResponse O status e o JSON de resposta.
+     */
+    static HttpResponse partitions(SQLiteConnectionPoolUtils &readConnectionPoolUtils)
+    {
+        sqlite3 *database = readConnectionPoolUtils.getConnectionFromPool();
+
+        if (database == nullptr)
+        {
+            return HttpResponse(HttpStatus::SERVICE_UNAVAILABLE, "{\"success\": false}");
+        }
+
+        sqlite3_exec(database, "BEGIN", nullptr, nullptr, nullptr);
+
+        stringstream json;
+
+        json << "{\"partitionMillis\": " << Constants::PAYMENTS_PARTITION_MS << ", \"partitions\": [";
+
+        bool first = true;
+
+        for (const PaymentsPartition &partition : PaymentsUtils::listPartitions(database))
+        {
+            json << (first ? "" : ", ")
+                 << "{\"table\": \"" << partition.tableName << "\""
+                 << ", \"from\": \"" << TimeUtils::formatTimestampUTC(partition.fromMillis) << "\""
+                 << ", \"to\": \"" << TimeUtils::formatTimestampUTC(partition.toMillis) << "\""
+                 << ", \"records\": " << PaymentsUtils::countRecords(database, partition) << "}";
+
+            first = false;
+        }
+
+        json << "]}";
+
+        sqlite3_exec(database, "COMMIT", nullptr, nullptr, nullptr);
+
+        readConnectionPoolUtils.returnConnectionToPool(database);
+
+        return HttpResponse(HttpStatus::OK, json.str());
+    }
+
+    /**
+     * @brief Remove as partições que terminam antes do parâmetro 'before' da query.
+     *
+     * @param query A query string da request (before=<data ISO-8601>).
+     * @param paymentsDatabaseWriter O escritor, que executa o DROP TABLE na thread de escrita.
+     * @return HttpResponse O status e o JSON de resposta.
+     */
+    static HttpResponse dropPartitions(string_view query, PaymentsDatabaseWriter &paymentsDatabaseWriter)
+    {
+        string_view before;
+        int64_t beforeMillis;
+
+        if (!HttpRequestParser::getQueryParam(query, "before", before) || !TimeUtils::parseTimestampUTC(before, beforeMillis))
+        {
+            return HttpResponse(HttpStatus::BAD_REQUEST, "{\"message\": \"Parâmetro 'before' inválido\"}");
+        }
+
+        int dropped = paymentsDatabaseWriter.dropPartitionsBefore(beforeMillis);
+
+        LOGGER::info("Partições removidas: ", dropped);
+
+        if (dropped < 0)
+        {
+            return HttpResponse(HttpStatus::INTERNAL_SERVER_ERROR, "{\"success\": false}");
+        }
+
+        HttpResponse response(HttpStatus::OK, "{\"success\": true, \"droppedPartitions\": ");
+
+        char count[JsonWriter::INTEGER_MAX_SIZE];
+        response.body.append(count, to_chars(count, count + sizeof(count), dropped).ptr).append("}");
+
+        return response;
+    }
+};
+
+#endif // GARNIZE_PAYMENTS_PROCESSOR_H
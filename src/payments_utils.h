@@ -0,0 +1,646 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file payments_utils.h
+ * @brief Partições, rollups e consultas de pagamentos no SQLite (PaymentsUtils).
+ */
+
+#ifndef GARNIZE_PAYMENTS_UTILS_H
+#define GARNIZE_PAYMENTS_UTILS_H
+
+#include "common.h"
+#include "constants.h"
+#include "config.h"
+#include "logger.h"
+#include "tracer.h"
+#include "sqlite_utils.h"
+#include "payment.h"
+
+/**
+ * @brief Representa uma partição de tempo da tabela de pagamentos.
+ *
+ * Cada partição é uma tabela "payments_p<id>" com os pagamentos de uma janela de
+ * Constants::PAYMENTS_PARTITION_MS milissegundos, onde id = requestedAt / PAYMENTS_PARTITION_MS.
+ */
+struct PaymentsPartition
+{
+    /**
+     * @brief Identificador da partição (índice da janela de tempo).
+     */
+    int64_t id;
+
+    /**
+     * @brief Início da janela (inclusive), em milissegundos desde a epoch.
+     */
+    int64_t fromMillis;
+
+    /**
+     * @brief Fim da janela (exclusive), em milissegundos desde a epoch.
+     */
+    int64_t toMillis;
+
+    /**
+     * @brief Nome da tabela da partição.
+     */
+    string tableName;
+};
+
+/**
+ * @brief Quantidade e valor (em centavos) dos pagamentos processados em um segundo, para um serviço.
+ */
+struct PaymentsRollup
+{
+    int64_t records = 0;
+    int64_t amountInCents = 0;
+};
+
+/**
+ * @class PaymentsUtils
+ * @brief Classe utilitária para manipular a tabela de pagamentos no banco de dados SQLite.
+ *
+ * Os pagamentos são particionados por janela de tempo (veja PaymentsPartition): o resumo só lê as
+ * partições que cruzam o intervalo pedido e partições antigas podem ser removidas com um DROP TABLE.
+ */
+class PaymentsUtils
+{
+public:
+    /**
+     * @brief Inicializa o banco de pagamentos no SQLite.
+     *
+     * As tabelas das partições são criadas sob demanda pela thread de escrita (createPartition).
+     * O correlationId é salvo como BLOB de 16 bytes, o amount em centavos e o requestedAt em milissegundos desde a epoch (UTC).
+     * A tabela payments_rollup guarda, por segundo e serviço, a quantidade e o valor dos pagamentos processados.
+     *
+     * @param database Ponteiro para o objeto sqlite3.
+     *
+     * @note Essa função deve ser chamada apenas uma vez durante a inicialização do sistema.
+     */
+    static void init(sqlite3 *database)
+    {
+
+        // WAL: os leitores (/payments-summary) leem um snapshot e não bloqueiam nem esperam a thread de escrita
+        const char *SQL_QUERY = R"(
+            PRAGMA journal_mode = WAL;
+
+            CREATE TABLE IF NOT EXISTS payments_rollup (
+                second INTEGER NOT NULL,
+                defaultService TINYINT NOT NULL,
+                records INTEGER NOT NULL,
+                amount INTEGER NOT NULL,
+                PRIMARY KEY (second, defaultService)
+            ) WITHOUT ROWID;
+        )";
+
+        char *error;
+
+        int response = sqlite3_exec(database, SQL_QUERY, nullptr, nullptr, &error);
+
+        if (response != SQLITE_OK)
+        {
+            LOGGER::error("Erro ao inicializar o banco de pagamentos: ", error);
+
+            sqlite3_free(error);
+        }
+        else
+        {
+            LOGGER::info("Banco de pagamentos OK");
+        }
+    }
+
+    /**
+     * @brief Retorna a partição que contém o instante informado.
+     *
+     * @param epochMillis Milissegundos desde a epoch.
+     * @return PaymentsPartition A partição correspondente.
+     */
+    static PaymentsPartition getPartition(int64_t epochMillis)
+    {
+        return partitionFromId(epochMillis / Constants::PAYMENTS_PARTITION_MS);
+    }
+
+    /**
+     * @brief Cria a tabela (e o índice) de uma partição se ela ainda não existir.
+     *
+     * @param database Conexão de escrita.
+     * @param partition A partição a ser criada.
+     * @return bool True se a tabela existe ao final, false caso contrário.
+     */
+    static bool createPartition(sqlite3 *database, const PaymentsPartition &partition)
+    {
+        string SQL_QUERY = "CREATE TABLE IF NOT EXISTS " + partition.tableName + R"( (
+                correlationId BLOB NOT NULL,
+                amount INTEGER NOT NULL,
+                requestedAt INTEGER NOT NULL,
+                defaultService TINYINT NOT NULL,
+                processed TINYINT NOT NULL
+            );
+            CREATE INDEX IF NOT EXISTS idx_)" + partition.tableName + "_requestedAt ON " + partition.tableName + " (requestedAt);";
+
+        char *error;
+
+        if (sqlite3_exec(database, SQL_QUERY.c_str(), nullptr, nullptr, &error) != SQLITE_OK)
+        {
+            LOGGER::error("Erro ao criar a partição ", partition.tableName, ": ", error);
+
+            sqlite3_free(error);
+
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Lista as partições existentes em ordem cronológica.
+     *
+     * @param database Ponteiro para o objeto sqlite3.
+     * @return vector<PaymentsPartition> As partições existentes.
+     */
+    static vector<PaymentsPartition> listPartitions(sqlite3 *database)
+    {
+        vector<PaymentsPartition> partitions;
+
+        const char *SQL_QUERY = "SELECT name FROM sqlite_master WHERE type = 'table' AND name LIKE 'payments_p%'";
+
+        sqlite3_stmt *statement;
+
+        if (sqlite3_prepare_v2(database, SQL_QUERY, -1, &statement, nullptr) != SQLITE_OK)
+        {
+            LOGGER::error("Erro ao preparar a query: ", sqlite3_errmsg(database));
+
+            return partitions;
+        }
+
+        while (sqlite3_step(statement) == SQLITE_ROW)
+        {
+            const char *name = reinterpret_cast<const char *>(sqlite3_column_text(statement, 0));
+
+            partitions.push_back(partitionFromId(strtoll(name + PARTITION_PREFIX.size(), nullptr, 10)));
+        }
+
+        sqlite3_finalize(statement);
+
+        sort(partitions.begin(), partitions.end(), [](const PaymentsPartition &a, const PaymentsPartition &b)
+             { return a.id < b.id; });
+
+        return partitions;
+    }
+
+    /**
+     * @brief Remove (DROP TABLE) as partições que terminam antes do instante informado.
+     *
+     * O custo não depende da quantidade de registros das partições removidas. Os rollups dos segundos
+     * dessas partições também são removidos. Deve ser chamado dentro de uma transação.
+     *
+     * @param database Conexão de escrita.
+     * @param beforeMillis Instante (milissegundos desde a epoch); partições inteiramente anteriores são removidas.
+     * @return int A quantidade de partições removidas, ou -1 em caso de erro.
+     */
+    static int dropPartitionsBefore(sqlite3 *database, int64_t beforeMillis)
+    {
+        int dropped = 0;
+
+        for (const PaymentsPartition &partition : listPartitions(database))
+        {
+            if (partition.toMillis > beforeMillis)
+            {
+                break;
+            }
+
+            string SQL_QUERY = "DROP TABLE IF EXISTS " + partition.tableName;
+
+            if (sqlite3_exec(database, SQL_QUERY.c_str(), nullptr, nullptr, nullptr) != SQLITE_OK)
+            {
+                LOGGER::error("Erro ao remover a partição ", partition.tableName, ": ", sqlite3_errmsg(database));
+
+                return -1;
+            }
+
+            dropped++;
+        }
+
+        sqlite3_stmt *statement;
+
+        if (sqlite3_prepare_v2(database, "DELETE FROM payments_rollup WHERE second < ?", -1, &statement, nullptr) != SQLITE_OK)
+        {
+            LOGGER::error("Erro ao preparar a query: ", sqlite3_errmsg(database));
+
+            return -1;
+        }
+
+        sqlite3_bind_int64(statement, 1, getPartition(beforeMillis).fromMillis / 1000);
+
+        int response = sqlite3_step(statement);
+
+        sqlite3_finalize(statement);
+
+        return response == SQLITE_DONE ? dropped : -1;
+    }
+
+    /**
+     * @brief Conta os registros de uma partição.
+     *
+     * @param database Ponteiro para o objeto sqlite3.
+     * @param partition A partição.
+     * @return int64_t A quantidade de registros.
+     */
+    static int64_t countRecords(sqlite3 *database, const PaymentsPartition &partition)
+    {
+        string SQL_QUERY = "SELECT COUNT(*) FROM " + partition.tableName;
+
+        sqlite3_stmt *statement;
+        int64_t records = 0;
+
+        if (sqlite3_prepare_v2(database, SQL_QUERY.c_str(), -1, &statement, nullptr) == SQLITE_OK)
+        {
+            if (sqlite3_step(statement) == SQLITE_ROW)
+            {
+                records = sqlite3_column_int64(statement, 0);
+            }
+
+            sqlite3_finalize(statement);
+        }
+
+        return records;
+    }
+
+    /**
+     * @brief Insere um registro na tabela da partição do pagamento.
+     *
+     * A partição já deve existir (veja createPartition).
+     *
+     * @param database Ponteiro para o objeto sqlite3.
+     * @param payment Registro de pagamento a ser inserido.
+     * @param defaultService Flag que indica se servico 'default' foi usado
+     * @param processed Flag indicando se o pagamento foi processado ou não
+     * @return bool True se o registro foi inserido com sucesso, false caso contrário.
+     */
+    static bool insert(sqlite3 *database, const Payment &payment, bool defaultService, bool processed)
+    {
+        string sql = "INSERT INTO " + getPartition(payment.requestedAt).tableName + " (correlationId, amount, requestedAt, defaultService, processed) VALUES (?, ?, ?, ?, ?);";
+
+        sqlite3_stmt *statement;
+
+        int response = sqlite3_prepare_v2(database, sql.c_str(), -1, &statement, nullptr);
+
+        if (response != SQLITE_OK)
+        {
+            LOGGER::error("Erro ao preparar a query: ", sqlite3_errmsg(database));
+
+            return false;
+        }
+
+        sqlite3_bind_blob(statement, 1, payment.correlationId, sizeof(payment.correlationId), SQLITE_STATIC);
+        sqlite3_bind_int64(statement, 2, payment.amountInCents);
+        sqlite3_bind_int64(statement, 3, payment.requestedAt);
+        sqlite3_bind_int(statement, 4, defaultService ? 1 : 0);
+        sqlite3_bind_int(statement, 5, processed ? 1 : 0);
+
+        response = sqlite3_step(statement);
+
+        if (response != SQLITE_DONE)
+        {
+            LOGGER::error("Erro ao executar a query: ", sqlite3_errmsg(database));
+
+            sqlite3_finalize(statement);
+
+            return false;
+        }
+
+        sqlite3_finalize(statement);
+
+        return true;
+    }
+
+    /**
+     * @brief Soma os rollups por segundo acumulados pela thread de escrita na tabela payments_rollup.
+     *
+     * Deve ser chamado na mesma transação dos inserts dos pagamentos correspondentes.
+     *
+     * @param database Conexão de escrita.
+     * @param rollups Quantidade e valor dos pagamentos processados por (segundo, serviço 'default').
+     * @return bool True se todos os rollups foram gravados, false caso contrário.
+     */
+    static bool upsertRollups(sqlite3 *database, const map<pair<int64_t, bool>, PaymentsRollup> &rollups)
+    {
+        const char *SQL_QUERY = R"(
+            INSERT INTO payments_rollup (second, defaultService, records, amount) VALUES (?, ?, ?, ?)
+            ON CONFLICT (second, defaultService) DO UPDATE SET records = records + excluded.records, amount = amount + excluded.amount;
+        )";
+
+        sqlite3_stmt *statement;
+
+        if (sqlite3_prepare_v2(database, SQL_QUERY, -1, &statement, nullptr) != SQLITE_OK)
+        {
+            LOGGER::error("Erro ao preparar a query: ", sqlite3_errmsg(database));
+
+            return false;
+        }
+
+        bool success = true;
+
+        for (const auto &[key, rollup] : rollups)
+        {
+            sqlite3_bind_int64(statement, 1, key.first);
+            sqlite3_bind_int(statement, 2, key.second ? 1 : 0);
+            sqlite3_bind_int64(statement, 3, rollup.records);
+            sqlite3_bind_int64(statement, 4, rollup.amountInCents);
+
+            if (sqlite3_step(statement) != SQLITE_DONE)
+            {
+                LOGGER::error("Erro ao gravar o rollup: ", sqlite3_errmsg(database));
+
+                success = false;
+            }
+
+            sqlite3_reset(statement);
+        }
+
+        sqlite3_finalize(statement);
+
+        return success;
+    }
+
+    /**
+     * @brief Calcula o resumo dos serviços 'default' e 'fallback' no intervalo informado.
+     *
+     * Os segundos inteiramente cobertos pelo intervalo são lidos da tabela payments_rollup; somente os dois
+     * segundos parciais das bordas são lidos das tabelas de pagamentos (veja aggregateRawRange).
+     *
+     * Cada conexão lê dentro de uma transação (snapshot WAL) e não bloqueia nem espera a thread de escrita.
+     *
+     * @param readConnectionPoolUtils Pool de conexões somente leitura.
+     * @param from Data e hora inicial (milissegundos desde a epoch).
+     * @param to Data e hora final (milissegundos desde a epoch).
+     * @param summary Recebe o resumo dos pagamentos no período.
+     * @return bool False se não foi possível obter uma conexão do pool de leitura.
+     */
+    static bool getSummary(SQLiteConnectionPoolUtils &readConnectionPoolUtils, int64_t from, int64_t to, PaymentsSummary &summary)
+    {
+        TraceSpan span("sqlite.summary");
+
+        PartitionTotals totals;
+
+        // Não existem pagamentos antes da epoch (evita a divisão de negativos abaixo)
+        from = max<int64_t>(from, 0);
+
+        sqlite3 *database = readConnectionPoolUtils.getConnectionFromPool();
+
+        if (database == nullptr)
+        {
+            LOGGER::error("Sem conexão de leitura para o resumo dos pagamentos");
+
+            return false;
+        }
+
+        sqlite3_exec(database, "BEGIN", nullptr, nullptr, nullptr);
+
+        // Segundos [firstSecond, lastSecond] inteiramente dentro de [from, to]
+        int64_t firstSecond = (from + 999) / 1000;
+        int64_t lastSecond = (to + 1) / 1000 - 1;
+
+        if (to >= from && firstSecond <= lastSecond)
+        {
+            aggregateRollups(database, firstSecond, lastSecond, totals);
+
+            if (from < firstSecond * 1000)
+            {
+                aggregateRawRange(database, from, firstSecond * 1000 - 1, totals);
+            }
+
+            if (to >= (lastSecond + 1) * 1000)
+            {
+                aggregateRawRange(database, (lastSecond + 1) * 1000, to, totals);
+            }
+        }
+        else if (to >= from)
+        {
+            aggregateRawRange(database, from, to, totals);
+        }
+
+        sqlite3_exec(database, "COMMIT", nullptr, nullptr, nullptr);
+
+        readConnectionPoolUtils.returnConnectionToPool(database);
+
+        summary.defaultStats.totalRequests = totals.defaultRecords;
+        summary.defaultStats.totalAmount = totals.defaultAmountInCents / 100.0;
+        summary.fallbackStats.totalRequests = totals.fallbackRecords;
+        summary.fallbackStats.totalAmount = totals.fallbackAmountInCents / 100.0;
+
+        return true;
+    }
+
+    /**
+     * @brief Recria o arquivo do banco de pagamentos vazio, trocando o arquivo de forma atômica.
+     *
+     * Cria um arquivo novo ao lado do atual e faz rename() sobre o antigo.
+     * O custo não depende da quantidade de registros (ao contrário de DELETE FROM payments) e o arquivo
+     * não fica inchado. Deve ser chamado sem nenhuma conexão aberta com o banco
+     * (veja SQLiteConnectionPoolUtils::resetConnections).
+     *
+     * @param DATABASE_NAME O caminho do arquivo do banco de pagamentos.
+     * @return bool Indica se a operação foi bem-sucedida.
+     */
+    static bool recreateDatabaseFile(const string &DATABASE_NAME)
+    {
+        const string TEMPORARY_DATABASE = DATABASE_NAME + ".purge";
+
+        unlink(TEMPORARY_DATABASE.c_str());
+
+        sqlite3 *database = SQLiteDatabaseUtils::openConnection(TEMPORARY_DATABASE);
+
+        // Erro ao abrir a conexão
+        if (database == nullptr)
+        {
+            return false;
+        }
+
+        init(database);
+
+        SQLiteDatabaseUtils::closeConnection(database);
+
+        // Arquivos auxiliares do banco antigo não podem ser aplicados ao arquivo novo
+        for (const char *suffix : {"-journal", "-wal", "-shm"})
+        {
+            unlink((DATABASE_NAME + suffix).c_str());
+        }
+
+        if (rename(TEMPORARY_DATABASE.c_str(), DATABASE_NAME.c_str()) != 0)
+        {
+            LOGGER::error("Erro ao trocar o arquivo do banco de pagamentos");
+
+            return false;
+        }
+
+        return true;
+    }
+
+private:
+    /**
+     * @brief Prefixo do nome das tabelas das partições.
+     */
+    inline static const string PARTITION_PREFIX = "payments_p";
+
+    /**
+     * @brief Totais (quantidade e centavos) acumulados por serviço.
+     */
+    struct PartitionTotals
+    {
+        int64_t defaultRecords = 0;
+        int64_t defaultAmountInCents = 0;
+        int64_t fallbackRecords = 0;
+        int64_t fallbackAmountInCents = 0;
+    };
+
+    /**
+     * @brief Monta a PaymentsPartition a partir do identificador.
+     */
+    static PaymentsPartition partitionFromId(int64_t id)
+    {
+        return PaymentsPartition{id, id * Constants::PAYMENTS_PARTITION_MS, (id + 1) * Constants::PAYMENTS_PARTITION_MS, PARTITION_PREFIX + to_string(id)};
+    }
+
+    /**
+     * @brief Soma os rollups dos segundos [firstSecond, lastSecond] em `totals`.
+     *
+     * @param database Ponteiro para o objeto sqlite3.
+     * @param firstSecond Primeiro segundo (segundos desde a epoch).
+     * @param lastSecond Último segundo (segundos desde a epoch).
+     * @param totals Os totais acumulados.
+     */
+    static void aggregateRollups(sqlite3 *database, int64_t firstSecond, int64_t lastSecond, PartitionTotals &totals)
+    {
+        const char *SQL_QUERY = "SELECT defaultService, SUM(records), SUM(amount) FROM payments_rollup WHERE second >= ? AND second <= ? GROUP BY defaultService";
+
+        sqlite3_stmt *statement;
+
+        if (sqlite3_prepare_v2(database, SQL_QUERY, -1, &statement, nullptr) != SQLITE_OK)
+        {
+            LOGGER::error("Erro ao preparar a query: ", sqlite3_errmsg(database));
+
+            return;
+        }
+
+        sqlite3_bind_int64(statement, 1, firstSecond);
+        sqlite3_bind_int64(statement, 2, lastSecond);
+
+        accumulateTotals(statement, totals);
+
+        sqlite3_finalize(statement);
+    }
+
+    /**
+     * @brief Soma em `totals` os pagamentos processados no intervalo lendo as tabelas das partições.
+     *
+     * Somente as partições que cruzam o intervalo são lidas (partition pruning). As partições das bordas
+     * são filtradas por requestedAt; as partições inteiramente cobertas são agregadas sem filtro.
+     * Tudo é lido pela mesma conexão, dentro da transação de leitura do chamador.
+     *
+     * @param database Conexão com a transação de leitura em andamento.
+     * @param from Data e hora inicial (milissegundos desde a epoch).
+     * @param to Data e hora final (milissegundos desde a epoch).
+     * @param totals Os totais acumulados.
+     */
+    static void aggregateRawRange(sqlite3 *database, int64_t from, int64_t to, PartitionTotals &totals)
+    {
+        for (const PaymentsPartition &partition : listPartitions(database))
+        {
+            // Partition pruning
+            if (partition.toMillis <= from || partition.fromMillis > to)
+            {
+                continue;
+            }
+
+            bool covered = partition.fromMillis >= from && partition.toMillis - 1 <= to;
+
+            aggregatePartition(database, partition, !covered, from, to, totals);
+        }
+    }
+
+    /**
+     * @brief Soma as linhas (defaultService, quantidade, valor) de uma query em `totals`.
+     *
+     * @param statement A query preparada (e com os parâmetros já ligados).
+     * @param totals Os totais acumulados.
+     */
+    static void accumulateTotals(sqlite3_stmt *statement, PartitionTotals &totals)
+    {
+        while (sqlite3_step(statement) == SQLITE_ROW)
+        {
+            if (sqlite3_column_int(statement, 0) == 1)
+            {
+                totals.defaultRecords += sqlite3_column_int64(statement, 1);
+                totals.defaultAmountInCents += sqlite3_column_int64(statement, 2);
+            }
+            else
+            {
+                totals.fallbackRecords += sqlite3_column_int64(statement, 1);
+                totals.fallbackAmountInCents += sqlite3_column_int64(statement, 2);
+            }
+        }
+    }
+
+    /**
+     * @brief Soma os pagamentos processados de uma partição em `totals`, agrupados por serviço.
+     *
+     * @param database Ponteiro para o objeto sqlite3.
+     * @param partition A partição a ser lida.
+     * @param filterByTime Se deve filtrar por requestedAt (partições das bordas do intervalo).
+     * @param from Data e hora inicial (milissegundos desde a epoch).
+     * @param to Data e hora final (milissegundos desde a epoch).
+     * @param totals Os totais acumulados.
+     */
+    static void aggregatePartition(sqlite3 *database, const PaymentsPartition &partition, bool filterByTime, int64_t from, int64_t to, PartitionTotals &totals)
+    {
+        string SQL_QUERY = "SELECT defaultService, COUNT(*), SUM(amount) FROM " + partition.tableName + " WHERE processed = 1";
+
+        if (filterByTime)
+        {
+            SQL_QUERY += " AND requestedAt >= ? AND requestedAt <= ?";
+        }
+
+        SQL_QUERY += " GROUP BY defaultService";
+
+        sqlite3_stmt *statement;
+
+        if (sqlite3_prepare_v2(database, SQL_QUERY.c_str(), -1, &statement, nullptr) != SQLITE_OK)
+        {
+            // A partição pode ter sido removida depois da listagem
+            return;
+        }
+
+        if (filterByTime)
+        {
+            sqlite3_bind_int64(statement, 1, from);
+            sqlite3_bind_int64(statement, 2, to);
+        }
+
+        accumulateTotals(statement, totals);
+
+        sqlite3_finalize(statement);
+    }
+};
+
+#endif // GARNIZE_PAYMENTS_UTILS_H
@@ -0,0 +1,379 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file peer_summary.h
+ * @brief Resumo de pagamentos entre réplicas por socket Unix (PeerSummaryService).
+ */
+
+#ifndef GARNIZE_PEER_SUMMARY_H
+#define GARNIZE_PEER_SUMMARY_H
+
+#include "common.h"
+#include "constants.h"
+#include "config.h"
+#include "logger.h"
+#include "sqlite_utils.h"
+#include "payment.h"
+#include "payments_utils.h"
+
+/**
+ * @brief Mensagem binária de pedido de resumo entre instâncias (24 bytes).
+ *
+ * Trafega somente por Unix socket na mesma máquina, então usa a ordem de bytes nativa.
+ */
+struct PeerSummaryRequest
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t reserved;
+    int64_t fromMillis;
+    int64_t toMillis;
+};
+
+/**
+ * @brief Mensagem binária de resposta de resumo entre instâncias (40 bytes).
+ */
+struct PeerSummaryResponse
+{
+    uint32_t magic;
+    uint16_t version;
+    uint16_t status;
+    int64_t defaultTotalRequests;
+    int64_t defaultAmountInCents;
+    int64_t fallbackTotalRequests;
+    int64_t fallbackAmountInCents;
+};
+
+static_assert(sizeof(PeerSummaryRequest) == 24, "PeerSummaryRequest deve ter 24 bytes");
+static_assert(sizeof(PeerSummaryResponse) == 40, "PeerSummaryResponse deve ter 40 bytes");
+
+/**
+ * @class PeerSummaryService
+ * @brief Agrega o resumo de pagamentos entre as réplicas da aplicação via Unix domain sockets.
+ *
+ * Cada réplica só tem no seu SQLite os pagamentos que ela mesma recebeu. Essa classe:
+ * - serve o resumo local de um intervalo de tempo no socket da instância (uma thread por conexão);
+ * - consulta, em paralelo e com prazo máximo (peerDeadlineMs, veja Config), todos os outros sockets do
+ *   diretório compartilhado e soma as respostas ao resumo local.
+ *
+ * O protocolo é binário e de tamanho fixo (PeerSummaryRequest / PeerSummaryResponse), sem JSON.
+ */
+class PeerSummaryService
+{
+public:
+    /**
+     * @brief Identificador das mensagens do protocolo ("GOJS").
+     */
+    static const uint32_t MAGIC = 0x534A4F47;
+
+    /**
+     * @brief Versão do protocolo.
+     */
+    static const uint16_t VERSION = 1;
+
+    /**
+     * @brief Cria o socket da instância e inicia a thread que atende os peers.
+     *
+     * @param readConnectionPoolUtils Pool de leitura usado para calcular o resumo local.
+     * @return true se o serviço foi iniciado (ou está desativado), false em caso de erro.
+     */
+    static bool init(SQLiteConnectionPoolUtils &readConnectionPoolUtils)
+    {
+        if (Constants::PEER_SOCKET_DIRECTORY.empty())
+        {
+            LOGGER::info("Resumo entre instâncias desativado (PEER_SOCKET_DIRECTORY não definido)");
+            return true;
+        }
+
+        error_code errorCode;
+        filesystem::create_directories(Constants::PEER_SOCKET_DIRECTORY, errorCode);
+
+        char hostname[64] = {};
+        gethostname(hostname, sizeof(hostname) - 1);
+
+        socketPath = Constants::PEER_SOCKET_DIRECTORY + "/" + hostname + "-" + to_string(getpid()) + ".sock";
+
+        struct sockaddr_un address;
+
+        if (!fillAddress(socketPath, address))
+        {
+            LOGGER::error("Caminho do socket de peers muito longo: ", socketPath);
+            return false;
+        }
+
+        int listenSocket = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+
+        unlink(socketPath.c_str());
+
+        if (listenSocket < 0 || bind(listenSocket, (struct sockaddr *)&address, sizeof(address)) < 0 || listen(listenSocket, 64) < 0)
+        {
+            LOGGER::error("Falha ao criar o socket de peers: ", socketPath);
+            return false;
+        }
+
+        LOGGER::info("Servindo resumo para peers em ", socketPath);
+
+        thread([listenSocket, &readConnectionPoolUtils]()
+               {
+                   while (true)
+                   {
+                       int peerSocket = accept(listenSocket, nullptr, nullptr);
+
+                       if (peerSocket < 0)
+                       {
+                           continue;
+                       }
+
+                       thread([peerSocket, &readConnectionPoolUtils]()
+                              { servePeer(peerSocket, readConnectionPoolUtils); })
+                           .detach();
+                   } })
+            .detach();
+
+        return true;
+    }
+
+    /**
+     * @brief Remove o socket da instância do diretório compartilhado, para que os peers não tentem mais consultá-lo.
+     */
+    static void shutdown()
+    {
+        if (!socketPath.empty())
+        {
+            unlink(socketPath.c_str());
+        }
+    }
+
+    /**
+     * @brief Envia o pedido de resumo para todos os peers (exceto a própria instância) sem esperar as respostas.
+     *
+     * @param fromMillis Início do intervalo (milissegundos desde a epoch).
+     * @param toMillis Fim do intervalo (milissegundos desde a epoch).
+     * @return vector<int> Os sockets que receberam o pedido e devem ser passados para collectResponses.
+     */
+    static vector<int> sendRequests(int64_t fromMillis, int64_t toMillis)
+    {
+        vector<int> peerSockets;
+
+        if (Constants::PEER_SOCKET_DIRECTORY.empty())
+        {
+            return peerSockets;
+        }
+
+        PeerSummaryRequest request = {MAGIC, VERSION, 0, fromMillis, toMillis};
+
+        error_code errorCode;
+
+        for (const auto &entry : filesystem::directory_iterator(Constants::PEER_SOCKET_DIRECTORY, errorCode))
+        {
+            string path = entry.path().string();
+
+            if (path == socketPath || entry.path().extension() != ".sock")
+            {
+                continue;
+            }
+
+            struct sockaddr_un address;
+
+            if (!fillAddress(path, address))
+            {
+                continue;
+            }
+
+            int peerSocket = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+
+            if (peerSocket < 0)
+            {
+                continue;
+            }
+
+            // Sockets de instâncias que não existem mais recusam a conexão imediatamente e são removidos do diretório
+            if (connect(peerSocket, (struct sockaddr *)&address, sizeof(address)) < 0)
+            {
+                if (errno == ECONNREFUSED)
+                {
+                    LOGGER::info("Removendo socket de peer inativo: ", path);
+                    unlink(path.c_str());
+                }
+
+                close(peerSocket);
+                continue;
+            }
+
+            if (send(peerSocket, &request, sizeof(request), MSG_NOSIGNAL) != static_cast<ssize_t>(sizeof(request)))
+            {
+                close(peerSocket);
+                continue;
+            }
+
+            peerSockets.push_back(peerSocket);
+        }
+
+        return peerSockets;
+    }
+
+    /**
+     * @brief Aguarda as respostas dos peers até o prazo e soma os resumos recebidos.
+     *
+     * Fecha todos os sockets. Mesmo com o prazo já vencido, as respostas que já chegaram (prontas no buffer
+     * do socket) são lidas; respostas incompletas ou que chegarem depois do prazo são descartadas.
+     *
+     * @param peerSockets Sockets retornados por sendRequests.
+     * @param deadline Instante limite para receber as respostas.
+     * @param summary Resumo ao qual os resumos dos peers são somados.
+     * @return size_t Quantidade de peers que responderam.
+     */
+    static size_t collectResponses(vector<int> &peerSockets, chrono::steady_clock::time_point deadline, PaymentsSummary &summary)
+    {
+        size_t answered = 0;
+
+        vector<struct pollfd> pollDescriptors;
+        vector<PeerSummaryResponse> responses(peerSockets.size());
+        vector<size_t> received(peerSockets.size(), 0);
+
+        for (int peerSocket : peerSockets)
+        {
+            pollDescriptors.push_back({peerSocket, POLLIN, 0});
+        }
+
+        size_t pending = peerSockets.size();
+
+        while (pending > 0)
+        {
+            auto remaining = chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+
+            // Com o prazo vencido o poll não espera (timeout 0), só entrega os sockets que já têm dados
+            if (poll(pollDescriptors.data(), pollDescriptors.size(), static_cast<int>(max<int64_t>(remaining, 0))) <= 0)
+            {
+                break;
+            }
+
+            for (size_t i = 0; i < pollDescriptors.size(); i++)
+            {
+                if (pollDescriptors[i].fd < 0 || pollDescriptors[i].revents == 0)
+                {
+                    continue;
+                }
+
+                ssize_t bytes = recv(pollDescriptors[i].fd, reinterpret_cast<char *>(&responses[i]) + received[i], sizeof(PeerSummaryResponse) - received[i], 0);
+
+                if (bytes > 0)
+                {
+                    received[i] += bytes;
+                }
+
+                if (bytes <= 0 || received[i] == sizeof(PeerSummaryResponse))
+                {
+                    const PeerSummaryResponse &response = responses[i];
+
+                    if (received[i] == sizeof(PeerSummaryResponse) && response.magic == MAGIC && response.version == VERSION && response.status == 0)
+                    {
+                        summary.defaultStats.totalRequests += response.defaultTotalRequests;
+                        summary.defaultStats.totalAmount += response.defaultAmountInCents / 100.0;
+                        summary.fallbackStats.totalRequests += response.fallbackTotalRequests;
+                        summary.fallbackStats.totalAmount += response.fallbackAmountInCents / 100.0;
+
+                        answered++;
+                    }
+
+                    // Marca como concluído (poll ignora descritores negativos)
+                    pollDescriptors[i].fd = -1;
+                    pending--;
+                }
+            }
+        }
+
+        for (int peerSocket : peerSockets)
+        {
+            close(peerSocket);
+        }
+
+        if (pending > 0)
+        {
+            LOGGER::error(pending, " peer(s) não responderam o resumo dentro do prazo");
+        }
+
+        peerSockets.clear();
+
+        return answered;
+    }
+
+private:
+    /**
+     * @brief Caminho do socket desta instância.
+     */
+    inline static string socketPath;
+
+    /**
+     * @brief Preenche um sockaddr_un com o caminho informado.
+     *
+     * @return false se o caminho não cabe em sun_path.
+     */
+    static bool fillAddress(const string &path, struct sockaddr_un &address)
+    {
+        memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+
+        if (path.size() >= sizeof(address.sun_path))
+        {
+            return false;
+        }
+
+        memcpy(address.sun_path, path.c_str(), path.size());
+
+        return true;
+    }
+
+    /**
+     * @brief Atende um pedido de resumo de um peer com o resumo local (somente desta instância).
+     */
+    static void servePeer(int peerSocket, SQLiteConnectionPoolUtils &readConnectionPoolUtils)
+    {
+        int64_t deadlineMillis = Config::get(ConfigKey::PEER_DEADLINE_MS);
+        struct timeval timeout = {static_cast<time_t>(deadlineMillis / 1000), static_cast<suseconds_t>(deadlineMillis % 1000 * 1000)};
+        setsockopt(peerSocket, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+        PeerSummaryRequest request;
+
+        if (recv(peerSocket, &request, sizeof(request), MSG_WAITALL) == static_cast<ssize_t>(sizeof(request)) &&
+            request.magic == MAGIC && request.version == VERSION)
+        {
+            PaymentsSummary summary{};
+
+            // status != 0: o peer descarta a resposta, como se esta instância não tivesse respondido
+            uint16_t status = PaymentsUtils::getSummary(readConnectionPoolUtils, request.fromMillis, request.toMillis, summary) ? 0 : 1;
+
+            PeerSummaryResponse response = {MAGIC, VERSION, status,
+                                            summary.defaultStats.totalRequests, llround(summary.defaultStats.totalAmount * 100),
+                                            summary.fallbackStats.totalRequests, llround(summary.fallbackStats.totalAmount * 100)};
+
+            send(peerSocket, &response, sizeof(response), MSG_NOSIGNAL);
+        }
+
+        close(peerSocket);
+    }
+};
+
+#endif // GARNIZE_PEER_SUMMARY_H
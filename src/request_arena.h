@@ -0,0 +1,97 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file request_arena.h
+ * @brief Arena de memória por request (RequestArena).
+ */
+
+#ifndef GARNIZE_REQUEST_ARENA_H
+#define GARNIZE_REQUEST_ARENA_H
+
+#include "common.h"
+#include "constants.h"
+
+/**
+ * @brief Arena de memória monotônica com o tempo de vida de uma request.
+ *
+ * O objeto deve ser criado na stack da thread que atende a request. Enquanto ele existir,
+ * RequestArena::getResource() retorna um std::pmr::monotonic_buffer_resource que aloca em um buffer
+ * local e só libera tudo de uma vez, quando a request termina. Fora de uma request o recurso padrão (heap) é usado.
+ */
+class RequestArena
+{
+public:
+    /**
+     * @brief Cria a arena e a registra como a arena corrente da thread.
+     */
+    RequestArena() : resource(initialBuffer, sizeof(initialBuffer)), previous(current)
+    {
+        current = &resource;
+    }
+
+    /**
+     * @brief Restaura a arena anterior da thread e libera toda a memória alocada.
+     */
+    ~RequestArena()
+    {
+        current = previous;
+    }
+
+    RequestArena(const RequestArena &) = delete;
+    RequestArena &operator=(const RequestArena &) = delete;
+
+    /**
+     * @brief Retorna o memory_resource da request corrente da thread.
+     *
+     * @return std::pmr::memory_resource* A arena da request ou o recurso padrão se não houver request.
+     */
+    static pmr::memory_resource *getResource()
+    {
+        return current != nullptr ? current : pmr::get_default_resource();
+    }
+
+private:
+    /**
+     * @brief Buffer inicial da arena (na stack da thread).
+     */
+    alignas(max_align_t) char initialBuffer[Constants::REQUEST_ARENA_SIZE];
+
+    /**
+     * @brief Recurso monotônico que aloca sobre o buffer inicial.
+     */
+    pmr::monotonic_buffer_resource resource;
+
+    /**
+     * @brief Arena que estava ativa antes desta (permite aninhamento).
+     */
+    pmr::memory_resource *previous;
+
+    /**
+     * @brief Arena corrente da thread.
+     */
+    static thread_local pmr::memory_resource *current;
+};
+
+#endif // GARNIZE_REQUEST_ARENA_H
@@ -0,0 +1,283 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file request_handler.h
+ * @brief Leitura, roteamento e resposta de cada conexão (RequestHandler).
+ */
+
+#ifndef GARNIZE_REQUEST_HANDLER_H
+#define GARNIZE_REQUEST_HANDLER_H
+
+#include "common.h"
+#include "constants.h"
+#include "config.h"
+#include "logger.h"
+#include "request_arena.h"
+#include "http_status.h"
+#include "metrics.h"
+#include "tracer.h"
+#include "http.h"
+#include "sqlite_utils.h"
+#include "json_serializer.h"
+#include "payments_database_writer.h"
+#include "saturation_metrics.h"
+#include "payments_processor.h"
+
+/**
+ * @brief Classe responsável por lidar com requisições recebidas em um socket.
+ *
+ * Essa classe fornece um método estático para lidar com requisições recebidas em um socket.
+ *
+ */
+class RequestHandler
+{
+public:
+    /**
+     * @brief Lida com uma requisição recebida em um socket.
+     *
+     * Essa função lê a requisição do socket, parseia o método e o caminho da requisição,
+     * e então processa a requisição de acordo com o método e o caminho.
+     *
+     * @param socket O socket que recebeu a requisição.
+     * @param paymentsDatabaseWriter Classe que gerencia a escrita de pagamentos no banco de dados de forma segura e eficiente.
+     * @param readConnectionPoolUtils Pool de conexões somente leitura do banco de pagamentos.
+     *
+     * @details
+     * A função segue os seguintes passos:
+     * 1. Lê a requisição do socket e armazena em um buffer.
+     * 2. Parseia o método e o caminho da requisição.
+     * 3. Verifica se o método e o caminho são válidos e processa a requisição de acordo.
+     * 4. Envia uma resposta ao cliente.
+     * 5. Fecha a conexão.
+     *
+     * @note
+     * A função assume que o socket é válido e que a requisição é bem-formada.
+     * Se a requisição for inválida, a função envia uma resposta de erro ao cliente.
+     */
+    static void handle(int socket, PaymentsDatabaseWriter &paymentsDatabaseWriter, SQLiteConnectionPoolUtils &readConnectionPoolUtils)
+    {
+        // Conta a thread como ocupada (gauge garnize_active_handler_threads) até o fim da request
+        Metrics::ActiveHandler activeHandler;
+
+        // Strings temporárias da request são alocadas nessa arena e liberadas de uma vez no fim da request
+        RequestArena arena;
+
+        // Define o tamanho do buffer para ler dados da conexão de rede.
+        // O tamanho é o bufferSize do Config (256 bytes por padrão, Constants::BUFFER_SIZE), o que significa
+        // que o programa pode ler até bufferSize bytes de dados da conexão por vez. O buffer fica na arena da
+        // request: até o tamanho inicial da arena, continua na stack da thread.
+        size_t bufferSize = Config::get(ConfigKey::BUFFER_SIZE);
+        char *buffer = static_cast<char *>(RequestArena::getResource()->allocate(bufferSize, 1));
+
+        // Ler a requisição
+        ssize_t bytesRead = read(socket, buffer, bufferSize);
+
+        if (bytesRead < 0)
+        {
+            LOGGER::error("Falha ao ler a requisição");
+
+            bytesRead = 0;
+        }
+
+        auto start = chrono::steady_clock::now();
+
+        TraceSpan requestSpan("http.request");
+
+        // Parse da requisição: o HttpRequest só guarda views para o buffer (que não termina em '\0')
+        HttpRequest request;
+        MetricsEndpoint endpoint = MetricsEndpoint::OTHER;
+        HttpStatus status;
+        bool validRequest;
+
+        {
+            TraceSpan span("http.parse");
+
+            validRequest = HttpRequestParser::parse(string_view(buffer, bytesRead), request);
+        }
+
+        if (!validRequest)
+        {
+            LOGGER::error(Constants::INVALID_REQUEST_MSG);
+
+            status = HttpStatus::BAD_REQUEST;
+            sendResponse(socket, HttpResponse(status));
+        }
+        else
+        {
+            HttpResponse response = route(request, paymentsDatabaseWriter, readConnectionPoolUtils, endpoint);
+
+            status = response.status;
+            sendResponse(socket, response);
+        }
+
+        Metrics::recordRequest(endpoint, status, chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count());
+
+        // Fechar a conexão
+        close(socket);
+    }
+
+    /**
+     * @brief Encaminha a requisição para o PaymentsProcessor de acordo com o método e o caminho.
+     *
+     * @param request A requisição parseada.
+     * @param paymentsDatabaseWriter Classe que gerencia a escrita de pagamentos no banco de dados.
+     * @param readConnectionPoolUtils Pool de conexões somente leitura do banco de pagamentos.
+     * @param endpoint Recebe o endpoint da rota (para as métricas).
+     * @return HttpResponse A resposta (404 se a rota não estiver mapeada).
+     */
+    static HttpResponse route(const HttpRequest &request, PaymentsDatabaseWriter &paymentsDatabaseWriter, SQLiteConnectionPoolUtils &readConnectionPoolUtils, MetricsEndpoint &endpoint)
+    {
+        if (request.method == "POST" && request.path == Constants::PAYMENTS_ENDPOINT)
+        {
+            LOGGER::info("POST request para /payments");
+
+            endpoint = MetricsEndpoint::PAYMENTS;
+
+            return PaymentsProcessor::payment(request.body, paymentsDatabaseWriter);
+        }
+
+        if (request.method == "GET" && request.path == Constants::PAYMENTS_SUMMARY_ENDPOINT)
+        {
+            LOGGER::info("GET request para /payments-summary ", request.target);
+
+            endpoint = MetricsEndpoint::PAYMENTS_SUMMARY;
+
+            return PaymentsProcessor::payments_summary(request.query, readConnectionPoolUtils);
+        }
+
+        if (request.method == "POST" && request.path == Constants::PURGE_PAYMENTS_ENDPOINT)
+        {
+            LOGGER::info("POST request para /purge-payments");
+
+            endpoint = MetricsEndpoint::PURGE_PAYMENTS;
+
+            bool success = paymentsDatabaseWriter.purgePayments();
+
+            string msg = "Todas as tabelas do banco foram limpas! Eu espero que você saiba o que acabou de fazer.";
+
+            LOGGER::info(msg);
+
+            HttpResponse response(HttpStatus::OK);
+            response.body = PaymentsJSONConverter::toJsonString(PurgeResponse{msg, success});
+
+            return response;
+        }
+
+        if (request.method == "POST" && request.path == Constants::DROP_PARTITIONS_ADMIN_ENDPOINT)
+        {
+            LOGGER::info("POST request para /admin/partitions/drop ", request.target);
+
+            endpoint = MetricsEndpoint::DROP_PARTITIONS;
+
+            return PaymentsProcessor::dropPartitions(request.query, paymentsDatabaseWriter);
+        }
+
+        if (request.method == "GET" && request.path == Constants::PARTITIONS_ADMIN_ENDPOINT)
+        {
+            LOGGER::info("GET request para /admin/partitions");
+
+            endpoint = MetricsEndpoint::PARTITIONS;
+
+            return PaymentsProcessor::partitions(readConnectionPoolUtils);
+        }
+
+        if (request.method == "GET" && request.path == Constants::TRACE_ADMIN_ENDPOINT)
+        {
+            endpoint = MetricsEndpoint::TRACE;
+
+            HttpResponse response(HttpStatus::OK);
+
+            Tracer::writeChromeTrace(response.body);
+
+            return response;
+        }
+
+        if (request.path == Constants::CONFIG_ADMIN_ENDPOINT && (request.method == "GET" || request.method == "POST"))
+        {
+            LOGGER::info(request.method, " request para /admin/config ", request.target);
+
+            endpoint = MetricsEndpoint::CONFIG;
+
+            if (request.method == "POST")
+            {
+                string error;
+
+                if (!Config::update(request.query, error))
+                {
+                    HttpResponse response(HttpStatus::BAD_REQUEST);
+                    response.body.assign("{\"message\": \"").append(error).append("\"}");
+
+                    return response;
+                }
+            }
+
+            HttpResponse response(HttpStatus::OK);
+
+            Config::render(response.body);
+
+            return response;
+        }
+
+        if (request.method == "GET" && request.path == Constants::METRICS_ENDPOINT)
+        {
+            endpoint = MetricsEndpoint::METRICS;
+
+            HttpResponse response(HttpStatus::OK);
+            response.contentType = Constants::CONTENT_TYPE_PROMETHEUS;
+
+            Metrics::render(response.body);
+            SaturationMetrics::render(response.body, paymentsDatabaseWriter, readConnectionPoolUtils);
+
+            return response;
+        }
+
+        LOGGER::info("Essa request não está mapeada");
+
+        return HttpResponse(HttpStatus::NOT_FOUND);
+    }
+
+    /**
+     * @brief Envia os cabeçalhos e o corpo da resposta em uma única syscall (writev).
+     *
+     * @param socket O socket da conexão.
+     * @param response A resposta.
+     */
+    static void sendResponse(int socket, const HttpResponse &response)
+    {
+        char headersBuffer[HttpResponse::HEADERS_MAX_SIZE];
+        string_view headers = response.writeHeaders(headersBuffer);
+
+        struct iovec parts[2] = {
+            {const_cast<char *>(headers.data()), headers.size()},
+            {const_cast<char *>(response.body.data()), response.body.size()}};
+
+        if (writev(socket, parts, response.body.empty() ? 1 : 2) < 0)
+        {
+            LOGGER::error("Falha ao enviar a resposta");
+        }
+    }
+};
+
+#endif // GARNIZE_REQUEST_HANDLER_H
@@ -0,0 +1,138 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file saturation_metrics.h
+ * @brief Gauges de saturação dos pools, da fila de escrita e das threads (SaturationMetrics).
+ */
+
+#ifndef GARNIZE_SATURATION_METRICS_H
+#define GARNIZE_SATURATION_METRICS_H
+
+#include "common.h"
+#include "request_arena.h"
+#include "metrics.h"
+#include "sqlite_utils.h"
+#include "payments_database_writer.h"
+
+/**
+ * @brief Gauges de saturação (pools de conexões, fila de escrita e commits) amostrados na leitura do GET /metrics.
+ *
+ * Complementa o Metrics com os recursos que só existem depois da inicialização: os valores são lidos dos
+ * próprios objetos (getStats / getQueueStats) no momento da coleta, sem custo no caminho da request.
+ */
+class SaturationMetrics
+{
+public:
+    /**
+     * @brief Escreve os gauges dos pools e da fila de escrita no formato texto do Prometheus.
+     */
+    static void render(pmr::string &output, PaymentsDatabaseWriter &paymentsDatabaseWriter, SQLiteConnectionPoolUtils &readConnectionPoolUtils)
+    {
+        array<SQLiteConnectionPoolUtils *, 2> pools = {&paymentsDatabaseWriter.getConnectionPool(), &readConnectionPoolUtils};
+        array<ConnectionPoolStats, 2> stats = {pools[0]->getStats(), pools[1]->getStats()};
+
+        output.append("# HELP garnize_pool_connections Conexões SQLite por pool e estado.\n"
+                      "# TYPE garnize_pool_connections gauge\n");
+
+        for (const ConnectionPoolStats &pool : stats)
+        {
+            appendPoolSample(output, "garnize_pool_connections", pool.name, ",state=\"in_use\"", pool.inUse);
+            appendPoolSample(output, "garnize_pool_connections", pool.name, ",state=\"idle\"", pool.idle);
+        }
+
+        output.append("# HELP garnize_pool_waiting_threads Threads bloqueadas esperando uma conexão.\n"
+                      "# TYPE garnize_pool_waiting_threads gauge\n");
+
+        for (const ConnectionPoolStats &pool : stats)
+        {
+            appendPoolSample(output, "garnize_pool_waiting_threads", pool.name, "", pool.waiting);
+        }
+
+        output.append("# HELP garnize_pool_acquisitions_total Conexões retiradas do pool.\n"
+                      "# TYPE garnize_pool_acquisitions_total counter\n");
+
+        for (const ConnectionPoolStats &pool : stats)
+        {
+            appendPoolSample(output, "garnize_pool_acquisitions_total", pool.name, "", pool.acquisitions);
+        }
+
+        output.append("# HELP garnize_pool_wait_duration_seconds Tempo de espera por uma conexão.\n"
+                      "# TYPE garnize_pool_wait_duration_seconds summary\n");
+
+        for (size_t i = 0; i < pools.size(); i++)
+        {
+            Metrics::appendSummary(output, "garnize_pool_wait_duration_seconds", pools[i]->getWaitLatency(), "pool=\"", stats[i].name, "\"");
+        }
+
+        WriterQueueStats queue = paymentsDatabaseWriter.getQueueStats();
+
+        output.append("# HELP garnize_writer_queue_depth Pagamentos aguardando no ring buffer do PaymentsDatabaseWriter.\n"
+                      "# TYPE garnize_writer_queue_depth gauge\n");
+        Metrics::appendSample(output, "garnize_writer_queue_depth", "", queue.queueDepth);
+
+        output.append("# HELP garnize_writer_queue_capacity Capacidade do ring buffer do PaymentsDatabaseWriter.\n"
+                      "# TYPE garnize_writer_queue_capacity gauge\n");
+        Metrics::appendSample(output, "garnize_writer_queue_capacity", "", queue.queueCapacity);
+
+        output.append("# HELP garnize_writer_spill_pending_records Pagamentos no spill em disco ainda não persistidos no banco.\n"
+                      "# TYPE garnize_writer_spill_pending_records gauge\n");
+        Metrics::appendSample(output, "garnize_writer_spill_pending_records", "", queue.spillPendingRecords);
+
+        output.append("# HELP garnize_writer_spill_segments Arquivos de segmento do spill em disco.\n"
+                      "# TYPE garnize_writer_spill_segments gauge\n");
+        Metrics::appendSample(output, "garnize_writer_spill_segments", "", queue.spillSegments);
+
+        output.append("# HELP garnize_writer_spilled_records_total Pagamentos que foram para o spill em disco.\n"
+                      "# TYPE garnize_writer_spilled_records_total counter\n");
+        Metrics::appendSample(output, "garnize_writer_spilled_records_total", "", queue.spilledRecordsTotal);
+
+        output.append("# HELP garnize_writer_spilled_bytes_total Bytes gravados no spill em disco.\n"
+                      "# TYPE garnize_writer_spilled_bytes_total counter\n");
+        Metrics::appendSample(output, "garnize_writer_spilled_bytes_total", "", queue.spilledBytesTotal);
+
+        output.append("# HELP garnize_writer_batch_size Pagamentos por transação do PaymentsDatabaseWriter.\n"
+                      "# TYPE garnize_writer_batch_size summary\n");
+        Metrics::appendSummary(output, "garnize_writer_batch_size", paymentsDatabaseWriter.getBatchSizes(), "", "", "", 1);
+
+        output.append("# HELP garnize_writer_commit_duration_seconds Tempo de commit (rollups + COMMIT) de cada transação.\n"
+                      "# TYPE garnize_writer_commit_duration_seconds summary\n");
+        Metrics::appendSummary(output, "garnize_writer_commit_duration_seconds", paymentsDatabaseWriter.getCommitLatency(), "", "", "");
+    }
+
+private:
+    /**
+     * @brief Escreve uma amostra com o label pool="<nome>" seguido de `labels`.
+     */
+    static void appendPoolSample(pmr::string &output, string_view name, const string &pool, string_view labels, uint64_t value)
+    {
+        pmr::string poolLabels(RequestArena::getResource());
+
+        poolLabels.append("pool=\"").append(pool).append("\"").append(labels);
+
+        Metrics::appendSample(output, name, poolLabels, value);
+    }
+};
+
+#endif // GARNIZE_SATURATION_METRICS_H
@@ -0,0 +1,269 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file simd_scanner.h
+ * @brief Varreduras vetorizadas (AVX2 / SSE4.2 / escalar) de headers e strings JSON (SimdScanner).
+ */
+
+#ifndef GARNIZE_SIMD_SCANNER_H
+#define GARNIZE_SIMD_SCANNER_H
+
+#include "common.h"
+
+/**
+ * @brief Varreduras de bytes vetorizadas (SSE4.2 / AVX2) usadas pelo JsonParser e pelo RequestHandler.
+ *
+ * A implementação é escolhida uma única vez, em tempo de execução, de acordo com a CPU (AVX2, SSE4.2 ou escalar).
+ * As versões vetorizadas são compiladas com `__attribute__((target))`, então o binário não exige AVX2 e continua
+ * compilando com as mesmas flags; fora de x86 só a versão escalar existe.
+ *
+ * Todas as funções recebem [begin, end) e retornam `end` quando não encontram nada.
+ */
+class SimdScanner
+{
+public:
+    /**
+     * @brief Retorna o primeiro caractere que encerra o conteúdo simples de uma string JSON: aspas, barra invertida ou caractere de controle (< 0x20).
+     */
+    static const char *findStringSpecial(const char *begin, const char *end)
+    {
+        return findStringSpecialImplementation(begin, end);
+    }
+
+    /**
+     * @brief Retorna o início do "\r\n\r\n" que separa os headers do corpo de uma requisição HTTP.
+     */
+    static const char *findHeaderEnd(const char *begin, const char *end)
+    {
+        return findHeaderEndImplementation(begin, end);
+    }
+
+    /**
+     * @brief Nome do conjunto de instruções escolhido ("avx2", "sse4.2" ou "escalar").
+     */
+    static const char *getInstructionSet()
+    {
+        return instructionSet;
+    }
+
+    static const char *findStringSpecialScalar(const char *begin, const char *end)
+    {
+        while (begin < end && *begin != '"' && *begin != '\\' && static_cast<unsigned char>(*begin) >= 0x20)
+        {
+            begin++;
+        }
+
+        return begin;
+    }
+
+    static const char *findHeaderEndScalar(const char *begin, const char *end)
+    {
+        // memchr já é vetorizado pela libc: salta direto para o próximo '\r'
+        while (end - begin >= 4)
+        {
+            const char *carriageReturn = static_cast<const char *>(memchr(begin, '\r', end - begin - 3));
+
+            if (carriageReturn == nullptr)
+            {
+                break;
+            }
+
+            if (memcmp(carriageReturn, "\r\n\r\n", 4) == 0)
+            {
+                return carriageReturn;
+            }
+
+            begin = carriageReturn + 1;
+        }
+
+        return end;
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    __attribute__((target("sse4.2"))) static const char *findStringSpecialSse42(const char *begin, const char *end)
+    {
+        // Faixas [0x00, 0x1F], ['"', '"'] e ['\\', '\\']
+        const __m128i RANGES = _mm_setr_epi8(0x00, 0x1F, '"', '"', '\\', '\\', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+        for (; end - begin >= 16; begin += 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+
+            int index = _mm_cmpestri(RANGES, 6, chunk, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_RANGES | _SIDD_LEAST_SIGNIFICANT);
+
+            if (index < 16)
+            {
+                return begin + index;
+            }
+        }
+
+        return findStringSpecialScalar(begin, end);
+    }
+
+    __attribute__((target("sse4.2"))) static const char *findHeaderEndSse42(const char *begin, const char *end)
+    {
+        const __m128i DELIMITER = _mm_setr_epi8('\r', '\n', '\r', '\n', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0);
+
+        // Busca de substring (equal ordered): o índice também encontra ocorrências parciais no fim do bloco,
+        // por isso avança até o índice encontrado e confirma os 4 bytes
+        while (end - begin >= 16)
+        {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(begin));
+
+            int index = _mm_cmpestri(DELIMITER, 4, chunk, 16, _SIDD_UBYTE_OPS | _SIDD_CMP_EQUAL_ORDERED | _SIDD_LEAST_SIGNIFICANT);
+
+            if (index == 16)
+            {
+                begin += 16;
+            }
+            else if (index <= 12)
+            {
+                return begin + index;
+            }
+            else
+            {
+                begin += index;
+
+                if (end - begin >= 4 && memcmp(begin, "\r\n\r\n", 4) == 0)
+                {
+                    return begin;
+                }
+
+                begin++;
+            }
+        }
+
+        return findHeaderEndScalar(begin, end);
+    }
+
+    __attribute__((target("avx2"))) static const char *findStringSpecialAvx2(const char *begin, const char *end)
+    {
+        const __m256i QUOTE = _mm256_set1_epi8('"');
+        const __m256i BACKSLASH = _mm256_set1_epi8('\\');
+        const __m256i CONTROL_MAX = _mm256_set1_epi8(0x1F);
+
+        for (; end - begin >= 32; begin += 32)
+        {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin));
+
+            // chunk <= 0x1F (sem sinal) <=> max(chunk, 0x1F) == 0x1F
+            __m256i special = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(chunk, QUOTE), _mm256_cmpeq_epi8(chunk, BACKSLASH)),
+                                              _mm256_cmpeq_epi8(_mm256_max_epu8(chunk, CONTROL_MAX), CONTROL_MAX));
+
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(special));
+
+            if (mask != 0)
+            {
+                return begin + __builtin_ctz(mask);
+            }
+        }
+
+        return findStringSpecialScalar(begin, end);
+    }
+
+    __attribute__((target("avx2"))) static const char *findHeaderEndAvx2(const char *begin, const char *end)
+    {
+        const __m256i CR = _mm256_set1_epi8('\r');
+        const __m256i LF = _mm256_set1_epi8('\n');
+
+        // Compara os 4 bytes do delimitador em 32 posições de uma vez (cargas deslocadas de 0 a 3 bytes)
+        for (; end - begin >= 35; begin += 32)
+        {
+            __m256i first = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin)), CR);
+            __m256i second = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin + 1)), LF);
+            __m256i third = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin + 2)), CR);
+            __m256i fourth = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(begin + 3)), LF);
+
+            uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_and_si256(_mm256_and_si256(first, second), _mm256_and_si256(third, fourth))));
+
+            if (mask != 0)
+            {
+                return begin + __builtin_ctz(mask);
+            }
+        }
+
+        return findHeaderEndScalar(begin, end);
+    }
+#endif
+
+private:
+    using ScanFunction = const char *(*)(const char *, const char *);
+
+    /**
+     * @brief Escolhe o conjunto de instruções suportado pela CPU.
+     */
+    static const char *selectInstructionSet()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init();
+
+        if (__builtin_cpu_supports("avx2"))
+        {
+            return "avx2";
+        }
+
+        if (__builtin_cpu_supports("sse4.2"))
+        {
+            return "sse4.2";
+        }
+#endif
+
+        return "escalar";
+    }
+
+    inline static const char *const instructionSet = selectInstructionSet();
+
+#if defined(__x86_64__) || defined(__i386__)
+    /**
+     * @brief Retorna a implementação correspondente ao conjunto de instruções escolhido.
+     */
+    static ScanFunction select(ScanFunction scalar, ScanFunction sse42, ScanFunction avx2)
+    {
+        string_view selected = instructionSet;
+
+        if (selected == "avx2")
+        {
+            return avx2;
+        }
+
+        if (selected == "sse4.2")
+        {
+            return sse42;
+        }
+
+        return scalar;
+    }
+
+    inline static const ScanFunction findStringSpecialImplementation = select(findStringSpecialScalar, findStringSpecialSse42, findStringSpecialAvx2);
+
+    inline static const ScanFunction findHeaderEndImplementation = select(findHeaderEndScalar, findHeaderEndSse42, findHeaderEndAvx2);
+#else
+    inline static const ScanFunction findStringSpecialImplementation = findStringSpecialScalar;
+
+    inline static const ScanFunction findHeaderEndImplementation = findHeaderEndScalar;
+#endif
+};
+
+#endif // GARNIZE_SIMD_SCANNER_H
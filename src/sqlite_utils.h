@@ -0,0 +1,444 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file sqlite_utils.h
+ * @brief Conexões e pools de conexões SQLite (SQLiteDatabaseUtils / SQLiteConnectionPoolUtils).
+ */
+
+#ifndef GARNIZE_SQLITE_UTILS_H
+#define GARNIZE_SQLITE_UTILS_H
+
+#include "common.h"
+#include "constants.h"
+#include "config.h"
+#include "logger.h"
+#include "latency_histogram.h"
+
+/**
+ * @brief Classe responsável por gerenciar a interação o banco de dados SQLite.
+ */
+class SQLiteDatabaseUtils
+{
+public:
+    static bool setUpMultiThreadedMode()
+    {
+        // Configura o SQLite para funcionar em modo multi-thread
+        int response = sqlite3_config(SQLITE_CONFIG_MULTITHREAD);
+
+        if (response != SQLITE_OK)
+        {
+            LOGGER::error("Erro ao configurar o modo multi-thread: ", sqlite3_errstr(response));
+
+            return false;
+        }
+
+        return true;
+    }
+    /**
+     * @brief Abre uma conexão com o banco de dados SQLite local definido em Constants::DATABASE_NAME.
+     *
+     * Configura o SQLite para funcionar em modo multi-thread e retorna um ponteiro para o objeto sqlite3.
+     *
+     * @param DATABASE_NAME Nome do banco que deve ser aberta a conexão
+     * @param readOnly Se a conexão deve ser aberta somente para leitura.
+     * @return sqlite3* Ponteiro para o objeto sqlite3 se a conexão for aberta com sucesso, ou nullptr caso contrário.
+     */
+    static sqlite3 *openConnection(const string &DATABASE_NAME, bool readOnly = false)
+    {
+
+        sqlite3 *database;
+
+        int flags = readOnly ? SQLITE_OPEN_READONLY : (SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE);
+
+        int response = sqlite3_open_v2(DATABASE_NAME.c_str(), &database, flags, nullptr);
+
+        if (response)
+        {
+            LOGGER::error("Erro ao abrir conexão com o banco de dados: ", sqlite3_errmsg(database));
+
+            sqlite3_close(database);
+
+            return nullptr;
+        }
+
+        /**
+         * @todo Timeout para tentar evitar erro de database is locked
+         */
+        sqlite3_busy_timeout(database, static_cast<int>(Config::get(ConfigKey::SQLITE_BUSY_TIMEOUT_MS)));
+
+        LOGGER::info("Abriu conexão com o banco de dados.");
+
+        return database;
+    }
+
+    /**
+     * @brief Fecha uma conexão com o banco de dados SQLite local definido em Constants::DATABASE_NAME.
+     *
+     * @param database Ponteiro para o objeto sqlite3.
+     * @return bool True a conexão foi fechada com sucesso, false caso contrário.
+     */
+    static bool closeConnection(sqlite3 *database)
+    {
+
+        int response = sqlite3_close(database);
+
+        if (response != SQLITE_OK)
+        {
+
+            LOGGER::error("Erro ao fechar conexão com o banco de dados: ", sqlite3_errmsg(database));
+
+            return false;
+        }
+
+        LOGGER::info("Fechou conexão com o banco de dados.");
+
+        return true;
+    }
+};
+
+/**
+ * @brief Contadores de espera de um pool de conexões.
+ */
+struct ConnectionPoolStats
+{
+    /**
+     * @brief Nome do pool (ex.: "escrita", "leitura").
+     */
+    string name;
+
+    /**
+     * @brief Quantidade de conexões retiradas do pool desde o início.
+     */
+    uint64_t acquisitions;
+
+    /**
+     * @brief Soma do tempo de espera por uma conexão, em nanossegundos.
+     */
+    uint64_t totalWaitNanoseconds;
+
+    /**
+     * @brief Maior tempo de espera por uma conexão, em nanossegundos.
+     */
+    uint64_t maxWaitNanoseconds;
+
+    /**
+     * @brief Conexões emprestadas no momento.
+     */
+    int inUse;
+
+    /**
+     * @brief Conexões livres no pool no momento.
+     */
+    size_t idle;
+
+    /**
+     * @brief Threads bloqueadas esperando uma conexão no momento.
+     */
+    int waiting;
+};
+
+/**
+ * @class SQLiteConnectionPoolUtils
+ * @brief Gerencia um pool de conexões SQLite para melhorar o desempenho em ambientes de alta concorrência.
+ *
+ * Essa classe fornece uma implementação de pool de conexões SQLite que permite que múltiplas threads compartilhem conexões de forma segura e eficiente.
+ * O banco de pagamentos usa dois pools: um de escrita (PaymentsDatabaseWriter) e um somente leitura (/payments-summary).
+ *
+ * @param max_connections O número máximo de conexões que o pool pode manter.
+ * @param max_queue_size O número máximo de threads que podem ser enfileiradas esperando por uma conexão.
+ */
+class SQLiteConnectionPoolUtils
+{
+public:
+    /**
+     * @brief Constrói um objeto SQLiteConnectionPoolUtils.
+     *
+     * Inicializa o pool de conexões com o número máximo de conexões especificado.
+     *
+     * @param pool_name Nome do pool, usado nos logs e nos contadores.
+     * @param database_name O arquivo do banco de dados.
+     * @param max_connections O número máximo de conexões que o pool pode manter.
+     * @param max_queue_size O número máximo de threads que podem ser enfileiradas esperando por uma conexão.
+     * @param read_only Se as conexões devem ser abertas somente para leitura.
+     */
+    SQLiteConnectionPoolUtils(const string &pool_name, const string &database_name, int max_connections, int max_queue_size, bool read_only)
+        : poolName(pool_name), databaseName(database_name), readOnly(read_only), maxConnections(max_connections), maxQueueSize(max_queue_size)
+    {
+        for (int i = 0; i < maxConnections; i++)
+        {
+            sqlite3 *connection = SQLiteDatabaseUtils::openConnection(databaseName, readOnly);
+
+            if (connection != nullptr)
+            {
+                connectionsQueue.push(connection);
+            }
+            else
+            {
+                LOGGER::error("Erro ao criar conexão no pool");
+            }
+        }
+    }
+
+    /**
+     * @brief Obtém uma conexão do pool.
+     *
+     * Se o pool estiver vazio e o número de threads enfileiradas for menor que o máximo permitido, uma nova conexão é criada.
+     * Se o pool estiver vazio é bloqueada até que uma conexão fique disponível.
+     *
+     * @return Uma conexão SQLite válida ou nullptr em caso de erro.
+     */
+    sqlite3 *getConnectionFromPool()
+    {
+        auto waitStart = chrono::steady_clock::now();
+
+        unique_lock<mutex> lock(mutexLock);
+
+        if (isResetting || (connectionsQueue.empty() && queueSize >= maxQueueSize))
+        {
+            waitingThreads++;
+
+            while (isResetting || (connectionsQueue.empty() && queueSize >= maxQueueSize))
+            {
+                conditionToProceed.wait(lock);
+            }
+
+            waitingThreads--;
+        }
+
+        uint64_t waitNanoseconds = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - waitStart).count();
+
+        acquisitions++;
+        totalWaitNanoseconds += waitNanoseconds;
+        maxWaitNanoseconds = max(maxWaitNanoseconds, waitNanoseconds);
+        waitLatency.record(waitNanoseconds);
+
+        if (connectionsQueue.empty())
+        {
+            sqlite3 *connection = SQLiteDatabaseUtils::openConnection(databaseName, readOnly);
+
+            if (connection == nullptr)
+            {
+
+                LOGGER::error("Erro ao criar conexão para o poool");
+
+                return nullptr;
+            }
+
+            connectionsQueue.push(connection);
+        }
+
+        sqlite3 *connection = connectionsQueue.front();
+
+        connectionsQueue.pop();
+
+        queueSize++;
+
+        return connection;
+    }
+
+    /**
+     * @brief Retorna uma conexão ao pool.
+     *
+     * A conexão é devolvida ao pool e a thread que estava esperando por uma conexão é notificada.
+     *
+     * @param connection A conexão a ser devolvida ao pool.
+     */
+    void returnConnectionToPool(sqlite3 *connection)
+    {
+        lock_guard<mutex> lock(mutexLock);
+
+        connectionsQueue.push(connection);
+
+        queueSize--;
+
+        // notify_all porque além das threads esperando conexão pode haver um reset esperando o pool esvaziar
+        conditionToProceed.notify_all();
+    }
+
+    /**
+     * @brief Fecha todas as conexões, executa a troca do arquivo do banco e reabre o pool.
+     *
+     * Bloqueia novas retiradas de conexão e aguarda todas as conexões em uso serem devolvidas
+     * antes de fechar. Assim nenhuma conexão continua apontando para o arquivo antigo.
+     *
+     * @param swapDatabase Função executada com todas as conexões fechadas (ex.: trocar o arquivo).
+     * @return bool O retorno de swapDatabase.
+     */
+    bool resetConnections(const function<bool()> &swapDatabase)
+    {
+        unique_lock<mutex> lock(mutexLock);
+
+        isResetting = true;
+
+        while (queueSize > 0)
+        {
+            conditionToProceed.wait(lock);
+        }
+
+        while (!connectionsQueue.empty())
+        {
+            SQLiteDatabaseUtils::closeConnection(connectionsQueue.front());
+
+            connectionsQueue.pop();
+        }
+
+        bool success = swapDatabase();
+
+        for (int i = 0; i < maxConnections; i++)
+        {
+            sqlite3 *connection = SQLiteDatabaseUtils::openConnection(databaseName, readOnly);
+
+            if (connection != nullptr)
+            {
+                connectionsQueue.push(connection);
+            }
+            else
+            {
+                LOGGER::error("Erro ao recriar conexão no pool");
+            }
+        }
+
+        isResetting = false;
+
+        conditionToProceed.notify_all();
+
+        return success;
+    }
+
+    /**
+     * @brief Retorna os contadores de tempo de espera por conexão do pool.
+     *
+     * @return ConnectionPoolStats Os contadores do pool.
+     */
+    ConnectionPoolStats getStats()
+    {
+        lock_guard<mutex> lock(mutexLock);
+
+        return ConnectionPoolStats{poolName, acquisitions, totalWaitNanoseconds, maxWaitNanoseconds, queueSize, connectionsQueue.size(), waitingThreads};
+    }
+
+    /**
+     * @brief Histograma do tempo de espera por uma conexão (inclui o tempo do mutex).
+     */
+    const LatencyHistogram &getWaitLatency() const
+    {
+        return waitLatency;
+    }
+
+    /**
+     * @brief Destroi o objeto SQLiteConnectionPoolUtils.
+     *
+     * Fecha todas as conexões do pool.
+     */
+    ~SQLiteConnectionPoolUtils()
+    {
+        while (!connectionsQueue.empty())
+        {
+            sqlite3 *connection = connectionsQueue.front();
+
+            connectionsQueue.pop();
+
+            SQLiteDatabaseUtils::closeConnection(connection);
+        }
+    }
+
+private:
+    /**
+     * @brief Nome do pool.
+     */
+    string poolName;
+
+    /**
+     * @brief O arquivo do banco de dados.
+     */
+    string databaseName;
+
+    /**
+     * @brief Se as conexões são somente leitura.
+     */
+    bool readOnly;
+
+    /**
+     * @brief O número máximo de conexões que o pool pode manter.
+     */
+    int maxConnections;
+
+    /**
+     * @brief O número máximo de threads que podem ser enfileiradas esperando por uma conexão.
+     */
+    int maxQueueSize;
+
+    /**
+     * @brief A fila de conexões SQLite.
+     */
+    queue<sqlite3 *> connectionsQueue;
+
+    /**
+     * @brief O mutex para sincronizar o acesso ao pool.
+     */
+    mutex mutexLock;
+
+    /**
+     * @brief A variável de condição para notificar as threads que uma conexão está disponível.
+     */
+    condition_variable conditionToProceed;
+
+    /**
+     * @brief O número atual de threads enfileiradas esperando por uma conexão.
+     */
+    int queueSize = 0;
+
+    /**
+     * @brief Indica que resetConnections está em andamento e nenhuma conexão pode ser retirada.
+     */
+    bool isResetting = false;
+
+    /**
+     * @brief Quantidade de conexões retiradas do pool.
+     */
+    uint64_t acquisitions = 0;
+
+    /**
+     * @brief Soma do tempo de espera por conexão em nanossegundos.
+     */
+    uint64_t totalWaitNanoseconds = 0;
+
+    /**
+     * @brief Maior tempo de espera por conexão em nanossegundos.
+     */
+    uint64_t maxWaitNanoseconds = 0;
+
+    /**
+     * @brief Threads bloqueadas em conditionToProceed.
+     */
+    int waitingThreads = 0;
+
+    /**
+     * @brief Distribuição do tempo de espera por uma conexão.
+     */
+    LatencyHistogram waitLatency;
+};
+
+#endif // GARNIZE_SQLITE_UTILS_H
@@ -0,0 +1,100 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file string_utils.h
+ * @brief Funções utilitárias de texto sem dependência da camada HTTP (StringUtils).
+ */
+
+#ifndef GARNIZE_STRING_UTILS_H
+#define GARNIZE_STRING_UTILS_H
+
+#include "common.h"
+
+/**
+ * @class StringUtils
+ * @brief Classe utilitária com funções de texto usadas por mais de uma camada (HTTP, TimeUtils).
+ */
+class StringUtils
+{
+public:
+    /**
+     * @brief Decodifica as sequências "%XX" de um valor URL-encoded (ex.: um valor da query string).
+     *
+     * O '+' é mantido como '+' (e não espaço) para não quebrar fusos horários como "+03:00".
+     *
+     * @param input O valor URL-encoded.
+     * @param output Buffer com pelo menos input.size() bytes.
+     * @return size_t O tamanho do valor decodificado, ou string_view::npos se houver uma sequência inválida.
+     */
+    static size_t urlDecode(string_view input, char *output)
+    {
+        size_t length = 0;
+
+        for (size_t i = 0; i < input.size(); i++)
+        {
+            if (input[i] != '%')
+            {
+                output[length++] = input[i];
+                continue;
+            }
+
+            int high = hexValue(i + 1 < input.size() ? input[i + 1] : '\0');
+            int low = hexValue(i + 2 < input.size() ? input[i + 2] : '\0');
+
+            if (high < 0 || low < 0)
+            {
+                return string_view::npos;
+            }
+
+            output[length++] = static_cast<char>(high * 16 + low);
+            i += 2;
+        }
+
+        return length;
+    }
+
+private:
+    static int hexValue(char character)
+    {
+        if (character >= '0' && character <= '9')
+        {
+            return character - '0';
+        }
+
+        if (character >= 'a' && character <= 'f')
+        {
+            return character - 'a' + 10;
+        }
+
+        if (character >= 'A' && character <= 'F')
+        {
+            return character - 'A' + 10;
+        }
+
+        return -1;
+    }
+};
+
+#endif // GARNIZE_STRING_UTILS_H
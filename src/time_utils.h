@@ -0,0 +1,366 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file time_utils.h
+ * @brief Formatação e parse de timestamps ISO 8601 em UTC (TimeUtils).
+ */
+
+#ifndef GARNIZE_TIME_UTILS_H
+#define GARNIZE_TIME_UTILS_H
+
+#include "common.h"
+#include "string_utils.h"
+
+/**
+ * @brief Classe responsável por fornecer utilitários de tempo.
+ */
+class TimeUtils
+{
+public:
+    /**
+     * @brief Retorna o timestamp atual no formato ISO 8601 em UTC.
+     *
+     * O formato retornado é "YYYY-MM-DDTHH:MM:SS.sssZ", onde:
+     * - YYYY é o ano em 4 dígitos
+     * - MM é o mês em 2 dígitos
+     * - DD é o dia do mês em 2 dígitos
+     * - T é o caractere separador entre data e hora
+     * - HH é a hora em 24 horas
+     * - MM é o minuto
+     * - SS é o segundo
+     * - sss é a fração de segundo em milissegundos
+     * - Z é o caractere que indica que o tempo está em UTC
+     *
+     * @return std::string Timestamp no formato ISO 8601 em UTC.
+     */
+    static string getTimestampUTC()
+    {
+        return formatTimestampUTC(getEpochMillisUTC());
+    }
+
+    /**
+     * @brief Retorna o instante atual em milissegundos desde a epoch (UTC).
+     *
+     * @return int64_t Milissegundos desde 1970-01-01T00:00:00.000Z.
+     */
+    static int64_t getEpochMillisUTC()
+    {
+        return chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Converte um timestamp ISO 8601 para milissegundos desde a epoch (UTC).
+     *
+     * Aceita "YYYY-MM-DDTHH:MM:SS", com fração de segundo opcional (1 a 9 dígitos, truncada em milissegundos)
+     * e fuso opcional ("Z" ou "+HH:MM" / "-HH:MM"). O texto pode estar URL-encoded (ex.: "%3A" no lugar de ":"),
+     * como chega na query string do /payments-summary. Não usa sscanf, timegm nem alocação.
+     *
+     * @param timestamp O timestamp em texto.
+     * @param epochMillis Recebe os milissegundos desde a epoch.
+     * @return true se o timestamp é válido, false caso contrário.
+     */
+    static bool parseTimestampUTC(string_view timestamp, int64_t &epochMillis)
+    {
+        char decoded[TIMESTAMP_INPUT_MAX_SIZE];
+
+        if (timestamp.find('%') != string_view::npos)
+        {
+            if (timestamp.size() > sizeof(decoded))
+            {
+                return false;
+            }
+
+            size_t length = StringUtils::urlDecode(timestamp, decoded);
+
+            if (length == string_view::npos)
+            {
+                return false;
+            }
+
+            timestamp = string_view(decoded, length);
+        }
+
+        // YYYY-MM-DDTHH:MM:SS
+        if (timestamp.size() < 19 || timestamp[4] != '-' || timestamp[7] != '-' || (timestamp[10] != 'T' && timestamp[10] != 't' && timestamp[10] != ' ') ||
+            timestamp[13] != ':' || timestamp[16] != ':')
+        {
+            return false;
+        }
+
+        int year, month, day, hour, minute, second;
+
+        if (!parseDigits(timestamp, 0, 4, year) || !parseDigits(timestamp, 5, 2, month) || !parseDigits(timestamp, 8, 2, day) ||
+            !parseDigits(timestamp, 11, 2, hour) || !parseDigits(timestamp, 14, 2, minute) || !parseDigits(timestamp, 17, 2, second))
+        {
+            return false;
+        }
+
+        if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) || hour > 23 || minute > 59 || second > 60)
+        {
+            return false;
+        }
+
+        size_t pos = 19;
+        int64_t millis = 0;
+
+        // Fração de segundo opcional, considerando somente os 3 primeiros dígitos
+        if (pos < timestamp.size() && timestamp[pos] == '.')
+        {
+            size_t digits = 0;
+
+            for (pos++; pos < timestamp.size() && timestamp[pos] >= '0' && timestamp[pos] <= '9'; pos++, digits++)
+            {
+                if (digits < 3)
+                {
+                    millis = millis * 10 + (timestamp[pos] - '0');
+                }
+            }
+
+            if (digits == 0 || digits > 9)
+            {
+                return false;
+            }
+
+            for (; digits < 3; digits++)
+            {
+                millis *= 10;
+            }
+        }
+
+        int64_t offsetSeconds = 0;
+
+        if (pos < timestamp.size() && (timestamp[pos] == 'Z' || timestamp[pos] == 'z'))
+        {
+            pos++;
+        }
+        else if (pos < timestamp.size() && (timestamp[pos] == '+' || timestamp[pos] == '-'))
+        {
+            int offsetHours, offsetMinutes;
+            size_t minutesPos = pos + 3 < timestamp.size() && timestamp[pos + 3] == ':' ? pos + 4 : pos + 3;
+
+            if (!parseDigits(timestamp, pos + 1, 2, offsetHours) || !parseDigits(timestamp, minutesPos, 2, offsetMinutes) || offsetHours > 23 || offsetMinutes > 59)
+            {
+                return false;
+            }
+
+            offsetSeconds = (timestamp[pos] == '+' ? 1 : -1) * (offsetHours * 3600 + offsetMinutes * 60);
+            pos = minutesPos + 2;
+        }
+
+        if (pos != timestamp.size())
+        {
+            return false;
+        }
+
+        int64_t seconds = daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second - offsetSeconds;
+
+        epochMillis = seconds * 1000 + millis;
+
+        return true;
+    }
+
+    /**
+     * @brief Tamanho máximo de um timestamp formatado por formatTimestampUTC (anos de até 12 dígitos).
+     */
+    static const size_t TIMESTAMP_MAX_SIZE = 32;
+
+    /**
+     * @brief Formata milissegundos desde a epoch no formato ISO 8601 em UTC ("YYYY-MM-DDTHH:MM:SS.sssZ").
+     *
+     * @param epochMillis Milissegundos desde a epoch.
+     * @return std::string Timestamp no formato ISO 8601 em UTC.
+     */
+    static string formatTimestampUTC(int64_t epochMillis)
+    {
+        char buffer[TIMESTAMP_MAX_SIZE];
+
+        return string(buffer, formatTimestampUTC(epochMillis, buffer));
+    }
+
+    /**
+     * @brief Escreve o timestamp ISO 8601 em UTC no buffer do chamador, sem alocação.
+     *
+     * Cada thread guarda a data e a hora do último segundo formatado: enquanto o segundo não muda, só os
+     * milissegundos são escritos. Quando muda, a data é calculada por aritmética (sem gmtime).
+     *
+     * @param epochMillis Milissegundos desde a epoch.
+     * @param buffer Buffer com pelo menos TIMESTAMP_MAX_SIZE bytes.
+     * @return char* Ponteiro para depois do último caractere escrito (sem '\0').
+     */
+    static char *formatTimestampUTC(int64_t epochMillis, char *buffer)
+    {
+        thread_local FormattedSecond cache;
+
+        int64_t seconds = epochMillis / 1000;
+        int millis = static_cast<int>(epochMillis % 1000);
+
+        // Divisão com arredondamento para baixo (instantes antes da epoch)
+        if (millis < 0)
+        {
+            seconds--;
+            millis += 1000;
+        }
+
+        if (seconds != cache.second)
+        {
+            cache.second = seconds;
+            cache.length = formatSecond(seconds, cache.text) - cache.text;
+        }
+
+        memcpy(buffer, cache.text, cache.length);
+        buffer += cache.length;
+
+        buffer[0] = '.';
+        buffer[1] = static_cast<char>('0' + millis / 100);
+        buffer[2] = static_cast<char>('0' + millis / 10 % 10);
+        buffer[3] = static_cast<char>('0' + millis % 10);
+        buffer[4] = 'Z';
+
+        return buffer + 5;
+    }
+
+    /**
+     * @brief Quantidade de dias desde 1970-01-01 de uma data do calendário gregoriano (algoritmo de Howard Hinnant).
+     */
+    static int64_t daysFromCivil(int64_t year, int month, int day)
+    {
+        year -= month <= 2;
+
+        int64_t era = (year >= 0 ? year : year - 399) / 400;
+        int64_t yearOfEra = year - era * 400;
+        int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+        int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+
+        return era * 146097 + dayOfEra - 719468;
+    }
+
+private:
+    /**
+     * @brief Tamanho máximo aceito para um timestamp de entrada (antes do URL decode).
+     */
+    static const size_t TIMESTAMP_INPUT_MAX_SIZE = 64;
+
+    /**
+     * @brief Data e hora ("YYYY-MM-DDTHH:MM:SS") do último segundo formatado por uma thread.
+     */
+    struct FormattedSecond
+    {
+        int64_t second = numeric_limits<int64_t>::min();
+        char text[TIMESTAMP_MAX_SIZE];
+        size_t length = 0;
+    };
+
+    /**
+     * @brief Escreve "YYYY-MM-DDTHH:MM:SS" para os segundos desde a epoch (inverso de daysFromCivil).
+     */
+    static char *formatSecond(int64_t seconds, char *buffer)
+    {
+        int64_t days = seconds / 86400;
+        int64_t secondOfDay = seconds % 86400;
+
+        if (secondOfDay < 0)
+        {
+            days--;
+            secondOfDay += 86400;
+        }
+
+        days += 719468;
+
+        int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+        int64_t dayOfEra = days - era * 146097;
+        int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+        int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+        int64_t shiftedMonth = (5 * dayOfYear + 2) / 153;
+        int day = static_cast<int>(dayOfYear - (153 * shiftedMonth + 2) / 5 + 1);
+        int month = static_cast<int>(shiftedMonth < 10 ? shiftedMonth + 3 : shiftedMonth - 9);
+        int64_t year = yearOfEra + era * 400 + (month <= 2);
+
+        // Anos com menos de 4 dígitos são completados com zeros
+        if (year >= 0 && year < 1000)
+        {
+            for (int64_t divisor = 1000; divisor > year && divisor > 1; divisor /= 10)
+            {
+                *buffer++ = '0';
+            }
+        }
+
+        buffer = to_chars(buffer, buffer + 20, year).ptr;
+        buffer = writeTwoDigits(buffer, '-', month);
+        buffer = writeTwoDigits(buffer, '-', day);
+        buffer = writeTwoDigits(buffer, 'T', static_cast<int>(secondOfDay / 3600));
+        buffer = writeTwoDigits(buffer, ':', static_cast<int>(secondOfDay / 60 % 60));
+        buffer = writeTwoDigits(buffer, ':', static_cast<int>(secondOfDay % 60));
+
+        return buffer;
+    }
+
+    /**
+     * @brief Lê `count` dígitos decimais a partir de `pos`.
+     */
+    static bool parseDigits(string_view text, size_t pos, size_t count, int &value)
+    {
+        if (pos + count > text.size())
+        {
+            return false;
+        }
+
+        value = 0;
+
+        for (size_t i = pos; i < pos + count; i++)
+        {
+            if (text[i] < '0' || text[i] > '9')
+            {
+                return false;
+            }
+
+            value = value * 10 + (text[i] - '0');
+        }
+
+        return true;
+    }
+
+    static int daysInMonth(int year, int month)
+    {
+        static const int DAYS[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+
+        bool leapYear = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+
+        return month == 2 && leapYear ? 29 : DAYS[month - 1];
+    }
+
+    /**
+     * @brief Escreve o separador seguido de um número de 2 dígitos.
+     */
+    static char *writeTwoDigits(char *buffer, char separator, int value)
+    {
+        buffer[0] = separator;
+        buffer[1] = static_cast<char>('0' + value / 10);
+        buffer[2] = static_cast<char>('0' + value % 10);
+
+        return buffer + 3;
+    }
+};
+
+#endif // GARNIZE_TIME_UTILS_H
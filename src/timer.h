@@ -0,0 +1,77 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file timer.h
+ * @brief Cronômetro de trechos de código (Timer).
+ */
+
+#ifndef GARNIZE_TIMER_H
+#define GARNIZE_TIMER_H
+
+#include "common.h"
+#include "logger.h"
+
+/**
+ * @brief Classe que mede o tempo de execução de um bloco de código.
+ *
+ * Esta classe utiliza a biblioteca `std::chrono` para medir o tempo decorrido entre
+ * a construção e destruição de um objeto desta classe.
+ */
+class Timer
+{
+public:
+    /**
+     * @brief Construtor que inicia o temporizador.
+     *
+     * Registra o tempo atual utilizando `std::chrono::high_resolution_clock`.
+     */
+    Timer() : start(chrono::high_resolution_clock::now()) {}
+
+    /**
+     * @brief Destrutor que para o temporizador e imprime o tempo decorrido.
+     *
+     * Calcula a duração entre o tempo de início e fim e imprime
+     * o resultado no console.
+     */
+    ~Timer()
+    {
+        auto end = chrono::high_resolution_clock::now();
+        auto duration_ms = chrono::duration_cast<chrono::milliseconds>(end - start);
+        auto duration_us = chrono::duration_cast<chrono::microseconds>(end - start);
+        auto duration_ns = chrono::duration_cast<chrono::nanoseconds>(end - start);
+
+        LOGGER::info("Tempo de execução da request: ", duration_ms.count(), " ms (", duration_us.count(), " us / ", duration_ns.count(), " ns)");
+    }
+
+private:
+    /**
+     * @brief Ponto de tempo de início.
+     *
+     * Registra o ponto de tempo quando o objeto é construído.
+     */
+    chrono::time_point<chrono::high_resolution_clock> start;
+};
+
+#endif // GARNIZE_TIMER_H
@@ -0,0 +1,244 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file tracer.h
+ * @brief Trace por etapa em buffers por thread (Tracer / TraceSpan).
+ */
+
+#ifndef GARNIZE_TRACER_H
+#define GARNIZE_TRACER_H
+
+#include "common.h"
+#include "constants.h"
+
+#ifndef GARNIZE_TRACE_ENABLED
+/**
+ * @brief Habilita os spans do Tracer (-DGARNIZE_TRACE_ENABLED=0 remove todos em tempo de compilação).
+ */
+#define GARNIZE_TRACE_ENABLED 1
+#endif
+
+/**
+ * @brief Registro de spans (trechos cronometrados) em buffers circulares por thread.
+ *
+ * Cada thread pega um buffer livre no primeiro span e o devolve quando termina; o conteúdo continua lá
+ * até ser sobrescrito, então os spans de threads que já terminaram também aparecem no trace. Só a thread
+ * dona escreve no buffer (sem lock nem CAS); cada evento tem um número de versão (seqlock) para que
+ * writeChromeTrace possa ler os buffers ao mesmo tempo e descartar os eventos que estavam sendo escritos.
+ */
+class Tracer
+{
+public:
+    /**
+     * @brief Indica se os spans foram compilados.
+     */
+    static constexpr bool ENABLED = GARNIZE_TRACE_ENABLED != 0;
+
+    /**
+     * @brief Tempo monotônico em nanossegundos.
+     */
+    static uint64_t now()
+    {
+        return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * @brief Registra um span da thread corrente.
+     *
+     * @param name Nome do span (deve ser uma string estática).
+     * @param start Início, em Tracer::now().
+     * @param end Fim, em Tracer::now().
+     */
+    static void record(const char *name, uint64_t start, uint64_t end)
+    {
+        ThreadBuffer *buffer = owner.acquire();
+
+        if (buffer == nullptr)
+        {
+            return;
+        }
+
+        Event &event = buffer->events[buffer->next++ % Constants::TRACE_EVENTS_PER_THREAD];
+        uint64_t version = event.version.load(memory_order_relaxed);
+
+        event.version.store(version + 1, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+
+        event.name.store(name, memory_order_relaxed);
+        event.start.store(start, memory_order_relaxed);
+        event.duration.store(end - start, memory_order_relaxed);
+        event.threadId.store(owner.threadId, memory_order_relaxed);
+
+        event.version.store(version + 2, memory_order_release);
+    }
+
+    /**
+     * @brief Escreve os spans de todos os buffers no formato JSON trace_event do Chrome (eventos "X").
+     */
+    static void writeChromeTrace(pmr::string &output)
+    {
+        char number[32];
+        bool first = true;
+
+        output.append("{\"displayTimeUnit\": \"ns\", \"traceEvents\": [");
+
+        for (const ThreadBuffer &buffer : buffers)
+        {
+            for (const Event &event : buffer.events)
+            {
+                uint64_t version = event.version.load(memory_order_acquire);
+
+                if (version == 0 || (version & 1) != 0)
+                {
+                    continue;
+                }
+
+                const char *name = event.name.load(memory_order_relaxed);
+                uint64_t start = event.start.load(memory_order_relaxed);
+                uint64_t duration = event.duration.load(memory_order_relaxed);
+                uint32_t threadId = event.threadId.load(memory_order_relaxed);
+
+                atomic_thread_fence(memory_order_acquire);
+
+                if (event.version.load(memory_order_relaxed) != version)
+                {
+                    continue;
+                }
+
+                output.append(first ? "\n" : ",\n").append("{\"name\": \"").append(name).append("\", \"cat\": \"garnize\", \"ph\": \"X\", \"pid\": 1, \"tid\": ");
+                output.append(number, to_chars(number, number + sizeof(number), threadId).ptr);
+                output.append(", \"ts\": ");
+                output.append(number, to_chars(number, number + sizeof(number), start / 1000.0, chars_format::fixed, 3).ptr);
+                output.append(", \"dur\": ");
+                output.append(number, to_chars(number, number + sizeof(number), duration / 1000.0, chars_format::fixed, 3).ptr);
+                output.push_back('}');
+
+                first = false;
+            }
+        }
+
+        output.append("\n]}");
+    }
+
+private:
+    /**
+     * @brief Um span gravado (os campos são atômicos porque podem ser lidos durante a escrita).
+     */
+    struct Event
+    {
+        atomic<uint64_t> version{0};
+        atomic<const char *> name{nullptr};
+        atomic<uint64_t> start{0};
+        atomic<uint64_t> duration{0};
+        atomic<uint32_t> threadId{0};
+    };
+
+    /**
+     * @brief Buffer circular de uma thread.
+     */
+    struct ThreadBuffer
+    {
+        atomic<bool> owned{false};
+        uint64_t next = 0;
+        array<Event, Constants::TRACE_EVENTS_PER_THREAD> events;
+    };
+
+    /**
+     * @brief Buffer da thread corrente, devolvido ao pool quando a thread termina.
+     */
+    struct Owner
+    {
+        ThreadBuffer *buffer = nullptr;
+        bool exhausted = false;
+        uint32_t threadId = 0;
+
+        ThreadBuffer *acquire()
+        {
+            if (buffer != nullptr || exhausted)
+            {
+                return buffer;
+            }
+
+            for (ThreadBuffer &candidate : buffers)
+            {
+                if (!candidate.owned.load(memory_order_relaxed) && !candidate.owned.exchange(true, memory_order_acquire))
+                {
+                    buffer = &candidate;
+                    threadId = nextThreadId.fetch_add(1, memory_order_relaxed) + 1;
+
+                    return buffer;
+                }
+            }
+
+            // Todos os buffers estão em uso: essa thread não registra spans
+            exhausted = true;
+
+            return nullptr;
+        }
+
+        ~Owner()
+        {
+            if (buffer != nullptr)
+            {
+                buffer->owned.store(false, memory_order_release);
+            }
+        }
+    };
+
+    static array<ThreadBuffer, Constants::TRACE_THREAD_BUFFERS> buffers;
+    static atomic<uint32_t> nextThreadId;
+    static thread_local Owner owner;
+};
+
+/**
+ * @brief Span com escopo: registra no Tracer o tempo entre a construção e a destruição.
+ *
+ * Uso: TraceSpan span("sqlite.insert");
+ */
+class TraceSpan
+{
+public:
+    /**
+     * @param name Nome do span (deve ser uma string estática).
+     */
+    explicit TraceSpan(const char *name) : name(name), start(Tracer::ENABLED ? Tracer::now() : 0) {}
+
+    ~TraceSpan()
+    {
+        if constexpr (Tracer::ENABLED)
+        {
+            Tracer::record(name, start, Tracer::now());
+        }
+    }
+
+    TraceSpan(const TraceSpan &) = delete;
+    TraceSpan &operator=(const TraceSpan &) = delete;
+
+private:
+    const char *name;
+    uint64_t start;
+};
+
+#endif // GARNIZE_TRACER_H
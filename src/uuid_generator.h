@@ -0,0 +1,304 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file uuid_generator.h
+ * @brief Geração e conversão de UUIDv7 (UUIDGenerator).
+ */
+
+#ifndef GARNIZE_UUID_GENERATOR_H
+#define GARNIZE_UUID_GENERATOR_H
+
+#include "common.h"
+#include "logger.h"
+#include "time_utils.h"
+
+/**
+ * @brief Classe responsável por gerar UUIDs (Universally Unique Identifiers).
+ *
+ * Gera UUIDv7 (RFC 9562): 48 bits com os milissegundos desde a epoch, seguidos de um contador de 12 bits
+ * por thread (rand_a) e 62 bits aleatórios. Os IDs de uma thread são estritamente crescentes e os de
+ * threads diferentes ficam ordenados por milissegundo, o que mantém os inserts no fim de um índice.
+ *
+ * Os bits aleatórios vêm de um xoshiro256** por thread, semeado a partir de uma semente do getrandom()
+ * (lida uma única vez) misturada com um contador global: sem syscall nem lock por UUID.
+ */
+class UUIDGenerator
+{
+public:
+    /**
+     * @brief Gera um UUIDv7.
+     *
+     * @return Um UUID gerado como uma string.
+     */
+    static string createUUID()
+    {
+        uint8_t UUID[16];
+        char UUIDString[36];
+
+        createUUID(UUID);
+
+        return string(UUIDString, toChars(UUID, UUIDString));
+    }
+
+    /**
+     * @brief Gera um UUIDv7 no formato binário (16 bytes) com o instante atual.
+     *
+     * @param UUID Array que recebe os 16 bytes do UUID.
+     */
+    static void createUUID(uint8_t (&UUID)[16])
+    {
+        createUUID(UUID, TimeUtils::getEpochMillisUTC());
+    }
+
+    /**
+     * @brief Gera um UUIDv7 no formato binário (16 bytes) para o instante informado.
+     *
+     * Se o contador de 12 bits do milissegundo se esgotar, o timestamp do UUID avança 1 ms (RFC 9562, 6.2),
+     * mantendo a ordem.
+     *
+     * @param UUID Array que recebe os 16 bytes do UUID.
+     * @param epochMillis Milissegundos desde a epoch.
+     */
+    static void createUUID(uint8_t (&UUID)[16], int64_t epochMillis)
+    {
+        thread_local GeneratorState state;
+
+        uint64_t random = state.next();
+        uint64_t millis = static_cast<uint64_t>(epochMillis);
+
+        if (millis > state.lastMillis)
+        {
+            state.lastMillis = millis;
+            // Começa na metade inferior para deixar espaço para incrementos no mesmo milissegundo
+            state.counter = static_cast<uint16_t>(random >> 53);
+        }
+        else if (++state.counter > 0xFFF)
+        {
+            state.lastMillis++;
+            state.counter = 0;
+        }
+
+        millis = state.lastMillis;
+
+        for (int i = 0; i < 6; i++)
+        {
+            UUID[i] = static_cast<uint8_t>(millis >> (40 - 8 * i));
+        }
+
+        UUID[6] = static_cast<uint8_t>(0x70 | (state.counter >> 8)); // versão 7
+        UUID[7] = static_cast<uint8_t>(state.counter);
+
+        uint64_t randomB = state.next();
+
+        for (int i = 0; i < 8; i++)
+        {
+            UUID[8 + i] = static_cast<uint8_t>(randomB >> (56 - 8 * i));
+        }
+
+        UUID[8] = static_cast<uint8_t>(0x80 | (UUID[8] & 0x3F)); // variante RFC 9562
+    }
+
+    /**
+     * @brief Converte um UUID binário para a representação textual (36 caracteres).
+     *
+     * @param UUID Os 16 bytes do UUID.
+     * @return Um UUID como uma string.
+     */
+    static string toString(const uint8_t (&UUID)[16])
+    {
+        char UUIDString[36];
+
+        return string(UUIDString, toChars(UUID, UUIDString));
+    }
+
+    /**
+     * @brief Escreve a representação textual do UUID (36 caracteres minúsculos, sem '\0') no buffer do chamador.
+     *
+     * @param UUID Os 16 bytes do UUID.
+     * @param buffer Buffer com pelo menos 36 bytes.
+     * @return char* Ponteiro para depois do último caractere escrito.
+     */
+    static char *toChars(const uint8_t (&UUID)[16], char *buffer)
+    {
+        static const char HEX[] = "0123456789abcdef";
+
+        for (int i = 0; i < 16; i++)
+        {
+            // Hífens antes dos bytes 4, 6, 8 e 10 (8-4-4-4-12)
+            if (i == 4 || i == 6 || i == 8 || i == 10)
+            {
+                *buffer++ = '-';
+            }
+
+            buffer[0] = HEX[UUID[i] >> 4];
+            buffer[1] = HEX[UUID[i] & 0x0F];
+            buffer += 2;
+        }
+
+        return buffer;
+    }
+
+    /**
+     * @brief Converte a representação textual (8-4-4-4-12, maiúsculas ou minúsculas) para os 16 bytes do UUID.
+     *
+     * @param text O UUID em texto.
+     * @param UUID Array que recebe os 16 bytes do UUID.
+     * @return bool False se o texto não for um UUID válido.
+     */
+    static bool fromString(string_view text, uint8_t (&UUID)[16])
+    {
+        if (text.size() != 36 || text[8] != '-' || text[13] != '-' || text[18] != '-' || text[23] != '-')
+        {
+            return false;
+        }
+
+        size_t pos = 0;
+
+        for (int i = 0; i < 16; i++)
+        {
+            if (pos == 8 || pos == 13 || pos == 18 || pos == 23)
+            {
+                pos++;
+            }
+
+            int high = HEX_VALUES[static_cast<unsigned char>(text[pos])];
+            int low = HEX_VALUES[static_cast<unsigned char>(text[pos + 1])];
+
+            if ((high | low) < 0)
+            {
+                return false;
+            }
+
+            UUID[i] = static_cast<uint8_t>(high << 4 | low);
+            pos += 2;
+        }
+
+        return true;
+    }
+
+private:
+    /**
+     * @brief Estado por thread: o gerador xoshiro256**, o último milissegundo usado e o contador dentro dele.
+     */
+    struct GeneratorState
+    {
+        uint64_t s[4];
+        uint64_t lastMillis = 0;
+        uint16_t counter = 0;
+
+        GeneratorState()
+        {
+            // Cada thread recebe uma semente diferente derivada da semente do processo
+            uint64_t seed = processSeed ^ splitMix64(threadCounter.fetch_add(1, memory_order_relaxed));
+
+            for (uint64_t &word : s)
+            {
+                word = splitMix64(seed);
+                seed += 0x9E3779B97F4A7C15ULL;
+            }
+        }
+
+        /**
+         * @brief Próximo número do xoshiro256**.
+         */
+        uint64_t next()
+        {
+            uint64_t result = rotateLeft(s[1] * 5, 7) * 9;
+            uint64_t t = s[1] << 17;
+
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = rotateLeft(s[3], 45);
+
+            return result;
+        }
+    };
+
+    static uint64_t rotateLeft(uint64_t value, int bits)
+    {
+        return (value << bits) | (value >> (64 - bits));
+    }
+
+    static uint64_t splitMix64(uint64_t value)
+    {
+        value += 0x9E3779B97F4A7C15ULL;
+        value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+
+        return value ^ (value >> 31);
+    }
+
+    /**
+     * @brief Lê a semente do processo do gerador do kernel (getrandom), uma única vez.
+     */
+    static uint64_t readProcessSeed()
+    {
+        uint64_t seed;
+
+        if (getrandom(&seed, sizeof(seed), 0) != static_cast<ssize_t>(sizeof(seed)))
+        {
+            LOGGER::error("Erro ao ler a semente do gerador de UUIDs (getrandom)");
+
+            seed = static_cast<uint64_t>(chrono::steady_clock::now().time_since_epoch().count()) ^ static_cast<uint64_t>(getpid());
+        }
+
+        return seed;
+    }
+
+    /**
+     * @brief Valor de cada caractere hexadecimal (-1 para os demais).
+     */
+    static constexpr array<int8_t, 256> HEX_VALUES = []()
+    {
+        array<int8_t, 256> values{};
+
+        for (int i = 0; i < 256; i++)
+        {
+            values[i] = -1;
+        }
+
+        for (int i = 0; i < 10; i++)
+        {
+            values['0' + i] = static_cast<int8_t>(i);
+        }
+
+        for (int i = 0; i < 6; i++)
+        {
+            values['a' + i] = static_cast<int8_t>(10 + i);
+            values['A' + i] = static_cast<int8_t>(10 + i);
+        }
+
+        return values;
+    }();
+
+    inline static const uint64_t processSeed = readProcessSeed();
+
+    inline static atomic<uint64_t> threadCounter{0};
+};
+
+#endif // GARNIZE_UUID_GENERATOR_H
@@ -0,0 +1,950 @@
+/*
+ * The MIT License
+ *
+ * Copyright 2025 juliano.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+/**
+ * @file tests.cpp
+ * @brief Testes de corretude das rotinas do caminho quente do servidor.
+ *
+ * Usa as classes do servidor (src/garnize.h, ligado com a libgarnize.a) e as implementações anteriores
+ * (benchmark/legacy.h) como referência: a saída das versões atuais precisa ser idêntica.
+ *
+ * Compilar e rodar: ./compile.sh --test [--filter <grupo>]
+ */
+
+#include "../src/garnize.h"
+#include "../benchmark/legacy.h"
+
+#include <fstream>
+#include <random>
+#include <set>
+#include <uuid/uuid.h>
+
+// Com o operator new / delete substituídos (malloc / free) o GCC 12 acusa falsos positivos de -Wmismatched-new-delete
+// quando o delete é inlinado junto com alocações de containers
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+/**
+ * @brief Quantidade de chamadas ao operator new (heap) feitas pelo processo.
+ */
+static atomic<size_t> heapAllocations{0};
+
+void *operator new(size_t size)
+{
+    heapAllocations.fetch_add(1, memory_order_relaxed);
+
+    if (void *pointer = malloc(size != 0 ? size : 1))
+    {
+        return pointer;
+    }
+
+    throw bad_alloc();
+}
+
+void operator delete(void *pointer) noexcept
+{
+    free(pointer);
+}
+
+void operator delete(void *pointer, size_t) noexcept
+{
+    free(pointer);
+}
+
+/**
+ * @brief Registra as verificações dos testes.
+ *
+ * Uma verificação que falha é impressa e contada, e os testes seguintes continuam rodando;
+ * o código de saída do programa indica se houve alguma falha.
+ */
+class Tests
+{
+public:
+    /**
+     * @brief Inicia um grupo de testes (imprime o título).
+     */
+    static void section(const string &title)
+    {
+        cout << endl
+             << "# " << title << endl;
+    }
+
+    /**
+     * @brief Conta uma verificação e imprime a mensagem se ela falhar.
+     */
+    static void check(bool condition, const string &message)
+    {
+        checks++;
+
+        if (!condition)
+        {
+            failures++;
+            cerr << "FALHOU: " << message << endl;
+        }
+    }
+
+    /**
+     * @brief Retorna a quantidade de alocações na heap feitas por uma chamada de `function`.
+     */
+    template <typename Function>
+    static size_t countAllocations(Function &&function)
+    {
+        size_t before = heapAllocations.load(memory_order_relaxed);
+
+        function();
+
+        return heapAllocations.load(memory_order_relaxed) - before;
+    }
+
+    static size_t getChecks()
+    {
+        return checks;
+    }
+
+    static size_t getFailures()
+    {
+        return failures;
+    }
+
+private:
+    inline static size_t checks = 0;
+    inline static size_t failures = 0;
+};
+
+/**
+ * @brief JsonParser: mesmos campos e mesmo amount que o LegacyJsonParser nos JSONs que o servidor recebe.
+ */
+static void testJsonParser()
+{
+    const string PAYMENT = R"({"correlationId": "4a7901b8-7d26-4d9d-aa19-4dc1c7cf60b3", "amount": 19.90})";
+    const string HEALTH_CHECK = R"({ "failing": false, "minResponseTime": 100 })";
+    const string SUMMARY = R"({"totalRequests": 43236, "totalAmount": 415542345.98, "totalFee": 415542.34, "feePerTransaction": 0.01})";
+
+    Tests::section("JsonParser");
+
+    for (const string *json : {&PAYMENT, &HEALTH_CHECK, &SUMMARY})
+    {
+        map<string, string> legacy = LegacyJsonParser::parseJson(*json);
+        JsonObject object;
+
+        Tests::check(JsonParser::parse(*json, object) && object.size() == legacy.size(), "quantidade de campos: " + *json);
+    }
+
+    JsonObject payment;
+    int64_t amountInCents;
+
+    Tests::check(JsonParser::parse(PAYMENT, payment) && payment.getAmountInCents("amount", amountInCents) &&
+                     amountInCents == llround(stod(LegacyJsonParser::parseJson(PAYMENT).at("amount")) * 100),
+                 "amount do pagamento");
+}
+
+/**
+ * @brief SimdScanner: as implementações SSE4.2 / AVX2 concordam com a escalar.
+ */
+static void testSimdScanner()
+{
+    const string PROXIED_REQUEST =
+        "POST /payments HTTP/1.1\r\n"
+        "Host: localhost:9999\r\n"
+        "X-Forwarded-For: 203.0.113.195, 70.41.3.18, 150.172.238.178\r\n"
+        "Content-Length: 70\r\n"
+        "Content-Type: application/json\r\n"
+        "\r\n"
+        R"({"correlationId": "4a7901b8-7d26-4d9d-aa19-4dc1c7cf60b3", "amount": 19.90})";
+
+    // Resposta de processador com strings longas (mensagem de erro e detalhes)
+    string processorResponse = R"({"message": ")" + string(600, 'x') + R"(", "detail": ")" + string(1200, 'y') + R"(", "totalRequests": 43236, "totalAmount": 415542345.98})";
+
+    Tests::section(string("SimdScanner (") + SimdScanner::getInstructionSet() + ")");
+
+    using ScanFunction = const char *(*)(const char *, const char *);
+
+    vector<pair<string, ScanFunction>> headerEnd = {{"escalar", SimdScanner::findHeaderEndScalar}};
+    vector<pair<string, ScanFunction>> stringSpecial = {{"escalar", SimdScanner::findStringSpecialScalar}};
+
+#if defined(__x86_64__) || defined(__i386__)
+    if (__builtin_cpu_supports("sse4.2"))
+    {
+        headerEnd.push_back({"sse4.2", SimdScanner::findHeaderEndSse42});
+        stringSpecial.push_back({"sse4.2", SimdScanner::findStringSpecialSse42});
+    }
+
+    if (__builtin_cpu_supports("avx2"))
+    {
+        headerEnd.push_back({"avx2", SimdScanner::findHeaderEndAvx2});
+        stringSpecial.push_back({"avx2", SimdScanner::findStringSpecialAvx2});
+    }
+#endif
+
+    // Todas as implementações precisam concordar com a escalar em entradas aleatórias
+    mt19937 random(42);
+    const char ALPHABET[] = "\r\n\"\\ab:,{}\x01";
+
+    for (int round = 0; round < 20000; round++)
+    {
+        string input(random() % 100, 'a');
+
+        for (char &character : input)
+        {
+            character = random() % 4 == 0 ? ALPHABET[random() % (sizeof(ALPHABET) - 1)] : 'a';
+        }
+
+        const char *begin = input.data();
+        const char *end = begin + input.size();
+
+        for (const auto &[name, function] : headerEnd)
+        {
+            Tests::check(function(begin, end) == SimdScanner::findHeaderEndScalar(begin, end), "findHeaderEnd " + name);
+        }
+
+        for (const auto &[name, function] : stringSpecial)
+        {
+            Tests::check(function(begin, end) == SimdScanner::findStringSpecialScalar(begin, end), "findStringSpecial " + name);
+        }
+    }
+
+    const char *begin = PROXIED_REQUEST.data();
+
+    for (const auto &[name, function] : headerEnd)
+    {
+        Tests::check(function(begin, begin + PROXIED_REQUEST.size()) == begin + PROXIED_REQUEST.find("\r\n\r\n"), "findHeaderEnd " + name + " (proxied request)");
+    }
+
+    JsonObject object;
+
+    Tests::check(JsonParser::parse(processorResponse, object) && object.size() == 4, "parse da resposta do processador");
+}
+
+/**
+ * @brief JsonSerializer: saída idêntica byte a byte à dos conversores da versão inicial do servidor.
+ */
+static void testJsonSerializers()
+{
+    Tests::section("JsonSerializer");
+
+    // Saída da versão inicial para um pagamento conhecido: amount com 6 casas (to_string de double)
+    {
+        Payment payment{};
+
+        UUIDGenerator::fromString("4a7901b8-7d26-4d9d-aa19-4dc1c7cf60b3", payment.correlationId);
+        payment.amountInCents = 1990;
+        payment.requestedAt = 1752582896789;
+
+        const string EXPECTED = R"({"correlationId": "4a7901b8-7d26-4d9d-aa19-4dc1c7cf60b3", "amount": 19.900000, "requestedAt" : "2025-07-15T12:34:56.789Z"})";
+        char buffer[JsonSerializer<Payment>::MAX_SIZE];
+
+        Tests::check(LegacyPaymentsJSONConverter::toJson(payment) == EXPECTED, "toJson da versão inicial: " + LegacyPaymentsJSONConverter::toJson(payment));
+        Tests::check(PaymentsJSONConverter::write(payment, buffer) == EXPECTED, "toJson(Payment): " + string(PaymentsJSONConverter::write(payment, buffer)));
+
+        PaymentsSummary summary{{43236, 415542345.98}, {423545, 329347.3}};
+
+        Tests::check(PaymentsJSONConverter::summaryToJson(summary) ==
+                         R"({"default":{"totalRequests":43236,"totalAmount":415542345.98},"fallback":{"totalRequests":423545,"totalAmount":329347.30}})",
+                     "summaryToJson: " + string(PaymentsJSONConverter::summaryToJson(summary)));
+    }
+
+    RequestArena arena;
+    mt19937_64 random(7);
+
+    for (int round = 0; round < 100000; round++)
+    {
+        Payment payment;
+
+        UUIDGenerator::createUUID(payment.correlationId);
+        payment.amountInCents = static_cast<int64_t>(random() % 100000000) - (round % 10 == 0 ? 50000000 : 0);
+        // O conversor anterior passa por system_clock (nanossegundos em 64 bits), que estoura depois de 2262
+        payment.requestedAt = static_cast<int64_t>(random() % 9000000000000ULL);
+        payment.flags = 0;
+
+        char buffer[JsonSerializer<Payment>::MAX_SIZE];
+        string_view json = PaymentsJSONConverter::write(payment, buffer);
+        string legacyJson = LegacyPaymentsJSONConverter::toJson(payment);
+
+        Tests::check(json == legacyJson, "toJson(Payment): " + string(json) + " != " + string(legacyJson));
+
+        PaymentsSummary summary{};
+
+        summary.defaultStats.totalRequests = static_cast<int>(random() % 10000000);
+        summary.defaultStats.totalAmount = static_cast<double>(random() % 100000000000) / 100.0;
+        summary.fallbackStats.totalRequests = static_cast<int>(random() % 10000000);
+        // Valores arbitrários (arredondamento da terceira casa, negativos, muito grandes)
+        summary.fallbackStats.totalAmount = (static_cast<double>(random()) / 1e4) * (round % 2 == 0 ? 1 : -1) * (round % 1000 == 0 ? 1e250 : 1);
+
+        Tests::check(PaymentsJSONConverter::summaryToJson(summary) == LegacyPaymentsJSONConverter::summaryToJson(summary), "summaryToJson");
+    }
+}
+
+/**
+ * @brief TimeUtils: formatação igual à anterior e ida e volta do ISO 8601 (inclusive URL-encoded e com fuso).
+ */
+static void testTimeUtils()
+{
+    Tests::section("TimeUtils");
+
+    mt19937_64 random(11);
+
+    for (int round = 0; round < 200000; round++)
+    {
+        // Até 2255 (o formatador anterior estoura depois de 2262)
+        int64_t epochMillis = static_cast<int64_t>(random() % 9000000000000ULL);
+        string formatted = TimeUtils::formatTimestampUTC(epochMillis);
+
+        Tests::check(formatted == LegacyPaymentsJSONConverter::formatTimestampUTC(epochMillis), "formatTimestampUTC " + formatted);
+
+        int64_t parsed, legacyParsed;
+
+        Tests::check(TimeUtils::parseTimestampUTC(formatted, parsed) && parsed == epochMillis, "parseTimestampUTC " + formatted);
+        Tests::check(LegacyTimeUtils::parseTimestampUTC(formatted, legacyParsed) && legacyParsed == parsed, "parseTimestampUTC (anterior) " + formatted);
+
+        string encoded = formatted;
+
+        for (size_t pos = encoded.find(':'); pos != string::npos; pos = encoded.find(':', pos))
+        {
+            encoded.replace(pos, 1, "%3A");
+        }
+
+        Tests::check(TimeUtils::parseTimestampUTC(encoded, parsed) && parsed == epochMillis, "parseTimestampUTC URL-encoded " + encoded);
+    }
+
+    int64_t parsed;
+
+    Tests::check(TimeUtils::parseTimestampUTC("2025-07-15T15:00:00.000-03:00", parsed) && parsed == 1752602400000, "fuso -03:00");
+    Tests::check(TimeUtils::parseTimestampUTC("2025-07-15T15%3A00%3A00.000%2B03%3A00", parsed) && parsed == 1752580800000, "fuso +03:00 URL-encoded");
+    Tests::check(!TimeUtils::parseTimestampUTC("2025-02-29T00:00:00Z", parsed), "29 de fevereiro em ano não bissexto");
+    Tests::check(!TimeUtils::parseTimestampUTC("2025-07-15T15%3G00:00Z", parsed), "sequência URL-encoded inválida");
+}
+
+/**
+ * @brief StringUtils::urlDecode: sequências válidas, '+' preservado e sequências inválidas.
+ */
+static void testStringUtils()
+{
+    Tests::section("StringUtils");
+
+    char decoded[64];
+
+    auto decode = [&](string_view input)
+    {
+        size_t length = StringUtils::urlDecode(input, decoded);
+
+        return length == string_view::npos ? string("<inválido>") : string(decoded, length);
+    };
+
+    Tests::check(decode("2025-07-15T12%3A34%3a56Z") == "2025-07-15T12:34:56Z", "urlDecode maiúsculas / minúsculas");
+    Tests::check(decode("+03:00") == "+03:00", "urlDecode preserva o '+'");
+    Tests::check(decode("") == "", "urlDecode vazio");
+    Tests::check(decode("%") == "<inválido>" && decode("%4") == "<inválido>" && decode("%zz") == "<inválido>", "urlDecode sequência inválida");
+}
+
+/**
+ * @brief HttpRequest / HttpResponse: campos da request, cabeçalhos iguais aos anteriores e nenhuma alocação na heap.
+ */
+static void testRequestPipeline()
+{
+    Tests::section("HttpRequest / HttpResponse");
+
+    const string PAYMENT_REQUEST =
+        "POST /payments HTTP/1.1\r\n"
+        "Host: localhost:9999\r\n"
+        "User-Agent: Grafana k6/1.1.0\r\n"
+        "Content-Type: application/json\r\n"
+        "Content-Length: 71\r\n"
+        "\r\n"
+        "{\"correlationId\":\"4a7901b8-7d26-4d9d-aa19-4dc1c7cf60b3\",\"amount\":\"19.9x\"}";
+
+    const string SUMMARY_REQUEST =
+        "GET /payments-summary?from=2025-07-15T12%3A34%3A56.000Z&to=2025-07-15T12%3A35%3A56.000Z HTTP/1.1\r\n"
+        "Host: localhost:9999\r\n"
+        "\r\n";
+
+    HttpRequest request;
+    string_view from;
+
+    Tests::check(HttpRequestParser::parse(PAYMENT_REQUEST, request) && request.method == "POST" && request.path == "/payments" &&
+                     request.query.empty() && request.body == PAYMENT_REQUEST.substr(PAYMENT_REQUEST.find('{')),
+                 "campos do HttpRequest (POST)");
+    Tests::check(HttpRequestParser::parse(SUMMARY_REQUEST, request) && request.method == "GET" && request.path == "/payments-summary" &&
+                     request.body.empty() && HttpRequestParser::getQueryParam(request.query, "from", from) && from == "2025-07-15T12%3A34%3A56.000Z",
+                 "campos do HttpRequest (GET)");
+
+    {
+        RequestArena arena;
+        char headersBuffer[HttpResponse::HEADERS_MAX_SIZE];
+
+        HttpResponse response(HttpStatus::BAD_REQUEST, "{ \"message\":\"Invalid params. Invalid JSON or 'amount'\" }");
+
+        Tests::check(response.writeHeaders(headersBuffer) == LegacyRequestPipeline::handle(PAYMENT_REQUEST.data(), PAYMENT_REQUEST.size()), "cabeçalhos da resposta");
+    }
+
+    {
+        RequestArena arena;
+        char headersBuffer[HttpResponse::HEADERS_MAX_SIZE];
+
+        HttpResponse response(HttpStatus::SERVICE_UNAVAILABLE, "{\"success\": false}");
+
+        Tests::check(response.writeHeaders(headersBuffer).substr(0, Constants::SERVICE_UNAVAILABLE_RESPONSE.size()) == Constants::SERVICE_UNAVAILABLE_RESPONSE, "linha de status 503");
+    }
+
+    // Os valores são guardados em variáveis (e não verificados dentro das lambdas) porque a mensagem (std::string) alocaria na heap
+    bool paymentParsed = false;
+    bool summaryParsed = false;
+
+    size_t paymentAllocations = Tests::countAllocations([&]()
+                                                        {
+                                                            RequestArena arena;
+                                                            HttpRequest paymentRequest;
+                                                            char headersBuffer[HttpResponse::HEADERS_MAX_SIZE];
+
+                                                            paymentParsed = HttpRequestParser::parse(PAYMENT_REQUEST, paymentRequest);
+
+                                                            JsonObject json;
+                                                            Payment payment;
+
+                                                            HttpResponse response = JsonParser::parse(paymentRequest.body, json) && json.getAmountInCents(Constants::KEY_AMOUNT, payment.amountInCents)
+                                                                                        ? HttpResponse(HttpStatus::CREATED)
+                                                                                        : HttpResponse(HttpStatus::BAD_REQUEST, "{ \"message\":\"Invalid params. Invalid JSON or 'amount'\" }");
+
+                                                            response.writeHeaders(headersBuffer); });
+
+    size_t summaryAllocations = Tests::countAllocations([&]()
+                                                        {
+                                                            RequestArena arena;
+                                                            HttpRequest summaryRequest;
+                                                            string_view fromValue, toValue;
+                                                            int64_t fromMillis = 0, toMillis = 0;
+                                                            char headersBuffer[HttpResponse::HEADERS_MAX_SIZE];
+                                                            char summaryBuffer[JsonSerializer<PaymentsSummary>::MAX_SIZE];
+
+                                                            summaryParsed = HttpRequestParser::parse(SUMMARY_REQUEST, summaryRequest) &&
+                                                                            HttpRequestParser::getQueryParam(summaryRequest.query, "from", fromValue) &&
+                                                                            HttpRequestParser::getQueryParam(summaryRequest.query, "to", toValue) &&
+                                                                            TimeUtils::parseTimestampUTC(fromValue, fromMillis) && TimeUtils::parseTimestampUTC(toValue, toMillis);
+
+                                                            PaymentsSummary summary{};
+                                                            summary.defaultStats.totalRequests = static_cast<int>((toMillis - fromMillis) / 1000);
+
+                                                            HttpResponse response(HttpStatus::OK, PaymentsJSONConverter::write(summary, summaryBuffer));
+
+                                                            response.writeHeaders(headersBuffer); });
+
+    Tests::check(paymentParsed && summaryParsed, "parse das requests medidas");
+    Tests::check(paymentAllocations == 0, "o POST /payments alocou na heap (" + to_string(paymentAllocations) + " alocações)");
+    Tests::check(summaryAllocations == 0, "o GET /payments-summary alocou na heap (" + to_string(summaryAllocations) + " alocações)");
+}
+
+/**
+ * @brief UUIDGenerator: ordem do UUIDv7, versão / variante e conversões iguais às da libuuid.
+ */
+static void testUUIDGenerator()
+{
+    Tests::section("UUIDGenerator");
+
+    // Ordem estrita dentro da thread, inclusive com o contador esgotado no mesmo milissegundo
+    uint8_t previous[16] = {};
+    set<string> generated;
+
+    for (int i = 0; i < 20000; i++)
+    {
+        uint8_t UUID[16];
+
+        UUIDGenerator::createUUID(UUID, 1752602400000 + i / 10000);
+
+        Tests::check(memcmp(previous, UUID, 16) < 0, "UUIDv7 fora de ordem");
+        Tests::check((UUID[6] >> 4) == 7 && (UUID[8] >> 6) == 2, "versão / variante do UUIDv7");
+
+        memcpy(previous, UUID, 16);
+
+        string text = UUIDGenerator::toString(UUID);
+        char libuuidText[37];
+        uint8_t parsed[16];
+        uuid_t libuuidParsed;
+
+        uuid_unparse_lower(UUID, libuuidText);
+
+        Tests::check(text == libuuidText, "toChars diferente da libuuid");
+        Tests::check(UUIDGenerator::fromString(text, parsed) && memcmp(parsed, UUID, 16) == 0, "fromString(toChars)");
+        Tests::check(uuid_parse(text.c_str(), libuuidParsed) == 0 && memcmp(libuuidParsed, parsed, 16) == 0, "fromString diferente da libuuid");
+
+        generated.insert(text);
+    }
+
+    uint8_t invalid[16];
+
+    Tests::check(generated.size() == 20000, "UUIDs repetidos");
+    Tests::check(!UUIDGenerator::fromString("4a7901b8-7d26-4d9d-aa19-4dc1c7cf60bz", invalid) && !UUIDGenerator::fromString("4a7901b87d264d9daa194dc1c7cf60b3", invalid), "fromString aceitou UUID inválido");
+}
+
+/**
+ * @brief MPSCRingBuffer: ordem FIFO, capacidade e nenhuma perda com vários produtores.
+ */
+static void testMPSCRingBuffer()
+{
+    Tests::section("MPSCRingBuffer");
+
+    MPSCRingBuffer<uint64_t> buffer(1000);
+    uint64_t value;
+
+    Tests::check(buffer.capacity() == 1024, "capacidade arredondada para potência de 2");
+
+    for (uint64_t i = 0; i < buffer.capacity(); i++)
+    {
+        buffer.tryPush(i);
+    }
+
+    Tests::check(!buffer.tryPush(0), "tryPush com o buffer cheio");
+
+    bool ordered = true;
+
+    for (uint64_t i = 0; i < buffer.capacity(); i++)
+    {
+        ordered &= buffer.tryPop(value) && value == i;
+    }
+
+    Tests::check(ordered && buffer.isEmpty() && !buffer.tryPop(value), "ordem FIFO com um produtor");
+
+    // 4 produtores x 100 mil valores: cada produtor é FIFO e nenhum valor se perde ou se repete
+    const uint64_t PRODUCERS = 4;
+    const uint64_t VALUES = 100000;
+
+    vector<thread> producers;
+
+    for (uint64_t producer = 0; producer < PRODUCERS; producer++)
+    {
+        producers.emplace_back([&buffer, producer, VALUES]()
+                               {
+                                   for (uint64_t i = 0; i < VALUES; i++)
+                                   {
+                                       while (!buffer.tryPush(producer << 32 | i))
+                                       {
+                                           this_thread::yield();
+                                       }
+                                   } });
+    }
+
+    vector<uint64_t> next(PRODUCERS, 0);
+    bool producerOrder = true;
+
+    for (uint64_t received = 0; received < PRODUCERS * VALUES;)
+    {
+        if (!buffer.tryPop(value))
+        {
+            this_thread::yield();
+            continue;
+        }
+
+        uint64_t producer = value >> 32;
+
+        producerOrder &= producer < PRODUCERS && (value & 0xFFFFFFFF) == next[producer];
+        next[producer]++;
+        received++;
+    }
+
+    for (thread &producer : producers)
+    {
+        producer.join();
+    }
+
+    Tests::check(producerOrder && buffer.isEmpty(), "ordem por produtor com 4 produtores");
+}
+
+/**
+ * @brief LatencyHistogram e Metrics: limites dos buckets, precisão dos percentis, status e nenhuma alocação no registro.
+ */
+static void testMetrics()
+{
+    Tests::section("Metrics");
+
+    mt19937_64 random(42);
+
+    for (int i = 0; i < 1000000; i++)
+    {
+        uint64_t value = random() >> (random() % 64);
+        size_t index = LatencyHistogram::bucketIndex(value);
+        uint64_t upperBound = LatencyHistogram::bucketUpperBound(index);
+
+        Tests::check(index < LatencyHistogram::BUCKETS && value <= upperBound && (index == 0 || LatencyHistogram::bucketUpperBound(index - 1) < value),
+                     "bucket do LatencyHistogram");
+        Tests::check(upperBound - value <= value / LatencyHistogram::SUB_BUCKETS, "precisão do LatencyHistogram");
+    }
+
+    // Latências log-normais (mediana ~2 ms) comparadas com os percentis exatos
+    static LatencyHistogram histogram;
+    vector<uint64_t> values;
+    lognormal_distribution<double> latency(log(2e6), 0.8);
+
+    for (int i = 0; i < 200000; i++)
+    {
+        values.push_back(static_cast<uint64_t>(latency(random)));
+        histogram.record(values.back());
+    }
+
+    sort(values.begin(), values.end());
+
+    for (double percentile : {0.5, 0.99, 0.999})
+    {
+        uint64_t exact = values[static_cast<size_t>(ceil(percentile * values.size())) - 1];
+        uint64_t estimated = histogram.getPercentile(percentile);
+
+        Tests::check(estimated >= exact && estimated - exact <= exact / LatencyHistogram::SUB_BUCKETS, "percentil " + to_string(percentile) + " do LatencyHistogram");
+    }
+
+    size_t allocations = Tests::countAllocations([&]()
+                                                 { Metrics::recordRequest(MetricsEndpoint::PAYMENTS, HttpStatus::CREATED, 1234567);
+                                                   Metrics::recordProcessorCall(true, ProcessorCall::PAYMENTS, 1234567, false);
+                                                   Metrics::recordRouting(RoutingDecision::DEFAULT); });
+
+    Tests::check(allocations == 0, "o registro de métricas alocou na heap");
+
+    // Status fora da lista não são contados como 500
+    Metrics::recordRequest(MetricsEndpoint::OTHER, HttpStatus::SERVICE_UNAVAILABLE, 1000);
+    Metrics::recordRequest(MetricsEndpoint::OTHER, static_cast<HttpStatus>(418), 1000);
+
+    pmr::string output;
+    Metrics::render(output);
+
+    Tests::check(output.find("garnize_http_responses_total{endpoint=\"other\",status=\"503\"} 1\n") != pmr::string::npos, "status 503 no /metrics");
+    Tests::check(output.find("garnize_http_responses_total{endpoint=\"other\",status=\"other\"} 1\n") != pmr::string::npos, "status desconhecido como \"other\"");
+    Tests::check(output.find("garnize_http_responses_total{endpoint=\"other\",status=\"500\"}") == pmr::string::npos, "status desconhecido contado como 500");
+}
+
+/**
+ * @brief Tracer: o TraceSpan não aloca e o trace exportado com outras threads gravando nunca tem eventos pela metade.
+ */
+static void testTracer()
+{
+    Tests::section("Tracer");
+
+    {
+        TraceSpan warmUp("tests.warmup");
+    }
+
+    size_t allocations = Tests::countAllocations([]()
+                                                 { TraceSpan span("tests.span"); });
+
+    Tests::check(allocations == 0, "o TraceSpan alocou na heap");
+
+    atomic<bool> running{true};
+    atomic<int> filledBuffers{0};
+    vector<thread> writers;
+
+    for (int i = 0; i < 4; i++)
+    {
+        writers.emplace_back([&running, &filledBuffers]()
+                             {
+                                 for (size_t spans = 0; running.load(memory_order_relaxed); spans++)
+                                 {
+                                     TraceSpan span("tests.concurrent");
+
+                                     if (spans == Constants::TRACE_EVENTS_PER_THREAD)
+                                     {
+                                         filledBuffers.fetch_add(1);
+                                     }
+                                 } });
+    }
+
+    // Com poucos núcleos as threads podem ainda nem ter rodado: espera cada uma encher o seu buffer antes de ler
+    while (filledBuffers.load() < 4)
+    {
+        this_thread::yield();
+    }
+
+    size_t events = 0;
+
+    for (int i = 0; i < 20; i++)
+    {
+        pmr::string trace;
+        Tracer::writeChromeTrace(trace);
+
+        // Eventos sendo escritos durante a leitura são descartados, nunca exportados pela metade
+        events = 0;
+
+        for (size_t pos = trace.find("{\"name\": \""); pos != pmr::string::npos; pos = trace.find("{\"name\": \"", pos + 1))
+        {
+            Tests::check(trace.compare(pos + 10, 6, "tests.") == 0, "evento corrompido no trace");
+            events++;
+        }
+
+        Tests::check(trace.compare(trace.size() - 3, 3, "\n]}") == 0, "trace incompleto");
+    }
+
+    running.store(false);
+
+    for (thread &writer : writers)
+    {
+        writer.join();
+    }
+
+    Tests::check(events > 4 * Constants::TRACE_EVENTS_PER_THREAD / 2, "spans das outras threads no trace");
+}
+
+/**
+ * @brief PaymentsUtils: o resumo (rollups + bordas lidas das partições) confere com os pagamentos gravados.
+ *
+ * Usa um banco temporário com uma única partição de uma hora. Os pagamentos são gravados com os rollups
+ * na mesma transação, como faz a thread de escrita.
+ */
+static void testDatabase()
+{
+    Tests::section("SQLite (PaymentsUtils)");
+
+    filesystem::path directory = filesystem::temp_directory_path() / ("garnize-tests-" + to_string(getpid()));
+    filesystem::create_directories(directory);
+    const string DATABASE_NAME = (directory / "payments.sqlite").string();
+
+    {
+        SQLiteConnectionPoolUtils writePool("tests-escrita", DATABASE_NAME, 1, 1, false);
+        sqlite3 *database = writePool.getConnectionFromPool();
+
+        Tests::check(database != nullptr, "conexão com o banco temporário");
+
+        if (database == nullptr)
+        {
+            return;
+        }
+
+        PaymentsUtils::init(database);
+
+        const PaymentsPartition PARTITION = PaymentsUtils::getPartition(TimeUtils::getEpochMillisUTC());
+
+        Tests::check(PaymentsUtils::createPartition(database, PARTITION), "criação da partição");
+
+        SQLiteConnectionPoolUtils readPool("tests-leitura", DATABASE_NAME, 1, 1, true);
+
+        // Um pagamento a cada 7 ms: as bordas das consultas caem no meio de um segundo
+        map<pair<int64_t, bool>, PaymentsRollup> rollups;
+        vector<pair<int64_t, bool>> processed;
+
+        sqlite3_exec(database, "BEGIN", nullptr, nullptr, nullptr);
+
+        for (int64_t i = 0; i < 20000; i++)
+        {
+            Payment payment{};
+
+            UUIDGenerator::createUUID(payment.correlationId);
+            payment.requestedAt = PARTITION.fromMillis + i * 7;
+            payment.amountInCents = 1990;
+
+            bool defaultService = i % 4 != 0;
+            bool isProcessed = i % 10 != 0;
+
+            PaymentsUtils::insert(database, payment, defaultService, isProcessed);
+
+            if (isProcessed)
+            {
+                PaymentsRollup &rollup = rollups[{payment.requestedAt / 1000, defaultService}];
+                rollup.records++;
+                rollup.amountInCents += payment.amountInCents;
+
+                processed.push_back({payment.requestedAt, defaultService});
+            }
+        }
+
+        Tests::check(PaymentsUtils::upsertRollups(database, rollups) && sqlite3_exec(database, "COMMIT", nullptr, nullptr, nullptr) == SQLITE_OK, "commit dos pagamentos");
+
+        writePool.returnConnectionToPool(database);
+
+        auto expected = [&](int64_t from, int64_t to, bool defaultService)
+        {
+            return count_if(processed.begin(), processed.end(), [&](const pair<int64_t, bool> &payment)
+                            { return payment.first >= from && payment.first <= to && payment.second == defaultService; });
+        };
+
+        const vector<pair<int64_t, int64_t>> RANGES = {
+            {PARTITION.fromMillis, PARTITION.toMillis - 1},
+            {PARTITION.fromMillis + 1, PARTITION.fromMillis + 60000 - 1},
+            {PARTITION.fromMillis + 1500, PARTITION.fromMillis + 1800},
+            {PARTITION.fromMillis + 12345, PARTITION.fromMillis + 98765},
+            {PARTITION.fromMillis + 5000, PARTITION.fromMillis + 4000},
+        };
+
+        for (const auto &[from, to] : RANGES)
+        {
+            PaymentsSummary summary{};
+
+            Tests::check(PaymentsUtils::getSummary(readPool, from, to, summary) &&
+                             summary.defaultStats.totalRequests == expected(from, to, true) &&
+                             summary.fallbackStats.totalRequests == expected(from, to, false) &&
+                             llround(summary.defaultStats.totalAmount * 100) == 1990 * expected(from, to, true),
+                         "resumo de " + to_string(from - PARTITION.fromMillis) + " a " + to_string(to - PARTITION.fromMillis) + " ms");
+        }
+    }
+
+    filesystem::remove_all(directory);
+}
+
+/**
+ * @brief PaymentsSpillQueue: recupera os segmentos de uma execução anterior e ignora arquivos com nomes inesperados.
+ */
+static void testSpillQueue()
+{
+    Tests::section("PaymentsSpillQueue");
+
+    const filesystem::path DIRECTORY = filesystem::temp_directory_path() / ("garnize-tests-spill-" + to_string(getpid()));
+
+    filesystem::create_directories(DIRECTORY);
+
+    // Segmento válido com 3 pagamentos (bytes crus do struct Payment), como gravado por append
+    {
+        ofstream segment(DIRECTORY / "segment-000000000002", ios::binary);
+
+        for (int64_t i = 0; i < 3; i++)
+        {
+            Payment payment{};
+            payment.amountInCents = 1990 + i;
+
+            segment.write(reinterpret_cast<const char *>(&payment), sizeof(Payment));
+        }
+    }
+
+    for (const char *stray : {"segment-foo", "segment-1.tmp", "segment-", "segment-99999999999999999999999"})
+    {
+        ofstream(DIRECTORY / stray) << "x";
+    }
+
+    PaymentsSpillQueue spill(DIRECTORY.string(), 100);
+
+    Tests::check(spill.getPendingRecords() == 3, "pagamentos recuperados do spill: " + to_string(spill.getPendingRecords()));
+
+    vector<int64_t> amounts;
+
+    size_t drained = spill.drainOldestSegment([&](const Payment &payment)
+                                              { amounts.push_back(payment.amountInCents); },
+                                              []()
+                                              { return true; });
+
+    Tests::check(drained == 3 && amounts == vector<int64_t>{1990, 1991, 1992} && spill.getPendingRecords() == 0, "segmento recuperado em ordem");
+
+    Payment payment{};
+
+    Tests::check(spill.append(payment) && filesystem::exists(DIRECTORY / "segment-000000000003"), "novo segmento depois do recuperado");
+    Tests::check(filesystem::exists(DIRECTORY / "segment-foo") && filesystem::exists(DIRECTORY / "segment-1.tmp"), "arquivos ignorados continuam no diretório");
+
+    filesystem::remove_all(DIRECTORY);
+}
+
+/**
+ * @brief PaymentsProcessor::payment: sem resposta do payment processor o pagamento é recusado com 503, e não aceito em silêncio.
+ *
+ * Roda em um diretório temporário (o spill do PaymentsDatabaseWriter é um caminho relativo). Com PROCESSOR_DEFAULT
+ * vazio a URL do processor é inválida e o curl falha sem acessar a rede. No fim, confere que o writer parado não
+ * bloqueia quem pede uma tarefa de manutenção.
+ */
+static void testPaymentsProcessor()
+{
+    Tests::section("PaymentsProcessor");
+
+    if (!Constants::PROCESSOR_DEFAULT.empty() || !Constants::PROCESSOR_FALLBACK.empty())
+    {
+        cout << "PROCESSOR_DEFAULT / PROCESSOR_FALLBACK definidos, teste ignorado" << endl;
+        return;
+    }
+
+    const filesystem::path PREVIOUS_DIRECTORY = filesystem::current_path();
+    const filesystem::path DIRECTORY = filesystem::temp_directory_path() / ("garnize-tests-processor-" + to_string(getpid()));
+
+    filesystem::create_directories(DIRECTORY / "database");
+    filesystem::current_path(DIRECTORY);
+
+    {
+        SQLiteConnectionPoolUtils writePool("tests-escrita", "database/payments.sqlite", 1, 1, false);
+        SQLiteConnectionPoolUtils readPool("tests-leitura", "database/payments.sqlite", 1, 1, true);
+        PaymentsDatabaseWriter writer(writePool, readPool);
+
+        RequestArena arena;
+
+        HttpResponse response = PaymentsProcessor::payment(R"({"correlationId": "4a7901b8-7d26-4d9d-aa19-4dc1c7cf60b3", "amount": 19.90})", writer);
+        WriterQueueStats stats = writer.getQueueStats();
+
+        Tests::check(response.status == HttpStatus::SERVICE_UNAVAILABLE, "falha do curl respondida com " + to_string(static_cast<int>(response.status)));
+        Tests::check(stats.queueDepth == 0 && stats.spillPendingRecords == 0 && writer.getBatchSizes().getCount() == 0, "pagamento com falha do curl enfileirado");
+
+        // Com a thread de escrita parada as tarefas de manutenção retornam erro em vez de bloquear
+        writer.stop();
+
+        Tests::check(!writer.purgePayments(), "purge com a thread de escrita parada");
+        Tests::check(writer.dropPartitionsBefore(0) == -1, "remoção de partições com a thread de escrita parada");
+    }
+
+    filesystem::current_path(PREVIOUS_DIRECTORY);
+    filesystem::remove_all(DIRECTORY);
+}
+
+static void printUsage(const char *program)
+{
+    cerr << "Uso: " << program << " [--filter <grupo>]" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+    string filter;
+
+    for (int i = 1; i < argc; i++)
+    {
+        string_view name = argv[i];
+
+        if (name == "--filter" && i + 1 < argc)
+        {
+            filter = argv[++i];
+        }
+        else
+        {
+            if (name != "--help")
+            {
+                cerr << "Opção inválida: " << name << endl;
+            }
+
+            printUsage(argv[0]);
+
+            return EXIT_FAILURE;
+        }
+    }
+
+    const vector<pair<string, void (*)()>> GROUPS = {
+        {"json", testJsonParser},
+        {"simd", testSimdScanner},
+        {"serializer", testJsonSerializers},
+        {"time", testTimeUtils},
+        {"string", testStringUtils},
+        {"uuid", testUUIDGenerator},
+        {"request", testRequestPipeline},
+        {"ring", testMPSCRingBuffer},
+        {"metrics", testMetrics},
+        {"tracer", testTracer},
+        {"sqlite", testDatabase},
+        {"spill", testSpillQueue},
+        {"processor", testPaymentsProcessor},
+    };
+
+    for (const auto &[name, function] : GROUPS)
+    {
+        if (filter.empty() || name.find(filter) != string::npos)
+        {
+            function();
+        }
+    }
+
+    cout << endl
+         << Tests::getChecks() << " verificações, " << Tests::getFailures() << " falhas" << endl;
+
+    return Tests::getFailures() == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}